@@ -0,0 +1,126 @@
+#ifndef BENCHMARKFIXTURES_H
+#define BENCHMARKFIXTURES_H
+
+#include <benchmark/benchmark.h>
+
+#include "ChessBoard.h"
+#include "ChessGameState.h"
+#include "Move.h"
+#include "Piece.h"
+#include "Bishop.h"
+#include "King.h"
+#include "Knight.h"
+#include "Knook.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
+
+using namespace logic;
+using namespace chess;
+
+namespace benchmarking {
+    // Builds the fixed positions used by every benchmark so results stay
+    // comparable across releases
+    // - Do not change these positions without also resetting any stored results
+    class BenchmarkPositions
+    {
+        public:
+            /*
+            * The standard starting position
+            */
+            static ChessGameState* startPosition()
+            {
+                return new ChessGameState();
+            }
+
+            /*
+            * An open middlegame with every type of piece (including a knook) on
+            * the board and white to move
+            */
+            static ChessGameState* middlegamePosition()
+            {
+                ChessBoard* board = new ChessBoard(false);
+                board->addPieces({
+                    new King  (Player::white, std::make_pair(7, 1)),
+                    new Queen (Player::white, std::make_pair(4, 3)),
+                    new Rook  (Player::white, std::make_pair(1, 1)),
+                    new Rook  (Player::white, std::make_pair(6, 1)),
+                    new Bishop(Player::white, std::make_pair(3, 4)),
+                    new Knight(Player::white, std::make_pair(6, 3)),
+                    new Knook (Player::white, std::make_pair(3, 3)),
+                    new Pawn  (Player::white, std::make_pair(1, 2)),
+                    new Pawn  (Player::white, std::make_pair(2, 2)),
+                    new Pawn  (Player::white, std::make_pair(5, 4)),
+                    new Pawn  (Player::white, std::make_pair(6, 2)),
+                    new Pawn  (Player::white, std::make_pair(7, 2)),
+                    new Pawn  (Player::white, std::make_pair(8, 2)),
+                    new King  (Player::black, std::make_pair(7, 8)),
+                    new Queen (Player::black, std::make_pair(4, 6)),
+                    new Rook  (Player::black, std::make_pair(1, 8)),
+                    new Rook  (Player::black, std::make_pair(6, 8)),
+                    new Bishop(Player::black, std::make_pair(3, 5)),
+                    new Knight(Player::black, std::make_pair(6, 6)),
+                    new Knook (Player::black, std::make_pair(3, 6)),
+                    new Pawn  (Player::black, std::make_pair(1, 7)),
+                    new Pawn  (Player::black, std::make_pair(2, 7)),
+                    new Pawn  (Player::black, std::make_pair(5, 5)),
+                    new Pawn  (Player::black, std::make_pair(6, 7)),
+                    new Pawn  (Player::black, std::make_pair(7, 7)),
+                    new Pawn  (Player::black, std::make_pair(8, 7))
+                });
+                return new ChessGameState(board);
+            }
+
+            /*
+            * A position where white is in checkmate (fool's mate)
+            */
+            static ChessGameState* checkmatePosition()
+            {
+                ChessGameState* chessState = new ChessGameState();
+                chessState->movePiece(std::make_pair(6, 2), std::make_pair(6, 3));
+                chessState->movePiece(std::make_pair(5, 7), std::make_pair(5, 5));
+                chessState->movePiece(std::make_pair(7, 2), std::make_pair(7, 4));
+                chessState->movePiece(std::make_pair(4, 8), std::make_pair(8, 4));
+                return chessState;
+            }
+
+            /*
+            * Clears every piece's move cache so the next query has to generate 
+            * moves again
+            * - Call between PauseTiming() and ResumeTiming()
+            */
+            static void invalidateCaches(ChessGameState* chessState)
+            {
+                GameBoard* board = chessState->getBoard();
+                for(Player player : {Player::white, Player::black}) {
+                    for(Move::position position : board->getPiecesOfPlayer(player)) {
+                        board->getPiece(position)->clearMoveCache();
+                    }
+                }
+            }
+    };
+
+    // A benchmark fixture that owns a fresh copy of one of the fixed positions
+    template <ChessGameState* (*makePosition)()>
+    class PositionFixture : public benchmark::Fixture
+    {
+        public:
+            ChessGameState* chessState{nullptr};
+
+            void SetUp(const benchmark::State& state) override
+            {
+                chessState = makePosition();
+            }
+
+            void TearDown(const benchmark::State& state) override
+            {
+                delete chessState;
+                chessState = nullptr;
+            }
+    };
+
+    using StartPositionFixture = PositionFixture<BenchmarkPositions::startPosition>;
+    using MiddlegamePositionFixture = PositionFixture<BenchmarkPositions::middlegamePosition>;
+    using CheckmatePositionFixture = PositionFixture<BenchmarkPositions::checkmatePosition>;
+}
+#endif
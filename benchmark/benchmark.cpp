@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+// Run with --benchmark_format=json (or --benchmark_out=<file> --benchmark_out_format=json)
+// to get machine readable results for tracking regressions
+BENCHMARK_MAIN();
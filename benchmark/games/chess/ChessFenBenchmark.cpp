@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "BenchmarkFixtures.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+
+using namespace logic;
+using namespace chess;
+using namespace benchmarking;
+
+static void ChessFen_Load(benchmark::State& state)
+{
+    // Load a middlegame position, including constructing its game state
+    std::string_view fen = "r1bqkb1r/pppp1ppp/2n*2n*2/4p3/2B*1P3/5N*2/PPPP1PPP/RNBQ1R*K*1 b kq - 5 4";
+    for(auto _ : state) {
+        ChessGameState* chessState = ChessFen::load(fen);
+        benchmark::DoNotOptimize(chessState);
+        delete chessState;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(ChessFen_Load);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, ChessFen_Write)(benchmark::State& state)
+{
+    // Write the position into the same string every time
+    std::string fen{};
+    for(auto _ : state) {
+        ChessFen::write(*chessState, fen);
+        benchmark::DoNotOptimize(fen.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, ChessFen_Write);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkFixtures.h"
+#include "ChessBoard.h"
+#include "ChessGameState.h"
+
+using namespace logic;
+using namespace chess;
+using namespace benchmarking;
+
+static void ChessGameState_Construct(benchmark::State& state)
+{
+    // Build the standard starting position, including calculating the first
+    // player's priority
+    for(auto _ : state) {
+        ChessGameState* chessState = new ChessGameState();
+        benchmark::DoNotOptimize(chessState);
+        delete chessState;
+    }
+}
+BENCHMARK(ChessGameState_Construct);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, ChessGameState_IsInCheck)(benchmark::State& state)
+{
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(chessState->isInCheck());
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, ChessGameState_IsInCheck);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, ChessGameState_IsInCheckmate)(benchmark::State& state)
+{
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(chessState->isInCheckmate());
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, ChessGameState_IsInCheckmate);
+
+BENCHMARK_DEFINE_F(CheckmatePositionFixture, ChessGameState_IsInCheckmateMated)(benchmark::State& state)
+{
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(chessState->isInCheckmate());
+    }
+}
+BENCHMARK_REGISTER_F(CheckmatePositionFixture, ChessGameState_IsInCheckmateMated);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+#include <memory>
+
+#include "GameRecord.h"
+#include "ChessGameState.h"
+
+using namespace logic;
+using namespace chess;
+
+/*
+* Returns a file of games that shuffle the knights out and back
+*/
+static std::string createGames(int games, int plies)
+{
+    std::ostringstream output{};
+    GameRecordWriter writer{output};
+    for(int i = 0; i < games; i++) {
+        GameRecord record{};
+        for(int ply = 0; ply < plies; ply++) {
+            switch(ply % 4) {
+                case 0: record.addMove(std::make_pair(7, 1), std::make_pair(6, 3), 0); break;
+                case 1: record.addMove(std::make_pair(7, 8), std::make_pair(6, 6), 0); break;
+                case 2: record.addMove(std::make_pair(6, 3), std::make_pair(7, 1), 0); break;
+                case 3: record.addMove(std::make_pair(6, 6), std::make_pair(7, 8), 0); break;
+            }
+        }
+        writer.write(record);
+    }
+    return output.str();
+}
+
+static void GameRecord_Decode(benchmark::State& state)
+{
+    // Read every game and decode every move without replaying them
+    std::string bytes = createGames(1000, 80);
+    for(auto _ : state) {
+        GameRecordReader reader{};
+        reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+        GameRecordReader::Game game{};
+        while(reader.next(game)) {
+            for(std::uint32_t ply = 0; ply < game.plyCount; ply++) {
+                Move::position start{};
+                Move::position end{};
+                int idx = 0;
+                game.getMove(ply, start, end, idx);
+                benchmark::DoNotOptimize(idx);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000 * 80);
+}
+BENCHMARK(GameRecord_Decode)->Unit(benchmark::kMillisecond);
+
+static void GameRecord_Replay(benchmark::State& state)
+{
+    // Replay a game through ChessGameState
+    std::string bytes = createGames(1, 8);
+    GameRecordReader reader{};
+    reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+    GameRecordReader::Game game{};
+    reader.next(game);
+    for(auto _ : state) {
+        std::unique_ptr<ChessGameState> chessState{GameRecordReader::replay(game)};
+        benchmark::DoNotOptimize(chessState.get());
+    }
+    state.SetItemsProcessed(state.iterations() * 8);
+}
+BENCHMARK(GameRecord_Replay)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkFixtures.h"
+#include "MonteCarloSearch.h"
+
+using namespace logic;
+using namespace chess;
+using namespace benchmarking;
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, MonteCarloSearch_Rollouts)(benchmark::State& state)
+{
+    // Run short rollouts from the middlegame on the inputted number of
+    // threads, starting a new tree each time
+    MonteCarloSearch::Options options{};
+    options.threadCount = static_cast<std::size_t>(state.range(0));
+    options.maxRolloutPly = 10;
+    std::uint64_t rollouts = 0;
+    for(auto _ : state) {
+        MonteCarloSearch search{*chessState, options};
+        benchmark::DoNotOptimize(search.search(16));
+        rollouts += search.getStats().rollouts;
+    }
+    state.counters["rollouts"] = benchmark::Counter(static_cast<double>(rollouts), benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, MonteCarloSearch_Rollouts)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "OpeningBook.h"
+
+using namespace logic;
+using namespace chess;
+
+static void OpeningBook_Find(benchmark::State& state)
+{
+    // Look up random positions in a book with a million entries
+    std::mt19937_64 random{45};
+    std::vector<std::uint64_t> keys{};
+    OpeningBookBuilder builder{};
+    for(int i = 0; i < 1000000; i++) {
+        keys.push_back(random());
+        builder.add(keys.back(), 1, 1);
+    }
+    std::ostringstream output{};
+    builder.write(output);
+    std::string bytes = output.str();
+    OpeningBook book{};
+    book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+
+    OpeningBook::Entry found[OpeningBook::maxPositionMoves];
+    std::size_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(book.findMoves(keys[i], found, OpeningBook::maxPositionMoves));
+        i = (i + 7919) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(OpeningBook_Find);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkFixtures.h"
+#include "ChessGameState.h"
+#include "Move.h"
+#include "Piece.h"
+
+using namespace logic;
+using namespace chess;
+using namespace benchmarking;
+
+// Generates the moves of the white piece on the inputted position of the
+// middlegame position with a stale move cache
+static void Piece_GenerateMoves(benchmark::State& state, Move::position position)
+{
+    ChessGameState* chessState = BenchmarkPositions::middlegamePosition();
+    Piece* piece = chessState->getBoard()->getPiece(position);
+    if(piece == nullptr) {
+        state.SkipWithError("No piece on the benchmarked position");
+        delete chessState;
+        return;
+    }
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(piece->getMoves(*chessState, true).size());
+    }
+    delete chessState;
+}
+BENCHMARK_CAPTURE(Piece_GenerateMoves, King,   std::make_pair(7, 1));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Queen,  std::make_pair(4, 3));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Rook,   std::make_pair(6, 1));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Bishop, std::make_pair(3, 4));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Knight, std::make_pair(6, 3));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Knook,  std::make_pair(3, 3));
+BENCHMARK_CAPTURE(Piece_GenerateMoves, Pawn,   std::make_pair(1, 2));
+
+// Generates the attacking moves of the white piece on the inputted position of
+// the middlegame position with a stale move cache
+static void Piece_GenerateAttackingMoves(benchmark::State& state, Move::position position)
+{
+    ChessGameState* chessState = BenchmarkPositions::middlegamePosition();
+    Piece* piece = chessState->getBoard()->getPiece(position);
+    if(piece == nullptr) {
+        state.SkipWithError("No piece on the benchmarked position");
+        delete chessState;
+        return;
+    }
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(piece->getAttackingMoves(*chessState).size());
+    }
+    delete chessState;
+}
+BENCHMARK_CAPTURE(Piece_GenerateAttackingMoves, Queen,  std::make_pair(4, 3));
+BENCHMARK_CAPTURE(Piece_GenerateAttackingMoves, Knook,  std::make_pair(3, 3));
+BENCHMARK_CAPTURE(Piece_GenerateAttackingMoves, Pawn,   std::make_pair(1, 2));
+
+// Generates the pseudo-legal moves of the white piece on the inputted position
+// of the middlegame position with a stale move cache
+static void Piece_GeneratePseudoLegalMoves(benchmark::State& state, Move::position position)
+{
+    ChessGameState* chessState = BenchmarkPositions::middlegamePosition();
+    Piece* piece = chessState->getBoard()->getPiece(position);
+    if(piece == nullptr) {
+        state.SkipWithError("No piece on the benchmarked position");
+        delete chessState;
+        return;
+    }
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(piece->getPseudoLegalMoves(*chessState).size());
+    }
+    delete chessState;
+}
+BENCHMARK_CAPTURE(Piece_GeneratePseudoLegalMoves, Queen,  std::make_pair(4, 3));
+BENCHMARK_CAPTURE(Piece_GeneratePseudoLegalMoves, Knook,  std::make_pair(3, 3));
+BENCHMARK_CAPTURE(Piece_GeneratePseudoLegalMoves, Pawn,   std::make_pair(1, 2));
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkFixtures.h"
+#include "GameBoard.h"
+#include "Move.h"
+#include "Piece.h"
+
+using namespace logic;
+using namespace benchmarking;
+
+BENCHMARK_DEFINE_F(StartPositionFixture, GameBoard_GetPiece)(benchmark::State& state)
+{
+    // Look up every position on the board, half of which are empty
+    GameBoard* board = chessState->getBoard();
+    for(auto _ : state) {
+        for(int x = 1; x <= 8; x++) {
+            for(int y = 1; y <= 8; y++) {
+                benchmark::DoNotOptimize(board->getPiece(x, y));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK_REGISTER_F(StartPositionFixture, GameBoard_GetPiece);
+
+BENCHMARK_DEFINE_F(StartPositionFixture, GameBoard_MovePiece)(benchmark::State& state)
+{
+    // Move the white kingside knight out and back
+    GameBoard* board = chessState->getBoard();
+    Move::position start = std::make_pair(7, 1);
+    Move::position end = std::make_pair(6, 3);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(board->movePiece(start, end));
+        benchmark::DoNotOptimize(board->movePiece(end, start));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK_REGISTER_F(StartPositionFixture, GameBoard_MovePiece);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkFixtures.h"
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+#include "StagedMoveGenerator.h"
+
+using namespace logic;
+using namespace benchmarking;
+
+using Player = Piece::Player;
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, GameState_IsAttacked)(benchmark::State& state)
+{
+    // Check a square attacked by several pieces with stale move caches
+    Move::position target = std::make_pair(5, 5);
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(chessState->isAttacked(Player::black, target));
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, GameState_IsAttacked);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, GameState_IsAttackedCached)(benchmark::State& state)
+{
+    // Check the same square while every move cache is up to date
+    Move::position target = std::make_pair(5, 5);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(chessState->isAttacked(Player::black, target));
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, GameState_IsAttackedCached);
+
+BENCHMARK_DEFINE_F(StartPositionFixture, GameState_MovePiece)(benchmark::State& state)
+{
+    // Shuffle both kingside knights out and back, which returns to the starting
+    // position every 4 moves
+    Move::position whiteStart = std::make_pair(7, 1);
+    Move::position whiteEnd = std::make_pair(6, 3);
+    Move::position blackStart = std::make_pair(7, 8);
+    Move::position blackEnd = std::make_pair(6, 6);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(chessState->movePiece(whiteStart, whiteEnd));
+        benchmark::DoNotOptimize(chessState->movePiece(blackStart, blackEnd));
+        benchmark::DoNotOptimize(chessState->movePiece(whiteEnd, whiteStart));
+        benchmark::DoNotOptimize(chessState->movePiece(blackEnd, blackStart));
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK_REGISTER_F(StartPositionFixture, GameState_MovePiece);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, GameState_GenerateAllLegalMoves)(benchmark::State& state)
+{
+    // Find every legal move for white with stale move caches
+    std::vector<GameState::LegalMove> legalMoves{};
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        chessState->invalidatePriorities();
+        state.ResumeTiming();
+        chessState->generateAllLegalMoves(legalMoves);
+        benchmark::DoNotOptimize(legalMoves.data());
+    }
+    state.counters["moves"] = static_cast<double>(legalMoves.size());
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, GameState_GenerateAllLegalMoves);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, StagedMoveGenerator_FirstMove)(benchmark::State& state)
+{
+    // Find only the first move a search would try, as after a cutoff
+    for(auto _ : state) {
+        state.PauseTiming();
+        BenchmarkPositions::invalidateCaches(chessState);
+        chessState->invalidatePriorities();
+        state.ResumeTiming();
+        StagedMoveGenerator generator{*chessState};
+        StagedMoveGenerator::StagedMove stagedMove{};
+        benchmark::DoNotOptimize(generator.next(stagedMove));
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, StagedMoveGenerator_FirstMove);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, GameState_CanMovePieceEverySquare)(benchmark::State& state)
+{
+    // Ask whether the white queen can reach every square with cached moves
+    Move::position queen = std::make_pair(4, 3);
+    for(auto _ : state) {
+        int reachable = 0;
+        for(int i = 1; i <= 8; i++) {
+            for(int j = 1; j <= 8; j++) {
+                reachable += chessState->canMovePiece(queen, std::make_pair(i, j));
+            }
+        }
+        benchmark::DoNotOptimize(reachable);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, GameState_CanMovePieceEverySquare);
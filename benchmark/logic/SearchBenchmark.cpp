@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <limits>
+
+#include "BenchmarkFixtures.h"
+#include "GameState.h"
+#include "Search.h"
+
+using namespace logic;
+using namespace benchmarking;
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, Search_Quiescence)(benchmark::State& state)
+{
+    // Run a full-window quiescence search from the middlegame, which has
+    // captures available for both players
+    Search search{*chessState};
+    double infinity = std::numeric_limits<double>::infinity();
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(search.quiescence(-infinity, infinity));
+    }
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(search.getQuiescenceNodeCount()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, Search_Quiescence)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, Search_Depth1)(benchmark::State& state)
+{
+    // Search every white move followed by a quiescence search
+    Search search{*chessState};
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(search.findBestMove(1));
+    }
+    double nodes = static_cast<double>(search.getNodeCount() + search.getQuiescenceNodeCount());
+    state.counters["nodes"] = benchmark::Counter(nodes, benchmark::Counter::kIsRate);
+    state.counters["quiescence"] = benchmark::Counter(static_cast<double>(search.getQuiescenceNodeCount()) / nodes);
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, Search_Depth1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, Search_BoardEvaluation)(benchmark::State& state)
+{
+    // Read the incrementally updated score of the board's evaluator
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Search::boardEvaluation(*chessState));
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, Search_BoardEvaluation);
+
+BENCHMARK_DEFINE_F(MiddlegamePositionFixture, Search_MaterialEvaluation)(benchmark::State& state)
+{
+    // Add up the value of every piece on the board
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Search::materialEvaluation(*chessState));
+    }
+}
+BENCHMARK_REGISTER_F(MiddlegamePositionFixture, Search_MaterialEvaluation);
+
+BENCHMARK_DEFINE_F(StartPositionFixture, Search_Perft)(benchmark::State& state)
+{
+    // Count every sequence of 2 moves from the starting position
+    Search search{*chessState};
+    std::uint64_t nodes = 0;
+    for(auto _ : state) {
+        nodes += search.perft(2);
+    }
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(StartPositionFixture, Search_Perft)->Unit(benchmark::kMillisecond);
@@ -51,6 +51,11 @@ namespace chess {
             * Returns the maximum y value on the board
             */
             int maxY();
+
+            /*
+            * Returns the longest distance a ray can travel across the board
+            */
+            int getRayHorizon() override;
             
     };
 
@@ -0,0 +1,26 @@
+#ifndef CHESSEVALUATOR_H
+#define CHESSEVALUATOR_H
+
+#include "Evaluator.h"
+#include "Piece.h"
+#include "Move.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    /*
+     * Scores chess pieces by their value and by where they stand on the board
+     * - Pawns are worth more the closer they are to promoting
+     * - Knights, bishops, knooks, and queens are worth more near the center
+    */
+    class ChessEvaluator : public Evaluator
+    {
+        public:
+            /*
+            * Returns the bonus for the piece standing on the inputted position
+            */
+            double getPieceSquareValue(Piece* piece, Move::position position) override;
+    };
+}
+#endif
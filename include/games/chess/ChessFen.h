@@ -0,0 +1,72 @@
+#ifndef CHESSFEN_H
+#define CHESSFEN_H
+
+#include <string>
+#include <string_view>
+
+#include "ChessGameState.h"
+#include "Piece.h"
+#include "Move.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    /*
+     * Reads and writes chess positions in FEN with extensions for Anarchy Chess
+     * - Fields: placement, player to move, castling, En Passant, halfmove
+     *   clock, and move number. The last two may be left out
+     * - Pieces are KQRBNP as usual, plus O for the knook. Uppercase pieces
+     *   belong to white and lowercase pieces belong to black
+     * - A piece followed by its controllers in brackets belongs to exactly
+     *   those players (w, b, s, g), ex: N[wb] is a knight both players can move
+     * - A piece followed by * has moved. Pawns off their starting row, and
+     *   kings and rooks on their starting squares without castling rights,
+     *   have always moved, so they never need a *
+     * - The En Passant square is behind the pawn that boosted last turn
+     *
+     * Positions are parsed straight from the string without allocating
+     * anything but the pieces, so datasets can be loaded quickly
+    */
+    class ChessFen
+    {
+        public:
+            /*
+            * The standard starting position
+            */
+            static constexpr std::string_view startPosition =
+                "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+            /*
+            * Returns a new game state in the inputted position, or nullptr if
+            * the inputted string is not a valid position
+            * - Each player must have a king
+            * - The caller owns the returned game state
+            */
+            static ChessGameState* load(std::string_view fen);
+
+            /*
+            * Returns a new game state in the position of the inputted one,
+            * along with the positions that led to it so repetitions are still
+            * found, or nullptr if a move is being simulated
+            * - The caller owns the returned game state
+            */
+            static ChessGameState* copy(ChessGameState& chessState);
+
+            /*
+            * Replaces the contents of the inputted string with the position of
+            * the inputted game state
+            * - Reuses the string's memory, so writing many positions into the
+            *   same string does not allocate
+            * - Pieces that have not moved but that load() would think have moved
+            *   (see above) are written as moved, which never changes their moves
+            */
+            static void write(ChessGameState& chessState, std::string& fen);
+
+            /*
+            * Returns the position of the inputted game state (see write())
+            */
+            static std::string toString(ChessGameState& chessState);
+    };
+}
+#endif
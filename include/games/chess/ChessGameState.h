@@ -12,9 +12,35 @@ namespace chess {
 
     class ChessGameState : public GameState
     {
+        public:
+            /*
+             * How a game ended, or ongoing if the current player can still move
+            */
+            enum class Result
+            {
+                ongoing,
+                checkmate,
+                stalemate,
+                repetition,
+                fiftyMoves
+            };
+
         private:
             std::unordered_map<Player, Piece*> kings{};
 
+            /*
+            * The pawn that boosted most recently, or nullptr
+            * - Only allows En Passant while its boost turn is the previous turn
+            *   (see PawnBoostAction)
+            */
+            Piece* boostedPawn{nullptr};
+
+        protected:
+            /*
+             * Pawn moves reset the halfmove clock
+            */
+            bool resetsHalfmoveClock(Piece* piece) override;
+
         public:
             /*
              * Initializes the GameState class' gameBoard* pointer to a new ChessBoard,
@@ -50,6 +76,43 @@ namespace chess {
             */
             bool isInCheckmate(Player player);
             bool isInCheckmate();
+
+            /*
+             * Returns the result of the game in the current position
+             * - Draws by repetition and by the fifty-move rule are checked
+             *   before the current player's moves, so they end the game first
+             * - Works the same while moves are simulated
+            */
+            Result getResult();
+
+            /*
+            * Returns whether the current player can move the piece at start to 
+            * end with the inputted move without putting themself in check
+            * - Simulates the move's actions and reverts them before returning,
+            *   even when called while another move is simulated
+            * - Use this to check the moves from Piece::getPseudoLegalMoves()
+            */
+            bool isLegal(Move::position start, Move::position end, Move& move) override;
+
+            /*
+            * Returns a hash of the castling rights and of the pawn that can be 
+            * captured En Passant
+            * - A king can castle with a rook while neither has moved
+            */
+            std::uint64_t getStateKey() override;
+
+            /*
+            * Returns whether the current player is in check, so having no moves
+            * is checkmate rather than stalemate
+            */
+            bool losesWithoutMoves() override;
+
+            /*
+            * Returns the pawn that boosted most recently or sets it, which is
+            * kept up to date by PawnBoostAction
+            */
+            Piece* getBoostedPawn();
+            void setBoostedPawn(Piece* pawn);
     };
 
 }
@@ -36,9 +36,17 @@ namespace chess {
             */
             bool isKing();
 
+            /*
+            * Chess moves only depend on the turn through En Passant, which
+            * records the dependency itself (see Pawn::justBoosted())
+            */
+            bool movesDependOnTurn() override { return false; }
+
             /*
              * Checks if moving to the position will put the current player into 
              * check and, if it does not, adds the position to the move
+             * - While pseudo-legal moves are generated, the position is always 
+             *   added without checking (see Piece::getPseudoLegalMoves())
              * - Note: If the target position is occupied, this funciton will 
              *         simulate capturing it before checking for check if the 
              *         piece does not belong to the current player and will
@@ -112,6 +120,8 @@ namespace chess {
             *   different moves
             * - If a position is not valid, it, along with all future positions
             *   will be skipped
+            * - Positions that would put the player in check are skipped, but the
+            *   positions after them are still added since they may block the check
             * 
             * If no vector of moves is inputted, returns:
             * - A vector of moves containing the new move that goes to the target positions
@@ -171,6 +181,15 @@ namespace chess {
                 addRelatedPositionsDeltas(deltas, moves, chessState, priority, {make_action(new TryCapturePieceAction(getPlayer()))}, {});
             }
             
+            /*
+            * Adds a move containing the positions along a ray in the given direction
+            * as with addRelatedPositions()
+            * - The ray stops at the first blocker or at the board's ray horizon 
+            *   (see GameBoard::castRay()), so sliding pieces stay finite on 
+            *   infinite boards
+            */
+            void addRay(Move::position direction, std::vector<Move>& moves, ChessGameState& chessState, int priority = 1);
+
             /*
             * Returns which player between black and white controls this piece
             */
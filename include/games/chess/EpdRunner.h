@@ -0,0 +1,101 @@
+#ifndef EPDRUNNER_H
+#define EPDRUNNER_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace chess {
+    /*
+     * Runs a task on every position of an EPD file and writes one result per
+     * position, in the same order as the input
+     * - Each line holds the first 4 FEN fields (see ChessFen), followed by
+     *   operations separated by semicolons, ex:
+     *   rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - D1 20; id "start";
+     * - Supported operations: hmvc and fmvn set the halfmove clock and move
+     *   number, D<depth> is the expected perft count at a depth, and id names
+     *   the position. Other operations are ignored
+     * - Empty lines and lines starting with # are skipped
+     *
+     * Positions are read one line at a time and handed to a thread pool, and
+     * only a fixed number of positions are in flight at once, so files of any
+     * size can be run with bounded memory
+    */
+    class EpdRunner
+    {
+        public:
+            /*
+            * The task to run on every position
+            */
+            enum class Task
+            {
+                perft,  // Count move sequences to the depth, checked against D<depth> if present
+                count,  // Count the legal moves of the player to move
+                search  // Search to the depth and report the best move
+            };
+
+            struct Options
+            {
+                Task task{Task::count};
+                int depth{1};
+
+                /*
+                * The number of worker threads, or 0 for one per hardware thread
+                */
+                std::size_t threadCount{0};
+
+                /*
+                * The most positions in flight at once, or 0 for 4 per thread
+                */
+                std::size_t maxPending{0};
+            };
+
+            /*
+            * The result of running a task on a single line
+            * - failed is true if the line is not a valid position or if a perft
+            *   count does not match the expected count
+            */
+            struct LineResult
+            {
+                std::string text{};
+                bool failed{false};
+            };
+
+            /*
+            * The number of positions that were run and that failed
+            */
+            struct Summary
+            {
+                std::size_t positions{0};
+                std::size_t failed{0};
+            };
+
+        private:
+            Options options;
+
+        public:
+            /*
+            * Constructor: Runs the task in the inputted options
+            */
+            EpdRunner(Options options);
+
+            /*
+            * Runs the task on every line of input and writes
+            * "<line number>: <result>" to output for each position
+            */
+            Summary run(std::istream& input, std::ostream& output);
+
+            /*
+            * Runs the inputted task on a single EPD line
+            */
+            static LineResult runLine(std::string_view line, const Options& options);
+
+            /*
+            * Returns whether the inputted line is skipped by run()
+            */
+            static bool isSkipped(std::string_view line);
+    };
+}
+#endif
@@ -0,0 +1,164 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "MappedFile.h"
+#include "Move.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * A played chess game stored as its starting position and one 16-bit
+     * move per ply
+     * - Each move holds its start square (6 bits), end square (6 bits), and
+     *   the index passed to GameState::movePiece() (4 bits)
+     *
+     * Records are stored in a binary file (see GameRecordWriter):
+     * - File header: "ACGR", then the format version (uint16) and 2 unused
+     *   bytes
+     * - Each game: the ply count (uint32), the result (uint8), 1 unused byte,
+     *   the length of the starting FEN (uint16), the FEN padded to an even
+     *   length, then each move (uint16)
+     * - Numbers are little-endian, and an empty FEN is the starting position
+    */
+    class GameRecord
+    {
+        public:
+            /*
+            * The position the game started from in FEN (see ChessFen), or empty
+            * for the standard starting position
+            */
+            std::string startFen{};
+
+            /*
+            * The encoded moves of the game, one per ply
+            */
+            std::vector<std::uint16_t> moves{};
+
+            ChessGameState::Result result{ChessGameState::Result::ongoing};
+
+            /*
+            * The most moves of one piece to the same square that can be stored
+            */
+            static constexpr int maxMoveIdx = 15;
+
+            /*
+            * Encodes a move into encoded and returns whether the move can be
+            * stored (both positions are on an 8x8 board and idx <= maxMoveIdx)
+            */
+            static bool encodeMove(Move::position start, Move::position end, int idx, std::uint16_t& encoded);
+
+            /*
+            * Decodes a move created by encodeMove()
+            */
+            static void decodeMove(std::uint16_t encoded, Move::position& start, Move::position& end, int& idx);
+
+            /*
+            * Encodes a move and adds it to the end of the game, returning false
+            * if it cannot be stored
+            */
+            bool addMove(Move::position start, Move::position end, int idx);
+    };
+
+    /*
+     * Writes game records to a binary stream (see GameRecord)
+    */
+    class GameRecordWriter
+    {
+        private:
+            std::ostream& output;
+
+        public:
+            /*
+            * Constructor: Writes the file header to the inputted stream, which
+            * should be opened in binary mode
+            */
+            GameRecordWriter(std::ostream& output);
+
+            /*
+            * Writes a game and returns whether the stream is still good
+            * - Returns false without writing if the starting FEN is too long
+            */
+            bool write(const GameRecord& record);
+    };
+
+    /*
+     * Reads game records from memory, usually a memory-mapped file, without
+     * copying them
+    */
+    class GameRecordReader
+    {
+        public:
+            /*
+            * A game inside the reader's memory
+            * - Only valid while the reader's memory is
+            */
+            struct Game
+            {
+                std::string_view startFen{};
+                const unsigned char* moves{nullptr};
+                std::uint32_t plyCount{0};
+                ChessGameState::Result result{ChessGameState::Result::ongoing};
+
+                /*
+                * Decodes the move at the inputted ply
+                */
+                void getMove(std::uint32_t ply, Move::position& start, Move::position& end, int& idx) const;
+            };
+
+            /*
+            * The version written by GameRecordWriter
+            */
+            static constexpr std::uint16_t version = 1;
+
+        private:
+            MappedFile file{};
+            const unsigned char* data{nullptr};
+            std::size_t size{0};
+            std::size_t offset{0};
+
+        public:
+            /*
+            * Constructor: Reads nothing until open() or setData() is called
+            */
+            GameRecordReader() = default;
+
+            /*
+            * Maps the file at the inputted path and starts reading its first
+            * game
+            * - Returns false if the file cannot be mapped or has the wrong header
+            */
+            bool open(const std::string& path);
+
+            /*
+            * Reads records from the inputted memory, which must outlive the
+            * reader's games
+            * - Returns false if the memory does not start with the file header
+            */
+            bool setData(const unsigned char* newData, std::size_t newSize);
+
+            /*
+            * Reads the next game into game
+            * - Returns false at the end of the data, if the next game is cut
+            *   off, or if its result is not a valid result, in which case game
+            *   is unchanged
+            */
+            bool next(Game& game);
+
+            /*
+            * Plays every move of a game from its starting position and returns
+            * the resulting game state, or nullptr if a move cannot be played
+            * - The caller owns the returned game state
+            */
+            static ChessGameState* replay(const Game& game);
+    };
+}
+#endif
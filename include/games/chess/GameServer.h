@@ -0,0 +1,240 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "GameRecord.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * Holds many chess games at once, each identified by a number
+     * - Every game is kept as a GameRecord, and the game states of the most
+     *   recently used games are kept alongside it
+     * - Once there are too many game states, the least recently used ones
+     *   are evicted and are replayed from their record when next used, so
+     *   idle games only take a few bytes per move
+     * - Each game has its own lock, so different games can be used from
+     *   different threads at once
+    */
+    class SessionManager
+    {
+        public:
+            struct Options
+            {
+                /*
+                * The most game states kept at once
+                */
+                std::size_t maxActiveSessions{1024};
+            };
+
+            /*
+            * The state of a game (see getStatus())
+            */
+            struct Status
+            {
+                ChessGameState::Result result{ChessGameState::Result::ongoing};
+                Player player{Player::white};
+                std::size_t plies{0};
+                std::string fen{};
+            };
+
+            /*
+            * The number of games, of kept game states, and of evictions and
+            * replays since the manager was created
+            */
+            struct Counts
+            {
+                std::size_t sessions{0};
+                std::size_t active{0};
+                std::uint64_t evictions{0};
+                std::uint64_t restores{0};
+            };
+
+        private:
+            /*
+            * A game, where chessState is nullptr while evicted
+            * - Everything but lastUsed and active is guarded by mutex
+            * - closed is set once the game is closed, for requests that found
+            *   the game just before
+            */
+            struct Session
+            {
+                std::mutex mutex{};
+                GameRecord record{};
+                std::unique_ptr<ChessGameState> chessState{};
+                bool closed{false};
+                std::atomic<std::uint64_t> lastUsed{0};
+                std::atomic<bool> active{false};
+            };
+
+            Options options;
+
+            /*
+            * Every game, guarded by sessionsMutex
+            */
+            std::unordered_map<std::uint64_t, std::shared_ptr<Session>> sessions{};
+            std::shared_mutex sessionsMutex{};
+            std::uint64_t nextId{1};
+
+            std::atomic<std::uint64_t> clock{0};
+            std::atomic<std::size_t> activeCount{0};
+            std::atomic<std::uint64_t> evictions{0};
+            std::atomic<std::uint64_t> restores{0};
+
+            /*
+            * Returns the game with the inputted id, or nullptr
+            */
+            std::shared_ptr<Session> find(std::uint64_t id);
+
+            /*
+            * Makes sure a locked game has a game state, replaying its record if
+            * it was evicted, and marks it as used
+            * - Returns false if the game was closed or the record cannot be
+            *   replayed
+            */
+            bool activate(Session& session);
+
+            /*
+            * Evicts the least recently used game states down to 3/4 of the
+            * limit once there are more than the limit, skipping games that are
+            * in use
+            */
+            void evictIdle();
+
+        public:
+            /*
+            * Constructor: Holds no games
+            */
+            SessionManager(Options options);
+
+            /*
+            * Starts a game from the inputted FEN, or from the starting position
+            * if it is empty, and sets id to its id
+            * - Returns false if the FEN is not valid
+            */
+            bool create(std::string_view fen, std::uint64_t& id);
+
+            /*
+            * Ends a game, returning false if there is no such game
+            */
+            bool close(std::uint64_t id);
+
+            /*
+            * Returns whether there is a game with the inputted id
+            */
+            bool contains(std::uint64_t id);
+
+            /*
+            * Lists the legal moves of the player to move in algebraic notation
+            * (see San)
+            * - Returns false if there is no such game
+            */
+            bool getLegalMoves(std::uint64_t id, std::vector<std::string>& moves);
+
+            /*
+            * Plays a move written in algebraic notation and sets played to the
+            * move as San::write() writes it
+            * - Returns false if there is no such game or the move is not legal
+            */
+            bool play(std::uint64_t id, std::string_view san, std::string& played);
+
+            /*
+            * Finds the state of a game, returning false if there is no such game
+            */
+            bool getStatus(std::uint64_t id, Status& status);
+
+            /*
+            * Copies the record of a game, returning false if there is no such
+            * game
+            */
+            bool getRecord(std::uint64_t id, GameRecord& record);
+
+            Counts getCounts();
+    };
+
+    /*
+     * Answers requests about the games of a SessionManager, one line per
+     * request and one line per response
+     * - Requests:
+     *   new [fen]            -> ok <id>
+     *   moves <id>           -> ok <move> <move> ...
+     *   play <id> <move>     -> ok <move>
+     *   status <id>          -> ok <result> <white|black> <plies> <fen>
+     *   close <id>           -> ok
+     *   info                 -> ok sessions <n> active <n> evictions <n> restores <n>
+     * - Moves are written in algebraic notation (see San), and results are
+     *   ongoing, checkmate, stalemate, repetition, or fiftyMoves
+     * - Failed requests are answered with "error <reason>"
+     *
+     * run() reads requests in a loop and hands them to a thread pool, so
+     * requests for different games run at the same time while requests for
+     * the same game run in the order they were sent. New games are given
+     * ids in the order they were requested. Responses are written
+     * in the order of the requests as soon as they are ready
+    */
+    class GameServer
+    {
+        public:
+            struct Options
+            {
+                /*
+                * The number of worker threads, or 0 for one per hardware thread
+                */
+                std::size_t threadCount{0};
+
+                /*
+                * The most requests in flight at once, or 0 for 4 per thread
+                */
+                std::size_t maxPending{0};
+
+                SessionManager::Options sessions{};
+            };
+
+            /*
+            * The number of requests that were answered and that failed
+            */
+            struct Summary
+            {
+                std::size_t requests{0};
+                std::size_t failed{0};
+            };
+
+        private:
+            Options options;
+            SessionManager sessions;
+
+        public:
+            /*
+            * Constructor: Serves games with the inputted options
+            */
+            GameServer(Options options);
+
+            /*
+            * Answers a single request (see above), without a newline
+            */
+            std::string handle(std::string_view request);
+
+            /*
+            * Answers every line of input until it ends or a line is "quit"
+            * - Empty lines are skipped
+            */
+            Summary run(std::istream& input, std::ostream& output);
+
+            SessionManager& getSessions();
+    };
+}
+#endif
@@ -0,0 +1,248 @@
+#ifndef MONTECARLOSEARCH_H
+#define MONTECARLOSEARCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "GameState.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * A Monte Carlo Tree Search over a chess game state
+     * - Each rollout walks down the tree by UCT, adds the children of the
+     *   node it stops at, and plays the game out with the rollout policy
+     * - Rollouts run on the threads of a thread pool, and each thread plays
+     *   on its own copy of the game state (see ChessFen), so copies only
+     *   remember repetitions from the position they were copied at
+     * - Threads add a virtual loss to every node they walk through until
+     *   their rollout finishes, so they spread out over the tree
+     * - Nodes come from a fixed-size pool, and once it is full the tree
+     *   stops growing but rollouts keep running
+     * - The tree is kept between searches: if the game state has moved on
+     *   by a move or two since the last search, the subtree of the new
+     *   position is reused
+    */
+    class MonteCarloSearch
+    {
+        public:
+            /*
+            * Picks which of the legal moves of the current player a rollout
+            * plays, returning its index
+            * - Called with at least 1 legal move
+            */
+            using RolloutPolicy = std::function<std::size_t(ChessGameState&, const std::vector<GameState::LegalMove>&, std::mt19937_64&)>;
+
+            struct Options
+            {
+                /*
+                * The number of rollout threads, or 0 for one per hardware thread
+                */
+                std::size_t threadCount{0};
+
+                /*
+                * The most nodes the tree can hold
+                */
+                std::size_t maxNodes{1 << 20};
+
+                /*
+                * The weight of exploring rarely visited moves in UCT
+                */
+                double exploration{1.4};
+
+                /*
+                * The number of losses added to each node on the path of an
+                * unfinished rollout
+                */
+                std::uint32_t virtualLoss{1};
+
+                /*
+                * The most moves a rollout plays before calling the game a draw
+                */
+                int maxRolloutPly{200};
+
+                /*
+                * The seed of the first thread, and each thread after it uses
+                * the next seed
+                */
+                std::uint64_t seed{0};
+
+                RolloutPolicy rolloutPolicy{randomRollout};
+            };
+
+            /*
+            * The most visited move of the last search
+            * - score is the average result of the move for the player to move,
+            *   from 0 for a loss to 1 for a win
+            * - found is false if the current player had no moves
+            */
+            struct Result
+            {
+                GameState::LegalMove move{};
+                double score{0.0};
+                std::uint32_t visits{0};
+                bool found{false};
+            };
+
+            /*
+            * Throughput of the last search
+            */
+            struct Stats
+            {
+                std::uint64_t rollouts{0};
+                double seconds{0.0};
+                std::size_t nodes{0};
+
+                /*
+                * Reused nodes that were already in the tree when the search started
+                */
+                std::size_t reusedNodes{0};
+
+                double getRolloutsPerSecond() const;
+            };
+
+        private:
+            /*
+            * A position in the tree, reached from its parent by move
+            * - points counts half points for the player who made move (2 for
+            *   a win, 1 for a draw), and visits includes virtual losses
+            * - key is the position key, set once the node is first visited
+            * - Children are stored next to each other in the pool
+            */
+            struct Node
+            {
+                static constexpr std::uint8_t unexpanded = 0;
+                static constexpr std::uint8_t expanding = 1;
+                static constexpr std::uint8_t expanded = 2;
+
+                GameState::LegalMove move{};
+                std::atomic<std::uint64_t> key{0};
+                std::atomic<std::uint32_t> visits{0};
+                std::atomic<std::uint64_t> points{0};
+                std::atomic<std::uint8_t> state{unexpanded};
+                std::uint32_t firstChild{0};
+                std::uint32_t childCount{0};
+            };
+
+            /*
+            * A fixed block of nodes handed out in order, which can be cleared
+            * all at once
+            */
+            class NodePool
+            {
+                private:
+                    std::unique_ptr<Node[]> nodes{};
+                    std::size_t capacity{0};
+                    std::atomic<std::size_t> used{0};
+
+                public:
+                    NodePool(std::size_t capacity);
+
+                    /*
+                    * Returns the index of the first of count new nodes, or
+                    * returns false if there is not enough room
+                    */
+                    bool allocate(std::size_t count, std::uint32_t& first);
+
+                    Node& operator[](std::uint32_t index);
+                    std::size_t getUsed();
+                    void clear();
+            };
+
+            ChessGameState& chessState;
+            Options options;
+            ThreadPool pool;
+
+            /*
+            * The tree, with the root at index 0 of the active pool, and a
+            * spare pool that reused subtrees are copied into
+            */
+            std::unique_ptr<NodePool> nodes;
+            std::unique_ptr<NodePool> spareNodes;
+
+            Stats stats{};
+            std::uint64_t searches{0};
+
+            /*
+            * Makes the root match the current position, reusing the subtree of
+            * the position if it is a child or grandchild of the old root
+            */
+            void prepareRoot();
+
+            /*
+            * Returns whether the children of a node are the legal moves of the
+            * current position, so a subtree is never reused for a different
+            * position with the same key
+            * - Nodes without children always match
+            */
+            bool matchesPosition(Node& node);
+
+            /*
+            * Copies the subtree at index from the active pool into the spare
+            * pool as its root, then swaps the pools
+            */
+            void reuseSubtree(std::uint32_t index);
+
+            /*
+            * Adds the children of a node for the current player of a game state
+            * - Only one thread expands a node, and returns false for the others
+            */
+            bool expand(Node& node, ChessGameState& state);
+
+            /*
+            * Returns the child of a node with the best UCT score
+            */
+            Node& selectChild(Node& node);
+
+            /*
+            * Plays a game state out with the rollout policy and puts it back
+            * - Returns false for a draw, or sets loser to the player who was
+            *   checkmated and returns true
+            */
+            bool rollout(ChessGameState& state, std::mt19937_64& random, Player& loser);
+
+            /*
+            * Runs rollouts on a copy of the game state until count is used up
+            */
+            void work(ChessGameState& state, std::uint64_t seed, std::atomic<std::int64_t>& count);
+
+        public:
+            /*
+            * Constructor: Searches the inputted game state, which must outlive
+            * the search
+            */
+            MonteCarloSearch(ChessGameState& chessState, Options options);
+
+            /*
+            * Runs the inputted number of rollouts from the current position of
+            * the game state and returns its most visited move
+            * - The move can be passed straight to GameState::movePiece()
+            * - The game state is left unchanged
+            */
+            Result search(std::uint64_t rollouts);
+
+            /*
+            * Returns the throughput of the last search
+            */
+            const Stats& getStats();
+
+            /*
+            * Returns the number of nodes in the tree
+            */
+            std::size_t getNodeCount();
+
+            /*
+            * A rollout policy that picks a random legal move
+            */
+            static std::size_t randomRollout(ChessGameState& state, const std::vector<GameState::LegalMove>& legalMoves, std::mt19937_64& random);
+    };
+}
+#endif
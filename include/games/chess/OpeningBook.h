@@ -0,0 +1,154 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "GameState.h"
+#include "MappedFile.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * Weighted moves for known positions, read straight out of a memory-mapped
+     * file (see OpeningBookBuilder)
+     * - Positions are found by GameState::getPositionKey(), and book moves
+     *   are checked against the legal moves before pickMove() returns them,
+     *   since keys can collide and books can be built with other rules
+     * - findMoves() does not parse the file or allocate memory
+     *
+     * Books are stored in a binary file:
+     * - File header: "ACOB", then the format version (uint16) and 2 unused
+     *   bytes
+     * - Each entry: the position key (uint64), the move encoded by
+     *   GameRecord::encodeMove() (uint16), and its weight (uint16)
+     * - Entries are sorted by key and then by move, and numbers are
+     *   little-endian
+    */
+    class OpeningBook
+    {
+        public:
+            struct Entry
+            {
+                std::uint64_t key{0};
+                std::uint16_t move{0};
+                std::uint16_t weight{0};
+            };
+
+            /*
+            * The version written by OpeningBookBuilder
+            */
+            static constexpr std::uint16_t version = 1;
+
+            /*
+            * The size of the file header and of each entry in bytes
+            */
+            static constexpr std::size_t headerSize = 8;
+            static constexpr std::size_t entrySize = 12;
+
+            /*
+            * The most moves of a position that pickMove() chooses between
+            */
+            static constexpr std::size_t maxPositionMoves = 64;
+
+        private:
+            MappedFile file{};
+            const unsigned char* entries{nullptr};
+            std::size_t entryCount{0};
+
+            /*
+            * Returns the key of the entry at the inputted index
+            */
+            std::uint64_t getKey(std::size_t index);
+
+        public:
+            /*
+            * Constructor: Holds no moves until open() or setData() is called
+            */
+            OpeningBook() = default;
+
+            /*
+            * Maps the book at the inputted path
+            * - Returns false if the file cannot be mapped or is not a book
+            */
+            bool open(const std::string& path);
+
+            /*
+            * Reads the book from the inputted memory, which must outlive the
+            * book
+            * - Returns false if the memory is not a book
+            */
+            bool setData(const unsigned char* data, std::size_t size);
+
+            /*
+            * Returns the number of entries in the book
+            */
+            std::size_t getEntryCount();
+
+            /*
+            * Returns the entry at the inputted index
+            */
+            Entry getEntry(std::size_t index);
+
+            /*
+            * Copies up to maxFound entries of the inputted position into found
+            * and returns the number of entries the position has
+            * - Uses an interpolation search, since keys are spread evenly
+            */
+            std::size_t findMoves(std::uint64_t key, Entry* found, std::size_t maxFound);
+            std::size_t findMoves(ChessGameState& chessState, Entry* found, std::size_t maxFound);
+
+            /*
+            * Picks one of the current position's legal book moves with
+            * probability proportional to its weight
+            * - random is any random number, so the caller controls the seed
+            * - legalMoves is overwritten with the legal moves of the position,
+            *   so a caller that reuses it does not allocate for every pick
+            * - Returns false if the position has no legal book moves
+            */
+            bool pickMove(ChessGameState& chessState, std::uint64_t random, std::vector<GameState::LegalMove>& legalMoves, GameState::LegalMove& legalMove);
+    };
+
+    /*
+     * Builds opening books from played games
+    */
+    class OpeningBookBuilder
+    {
+        private:
+            std::vector<OpeningBook::Entry> entries{};
+
+        public:
+            /*
+            * Adds weight to a move of the inputted position
+            */
+            void add(std::uint64_t key, std::uint16_t move, std::uint16_t weight);
+
+            /*
+            * Replays a game and adds its first maxPly moves
+            * - Moves of the winner of a checkmate weigh 2, moves of the loser
+            *   weigh 0, and moves of any other game weigh 1
+            * - Returns false if the game cannot be replayed, in which case the
+            *   moves before the failed move are still added
+            */
+            bool addGame(const GameRecordReader::Game& game, std::uint32_t maxPly);
+
+            /*
+            * Returns the number of moves added so far
+            */
+            std::size_t getAddedCount();
+
+            /*
+            * Merges the moves added for the same position and writes them as a
+            * book, leaving out moves with no weight
+            * - Returns whether the stream is still good
+            */
+            bool write(std::ostream& output);
+    };
+}
+#endif
@@ -0,0 +1,144 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "GameRecord.h"
+
+namespace chess {
+    /*
+     * A game read from a PGN file, before its moves are checked
+    */
+    struct PgnGame
+    {
+        /*
+        * The tag pairs of the game in file order, ex: {"White", "Carlsen"}
+        */
+        std::vector<std::pair<std::string, std::string>> tags{};
+
+        /*
+        * The moves of the game in SAN (see San), one per ply
+        */
+        std::vector<std::string> moves{};
+
+        /*
+        * The game termination marker: 1-0, 0-1, 1/2-1/2, or *
+        */
+        std::string result{};
+
+        /*
+        * Returns the value of the first tag with the inputted name, or an
+        * empty string if there is none
+        */
+        std::string_view getTag(std::string_view name) const;
+    };
+
+    /*
+     * Reads games one at a time from a PGN stream
+     * - Tag pairs, move numbers, and termination markers are read as usual
+     * - Comments ({...} and ;...), variations ((...), which may be nested),
+     *   numeric annotation glyphs ($1), and escape lines (%...) are skipped
+     * - Moves are not checked (see PgnImporter)
+    */
+    class PgnReader
+    {
+        private:
+            std::istream& input;
+
+        public:
+            /*
+            * Constructor: Reads games from the inputted stream
+            */
+            PgnReader(std::istream& input);
+
+            /*
+            * Reads the next game into game
+            * - Returns false once the stream has no more games
+            * - A game without a termination marker ends at the next tag pair or
+            *   at the end of the stream
+            */
+            bool next(PgnGame& game);
+    };
+
+    /*
+     * Checks PGN games by replaying them and converts them to game records
+     * - Every move must be legal SAN (see San) that GameState::canMovePiece()
+     *   accepts in the position it is played in
+     * - Games start from their FEN tag (see ChessFen) if they have one
+     *
+     * Games are read on the calling thread and replayed on a thread pool, with
+     * only a fixed number in flight at once, so archives of any size can be
+     * imported with bounded memory
+    */
+    class PgnImporter
+    {
+        public:
+            struct Options
+            {
+                /*
+                * The number of worker threads, or 0 for one per hardware thread
+                */
+                std::size_t threadCount{0};
+
+                /*
+                * The most games in flight at once, or 0 for 4 per thread
+                */
+                std::size_t maxPending{0};
+            };
+
+            /*
+            * The result of replaying a single game
+            * - index is the position of the game in the stream, starting at 0
+            * - If the game is invalid, failedPly is the ply that could not be
+            *   played (or -1 if the starting position is invalid) and error
+            *   describes why
+            * - record holds every move that could be played
+            */
+            struct ImportedGame
+            {
+                std::size_t index{0};
+                PgnGame game{};
+                GameRecord record{};
+                bool valid{false};
+                int failedPly{-1};
+                std::string error{};
+            };
+
+            /*
+            * The number of games that were read and that were invalid
+            */
+            struct Summary
+            {
+                std::size_t games{0};
+                std::size_t invalid{0};
+            };
+
+        private:
+            Options options;
+
+        public:
+            /*
+            * Constructor: Imports games with the inputted options
+            */
+            PgnImporter(Options options);
+
+            /*
+            * Reads every game from input, replays them in parallel, and calls
+            * onGame with each result in the same order as the input
+            * - onGame is only called on the calling thread
+            */
+            Summary run(std::istream& input, const std::function<void(const ImportedGame&)>& onGame);
+
+            /*
+            * Replays a single game and records its moves and final result
+            */
+            static ImportedGame validate(PgnGame game);
+    };
+}
+#endif
@@ -0,0 +1,49 @@
+#ifndef SAN_H
+#define SAN_H
+
+#include <string>
+#include <string_view>
+
+#include "ChessGameState.h"
+#include "GameState.h"
+#include "Move.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * Reads and writes moves in standard algebraic notation (SAN), extended
+     * for Anarchy Chess
+     * - Pieces are KQRBN as usual, plus O for the knook
+     * - Castling is O-O or O-O-O, and En Passant is written like any other
+     *   pawn capture, ex: exd6
+     * - Promotions end with the new piece, ex: e8=Q or exd8=O
+     * - A knight boost is a promotion to a knight followed by the square the
+     *   knight jumps to, ex: e8=Nf6 or e8=Nxf6
+     * - Knooklear fusion is a knight moving onto its own rook followed by =O,
+     *   ex: Nd2=O
+     * - Il Vaticano is the bishop moving to the other bishop's square, ex: Bxf1
+     * - Checks (+, #) and annotations (!, ?) are ignored when reading
+    */
+    class San
+    {
+        public:
+            /*
+            * Finds the current player's legal move written in the inputted SAN
+            * - Returns false if the text is not valid SAN or if it does not match
+            *   exactly 1 legal move
+            * - Candidates are checked with GameState::canMovePiece(), and moves
+            *   that only differ by the piece they leave behind are told apart by
+            *   simulating them
+            */
+            static bool parse(ChessGameState& chessState, std::string_view san, GameState::LegalMove& legalMove);
+
+            /*
+            * Writes the inputted legal move of the current player in SAN
+            * - Returns false if the move cannot be made
+            * - Only adds as much disambiguation as the position needs
+            */
+            static bool write(ChessGameState& chessState, Move::position start, Move::position end, int idx, std::string& san);
+    };
+}
+#endif
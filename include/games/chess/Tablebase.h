@@ -0,0 +1,231 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "MappedFile.h"
+#include "Search.h"
+
+namespace chess {
+    using namespace logic;
+
+    /*
+     * An endgame table holding the result of every position of a small set of
+     * pawnless pieces with perfect play, read straight out of a memory-mapped
+     * file (see TablebaseGenerator)
+     * - Material is written like KQvKR: the white pieces, then v, then the
+     *   black pieces, each side with exactly 1 king. O is the knook
+     * - Every position is stored for both players to move, and tables are
+     *   color-blind, so KQvKR also answers positions where black has the queen
+     * - Positions are assumed to have no castling rights
+     *
+     * Each position is stored as a single byte: 0 for a draw, 1 to 127 for a
+     * win in that many plies, 128 + n for a loss in n plies (so 128 is
+     * checkmate), and 255 for an illegal position
+     *
+     * Tables are stored in a binary file:
+     * - File header: "ACTB", the format version (uint16), the length of the
+     *   material (uint8), 1 unused byte, the number of blocks (uint32), and 4
+     *   unused bytes, followed by the material padded to a multiple of 4 bytes
+     * - The length of the Huffman code of each of the 256 values (uint8, 0
+     *   for values that never appear), which gives a canonical Huffman code
+     *   shared by every block
+     * - The offset of each block from the start of the file (uint32), plus
+     *   the offset of the end of the last block
+     * - Each block holds the codes of blockSize positions in index order,
+     *   packed starting from the most significant bit of each byte, so any
+     *   position can be found by decoding a single block
+     * - Numbers are little-endian
+    */
+    class Tablebase
+    {
+        public:
+            enum class Wdl
+            {
+                loss,
+                draw,
+                win
+            };
+
+            /*
+            * The result of a position for the player to move
+            * - distance is the number of plies to checkmate with perfect play,
+            *   or 0 for draws
+            */
+            struct Probe
+            {
+                Wdl wdl{Wdl::draw};
+                int distance{0};
+            };
+
+            /*
+            * The version written by TablebaseGenerator
+            */
+            static constexpr std::uint16_t version = 1;
+
+            /*
+            * The most pieces a table can hold, including both kings
+            */
+            static constexpr int maxPieces = 4;
+
+            /*
+            * The number of positions in each compressed block
+            */
+            static constexpr std::size_t blockSize = 1024;
+
+            /*
+            * The longest Huffman code a value can have
+            */
+            static constexpr int maxCodeLength = 16;
+
+            /*
+            * The values a position can be stored as (see above)
+            */
+            static constexpr std::uint8_t drawValue = 0;
+            static constexpr std::uint8_t lossValue = 128;
+            static constexpr std::uint8_t illegalValue = 255;
+            static constexpr int maxDistance = 126;
+
+            /*
+            * The score of a won position found by makeEvaluation(), minus its
+            * distance to checkmate so faster wins are preferred
+            */
+            static constexpr double winScore = 100000.0;
+
+        private:
+            MappedFile file{};
+            std::string material{};
+            std::vector<Piece::ID> pieces[2]{};
+            const unsigned char* data{nullptr};
+            std::size_t size{0};
+            std::uint32_t blockCount{0};
+            std::uint64_t entryCount{0};
+            std::size_t offsetsStart{0};
+
+            // The number of codes of each length, and the values in order of
+            // their codes
+            std::uint16_t codeCounts[maxCodeLength + 1]{};
+            std::uint8_t codeValues[256]{};
+
+        public:
+            /*
+            * Constructor: Holds no positions until open() or setData() is called
+            */
+            Tablebase() = default;
+
+            /*
+            * Maps the table at the inputted path
+            * - Returns false if the file cannot be mapped or is not a table
+            */
+            bool open(const std::string& path);
+
+            /*
+            * Reads the table from the inputted memory, which must outlive the
+            * table
+            * - Returns false if the memory is not a table
+            */
+            bool setData(const unsigned char* newData, std::size_t newSize);
+
+            /*
+            * Returns the material of the table, ex: KQvKR
+            */
+            const std::string& getMaterial();
+
+            /*
+            * Returns the number of positions in the table
+            */
+            std::uint64_t getEntryCount();
+
+            /*
+            * Returns the stored value of the position at the inputted index
+            * - The index of a position is the side to move (0 for white) times
+            *   64^pieces, plus the square ((y - 1) * 8 + x - 1) of each piece
+            *   in material order as the digits of a base 64 number, with the
+            *   first piece as the most significant digit
+            */
+            std::uint8_t getValue(std::uint64_t index);
+
+            /*
+            * Finds the result of the current position for the current player
+            * - Returns false if the position does not have the table's material,
+            *   has castling rights, or has pieces controlled by several players
+            */
+            bool probe(ChessGameState& chessState, Probe& result);
+
+            /*
+            * Returns an evaluation for Search that scores positions found in
+            * the table by their result and uses fallback for all others
+            * - The table must outlive the evaluation
+            */
+            Search::Evaluation makeEvaluation(Search::Evaluation fallback = Search::boardEvaluation);
+
+            /*
+            * Converts a stored value into a result, returning false for illegal
+            * positions
+            */
+            static bool decodeValue(std::uint8_t value, Probe& result);
+    };
+
+    /*
+     * Builds endgame tables by retrograde analysis
+     * - Starts from every checkmate and works backwards by unmaking moves,
+     *   so each position is only revisited when one of the positions it
+     *   leads to is solved
+     * - Captures and Knooklear fusion lead to tables with other material,
+     *   which are built first and kept for later tables
+     * - Positions are split between the threads of a thread pool
+    */
+    class TablebaseGenerator
+    {
+        public:
+            struct Options
+            {
+                /*
+                * The number of worker threads, or 0 for one per hardware thread
+                */
+                std::size_t threadCount{0};
+            };
+
+        private:
+            Options options;
+            std::map<std::string, std::vector<std::uint8_t>> tables{};
+
+        public:
+            /*
+            * Constructor: Builds tables with the inputted options
+            */
+            TablebaseGenerator(Options options);
+
+            /*
+            * Returns the canonical name of the inputted material, which puts
+            * the stronger side first, or an empty string if the material is
+            * not valid or has too many pieces
+            */
+            static std::string getCanonicalMaterial(std::string_view material);
+
+            /*
+            * Builds the table of the inputted material and returns its values
+            * in index order (see Tablebase::getValue())
+            * - The material is made canonical first (see getCanonicalMaterial())
+            * - Returns nullptr if the material is not valid or a distance does
+            *   not fit in a table
+            * - The values stay valid as long as the generator
+            */
+            const std::vector<std::uint8_t>* generate(std::string_view material);
+
+            /*
+            * Compresses a table and writes it to the inputted stream, which
+            * should be opened in binary mode
+            * - Returns whether the stream is still good
+            */
+            static bool write(std::ostream& output, std::string_view material, const std::vector<std::uint8_t>& values);
+    };
+}
+#endif
@@ -57,9 +57,15 @@ namespace chess {
             bool canBoost(GameState& gameState);
 
             /*
-            * Sets the boost turn to the current turn
+            * Sets the boost turn to the current turn or to the inputted turn
             */
             void setBoostTurn(GameState& gameState);
+            void setBoostTurn(int turn);
+
+            /*
+            * Returns the turn that the pawn last boosted
+            */
+            int getBoostTurn();
 
             /*
             * Override priority to 10 if En Passant is a possibility
@@ -152,6 +158,17 @@ namespace chess {
             * The GameState object that tracks the current turns of the game
             */
             GameState& gameState;
+
+            /*
+            * The pawn's boost turn before the most recent call of this action
+            */
+            int previousBoostTurn{};
+
+            /*
+            * The game state's boosted pawn before the most recent call of this
+            * action (see ChessGameState::getBoostedPawn())
+            */
+            Piece* previousBoostedPawn{nullptr};
         public:
             /*
             * Create an action of this type that tracks the inputted pawn
@@ -159,6 +176,19 @@ namespace chess {
             PawnBoostAction(Pawn& pawn, GameState& gameState) : 
                 pawn{pawn}, gameState{gameState}{}
 
+            /*
+            * Change the pawn's boost turn and make it the game state's boosted pawn
+            * - Also changed while simulating so searches that simulate several
+            *   moves can find En Passant
+            */
+            bool callAction(Move::position end, GameBoard* board) override;
+
+            /*
+            * Change the pawn's boost turn and the boosted pawn back to what they
+            * were before callAction()
+            */
+            bool reverseAction(GameBoard* board) override;
+
             /*
             * Change the pawn's boost turn
             */
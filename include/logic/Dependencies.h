@@ -0,0 +1,72 @@
+#ifndef DEPENDENCIES_H
+#define DEPENDENCIES_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <compare>
+
+#include "Move.h"
+
+namespace logic {
+    /*
+    * A ray walked by GameBoard::findNextOccupied() during generation
+    * - Stands in for a dependency on every position along the ray, so a ray
+    *   over empty space costs the same no matter how long it is
+    */
+    struct RayDependency
+    {
+        Move::position start{};
+        Move::position direction{};
+        int maxSteps{0};
+
+        auto operator<=>(const RayDependency& other) const = default;
+    };
+
+    /*
+    * Everything that a generated list of moves depended on
+    * - If every square and roster still has the same fingerprint, every ray
+    *   still reaches the same first occupied position (and the
+    *   turn is the same when turn is set), generating the moves again would
+    *   give exactly the same result
+    */
+    struct Dependencies
+    {
+        /*
+        * The squares that were read or changed during generation and the
+        * fingerprint of each square's contents (see GameBoard::getSquareFingerprint())
+        */
+        std::vector<std::pair<Move::position, std::uint64_t>> squares{};
+
+        /*
+        * The players whose pieces were listed during generation and the hash
+        * of each player's pieces (see GameBoard::getRosterHash())
+        */
+        std::vector<std::pair<int, std::uint64_t>> rosters{};
+
+        /*
+        * The rays that were walked during generation and the number of steps
+        * each took to reach its first occupied position (-1 if there was none)
+        */
+        std::vector<std::pair<RayDependency, int>> rays{};
+
+        /*
+        * Whether the moves depend on the current turn
+        */
+        bool turn{false};
+    };
+
+    /*
+    * Collects the dependencies of a generation while it is running
+    * - Only positions are stored here, fingerprints are taken once the
+    *   generation is complete and every simulation it made has been reverted
+    */
+    struct DependencyRecorder
+    {
+        std::vector<Move::position> squares{};
+        std::vector<int> rosters{};
+        std::vector<RayDependency> rays{};
+        bool turn{false};
+    };
+}
+#endif
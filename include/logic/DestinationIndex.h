@@ -0,0 +1,95 @@
+#ifndef DESTINATIONINDEX_H
+#define DESTINATIONINDEX_H
+
+#include <vector>
+#include <cstdint>
+
+#include "Move.h"
+
+namespace logic {
+    class DestinationIndex
+    {
+        /*
+        * An index from each position in a list of moves to the moves that
+        * contain it
+        * - Stored as a small open-addressing hash table, so it works on
+        *   bounded and unbounded boards alike and finding the moves to a
+        *   position takes O(1) time instead of searching every move
+        * - Each position stores a mask where bit i is set when moves[i]
+        *   contains the position, so the moves are always found in the same
+        *   order as the list of moves
+        */
+        public:
+            /*
+            * The most moves that can be indexed
+            * - Lists with more moves than this are not indexed (see indexed())
+            */
+            static constexpr int maxIndexedMoves = 64;
+
+        private:
+            /*
+            * A single position in the table
+            */
+            struct Slot
+            {
+                Move::position position{};
+                std::uint64_t moveMask{0};
+                int maxPriority{0};
+                bool used{false};
+            };
+
+            /*
+            * The hash table, whose size is always 0 or a power of 2
+            */
+            std::vector<Slot> slots{};
+
+            /*
+            * Whether the last list of moves was small enough to index
+            */
+            bool isIndexed{false};
+
+            /*
+            * Returns the slot that contains the position, or the empty slot
+            * where it would be inserted
+            * - The table must not be empty
+            */
+            Slot& findSlot(Move::position position);
+            const Slot* findUsedSlot(Move::position position) const;
+
+        public:
+            /*
+            * Indexes every position in the inputted moves, replacing the
+            * previous index
+            */
+            void build(std::vector<Move>& moves);
+
+            /*
+            * Removes every position from the index
+            */
+            void clear();
+
+            /*
+            * Returns whether the moves were indexed
+            * - When false, every query returns nothing, so search the moves
+            *   directly instead
+            */
+            bool indexed() const;
+
+            /*
+            * Returns whether any move contains the position
+            */
+            bool contains(Move::position position) const;
+
+            /*
+            * Returns a mask where bit i is set when moves[i] contains the position
+            */
+            std::uint64_t getMoveMask(Move::position position) const;
+
+            /*
+            * Returns the highest priority of the moves that contain the position
+            * - Returns 0 if no move contains the position
+            */
+            int getMaxPriority(Move::position position) const;
+    };
+}
+#endif
@@ -0,0 +1,83 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "Piece.h"
+#include "Move.h"
+
+namespace logic {
+    using Player = Piece::Player;
+
+    class Evaluator
+    {
+        /*
+        * Keeps each player's material and piece-square scores up to date as
+        * pieces are added to, removed from, and moved around a board
+        * - The board calls the update functions below whenever it changes,
+        *   including while actions are simulated and reversed, so evaluating
+        *   a position takes O(1) time instead of walking over every piece
+        * - A piece counts for every player that controls it
+        * - Games change how pieces are scored by overriding getPieceValue()
+        *   and getPieceSquareValue() (see GameBoard::setEvaluator())
+        */
+        private:
+            /*
+            * The material and piece-square scores of each player, indexed by
+            * player, and the sums of each over every player
+            */
+            double material[static_cast<int>(Player::last)]{};
+            double positional[static_cast<int>(Player::last)]{};
+            double totalMaterial{0.0};
+            double totalPositional{0.0};
+
+            /*
+            * Adds the piece's scores at the inputted position to every player
+            * that controls it, multiplied by sign
+            */
+            void update(Piece* piece, Move::position position, double sign);
+
+        public:
+            virtual ~Evaluator() = default;
+
+            /*
+            * Returns the material value of a piece
+            * - Defaults to Piece::getValue()
+            */
+            virtual double getPieceValue(Piece* piece) { return piece->getValue(); }
+
+            /*
+            * Returns the value of a piece being on the inputted position
+            * - Defaults to 0, so only material is counted
+            * - Must only depend on the piece and the position, since it is
+            *   only found again when the piece moves
+            */
+            virtual double getPieceSquareValue(Piece* piece, Move::position position) { return 0.0; }
+
+            /*
+            * Updates the scores when a piece is put on the board, taken off the
+            * board, or moved from one position to another
+            * - Called by GameBoard, so there is no need to call these directly
+            */
+            void pieceAdded(Piece* piece, Move::position position);
+            void pieceRemoved(Piece* piece, Move::position position);
+            void pieceMoved(Piece* piece, Move::position prevPosition, Move::position newPosition);
+
+            /*
+            * Sets every score to 0
+            */
+            void clear();
+
+            /*
+            * Returns the total material or piece-square score of the pieces the
+            * player controls
+            */
+            double getMaterial(Player player);
+            double getPositional(Player player);
+
+            /*
+            * Returns the player's material and piece-square scores minus those of
+            * every other player
+            */
+            double evaluate(Player player);
+    };
+}
+#endif
@@ -6,10 +6,14 @@
 #include <string>
 #include <tuple>
 #include <memory>
+#include <cstdint>
 
 #include "HashPair.h"
 #include "Piece.h"
 #include "Move.h"
+#include "SparseBoard.h"
+#include "Dependencies.h"
+#include "Evaluator.h"
 
 namespace logic{
     /*
@@ -19,16 +23,15 @@ namespace logic{
     {
         private:
             /*
-            * The board, which uses an unordered_map for O(1) access times for a 
-            * given position
-            * - hash_tuple::pair_hash is necessary in the template becase by default,
-            *   C++ does not support the hashing of pairs. That struct contains a 
-            *   hash function definition that works for all pairs to work around this
+            * The board, which stores pieces in sparse tiles for O(1) access times
+            * for a given position (see SparseBoard.h)
+            * - Only the tiles that have held pieces are allocated, so infinite
+            *   boards with pieces far apart stay small
             * 
             * A null piece means that space is unoccupied
             * All pieces MUST be on the heap
             */
-            std::unordered_map<Move::position, Piece*, hash_tuple::pair_hash> board{};
+            SparseBoard board{};
 
             /*
             * All of the pieces that have been captured so far
@@ -52,6 +55,43 @@ namespace logic{
             */
             std::vector<std::shared_ptr<Action>> simulation{};
 
+            /*
+            * The size of simulation when each simulation frame began
+            * - revertSimulation() only undoes the actions of the innermost frame,
+            *   so checking a move while another move is simulated (ex: during 
+            *   a search) does not undo the other move
+            */
+            std::vector<std::size_t> simulationFrames{};
+
+            /*
+            * The maximum number of positions a ray can travel before stopping
+            * - Used to keep sliding pieces finite on infinite boards
+            */
+            int rayHorizon{64};
+
+            /*
+            * A stack of dependency recorders for the move generations that are
+            * currently running, with the innermost generation at the back
+            * - Board queries are recorded in the back recorder
+            */
+            std::vector<DependencyRecorder> recorders{};
+
+            /*
+            * Scores the pieces on the board as they change, or nullptr if the
+            * board is not evaluated (see setEvaluator())
+            */
+            std::unique_ptr<Evaluator> evaluator{};
+
+            /*
+            * The number of pieces currently on the board
+            */
+            int pieceCount{0};
+
+            /*
+            * The total value of each player's captured pieces
+            */
+            std::unordered_map<Piece::Player, double> capturedScores{};
+
         public:
             /*
             * Constructor: Initialize captured piece vectors and set up the board 
@@ -135,6 +175,16 @@ namespace logic{
             */
             bool addPieces(std::vector<Piece*> pieces);
 
+            /*
+            * Returns the number of pieces currently on the board
+            */
+            int getPieceCount();
+
+            /*
+            * Returns the number of pieces on the board that a player controls
+            */
+            int getPieceCount(Piece::Player player);
+
             /*
             * Retrieves a piece from a position
             * 
@@ -227,10 +277,134 @@ namespace logic{
             bool movePiece(Move::position prevPosition, int newX, int newY);
             bool movePiece(Move::position prevPosition, Move::position newPosition);
             
+            /*
+            * Walks from start (exclusive) in steps of direction and finds the
+            * first occupied position
+            * - Empty sections of the board are skipped in a single step, so this
+            *   is much faster than calling occupiedOnBoard() along the ray
+            * - Does not check onBoard(), only pieces on the board are considered
+            * 
+            * Returns:
+            * - The number of steps from start to the first occupied position
+            * - -1 if there is no piece within maxSteps steps
+            */
+            int findNextOccupied(Move::position start, Move::position direction, int maxSteps);
+
+            /*
+            * Returns the maximum number of positions a ray can travel
+            * - Games with bounded boards should override this with the longest 
+            *   distance across the board
+            */
+            virtual int getRayHorizon() { return rayHorizon; }
+
+            /*
+            * Changes the maximum number of positions a ray can travel
+            */
+            void setRayHorizon(int newHorizon);
+
+            /*
+            * Returns the positions along a ray starting next to start and travelling
+            * in steps of direction
+            * - The ray contains every unoccupied position up to the first occupied
+            *   position, which is also included so the caller can decide whether 
+            *   it can be captured
+            * - The ray stops early at the first position that is not on the board
+            * - The first blocker is found with the board's line index, so long rays
+            *   over empty space do not check every position for a piece
+            * 
+            * Parameters:
+            * - The starting position of the ray (not included in the result)
+            * - The step taken between positions
+            * - The maximum number of positions in the ray, or 0 to use getRayHorizon()
+            */
+            std::vector<Move::position> castRay(Move::position start, Move::position direction, int horizon = 0);
+
+            /*
+            * Returns a hash of the pieces on the board and their positions
+            * - Kept up to date as pieces are added, moved, and removed, including
+            *   during simulations, so this is O(1)
+            * - The same arrangement of pieces always has the same hash, so the
+            *   hash can be used to recognize repeated or simulated positions
+            */
+            std::uint64_t getPositionHash();
+
+            /*
+            * Returns a fingerprint of the contents of a position
+            * - Empty positions have a fingerprint of 0
+            * - Otherwise, the fingerprint depends on the piece's ID, its players,
+            *   the position, and whether the piece has already moved
+            */
+            std::uint64_t getSquareFingerprint(Move::position position);
+
+            /*
+            * Returns a hash of the pieces a player controls and their positions
+            */
+            std::uint64_t getRosterHash(Piece::Player player);
+
+            /*
+            * Starts recording the positions and players queried by a move generation
+            * - Every call must be paired with endDependencyRecording()
+            * - Recordings nest, and ending a recording adds everything it recorded
+            *   to the recording that contains it
+            */
+            void beginDependencyRecording();
+
+            /*
+            * Stops the innermost recording and returns its dependencies with 
+            * fingerprints taken from the current board
+            * - Call this after every simulation made during the recording has
+            *   been reverted
+            */
+            Dependencies endDependencyRecording();
+
+            /*
+            * Returns whether a move generation is currently being recorded
+            */
+            bool recordingDependencies();
+
+            /*
+            * Records that the current move generation depends on a position
+            * - Board queries (getPiece(), occupiedOnBoard(), castRay(), ...) and 
+            *   board changes record their positions automatically, so this is 
+            *   only needed for positions that are read some other way
+            */
+            void recordDependency(Move::position position);
+
+            /*
+            * Records that the current move generation depends on every position
+            * within maxSteps steps of start, up to the first occupied one
+            * - findNextOccupied() and castRay() record their rays automatically
+            */
+            void recordRayDependency(Move::position start, Move::position direction, int maxSteps);
+
+            /*
+            * Records that the current move generation depends on the turn
+            */
+            void recordTurnDependency();
+
+            /*
+            * Records all of the dependencies of a cached generation in the current
+            * move generation, for when one piece reuses another piece's moves
+            */
+            void recordDependencies(const Dependencies& dependencies);
+
+            /*
+            * Returns true if every position and player in the dependencies still
+            * has the same fingerprint and every ray still stops at the same position
+            * - Does not check the turn, see Dependencies::turn
+            */
+            bool dependenciesHold(const Dependencies& dependencies);
+
             /*
             * Returns the board positions of all of the pieces controlled by a given player
             */
             std::vector<Move::position> getPiecesOfPlayer(Piece::Player player);
+
+            /*
+            * Returns the board positions of all of the pieces on the board,
+            * including pieces that no player controls
+            */
+            std::vector<Move::position> getAllPiecePositions();
             
             /*
             * Returns a pointer to the vector containing the player's captured pieces
@@ -239,9 +413,30 @@ namespace logic{
 
             /*
             * Returns the player's current score
+            * - Kept up to date as pieces are captured, so this is O(1)
             */
             double getPlayerScore(Piece::Player player);
 
+            /*
+            * Sets the evaluator that scores the pieces on this board and scores
+            * every piece that is already on the board
+            * - Memory for the evaluator is managed by this class, so it MUST be
+            *   established on the heap via new
+            * - Pass nullptr to stop evaluating the board
+            */
+            void setEvaluator(Evaluator* newEvaluator);
+
+            /*
+            * Returns the evaluator of this board, or nullptr if there is none
+            */
+            Evaluator* getEvaluator();
+
+            /*
+            * Scores every piece on the board again from scratch
+            * - Call this after changing which players control a piece on the board
+            */
+            void refreshEvaluator();
+
             /*
             * Pushes a simulated action type to the simulated action stack
             */
@@ -258,7 +453,8 @@ namespace logic{
             bool revertSimulatedMove();
 
             /*
-            * Undoes all simulated actions
+            * Undoes all simulated actions in the current simulation frame, or 
+            * every simulated action when no frame has begun
             *
             * Returns:
             * - true if all simulated actions are successfully reverted or if there are 
@@ -268,9 +464,25 @@ namespace logic{
             */
             bool revertSimulation();
 
+            /*
+            * Starts a new simulation frame
+            * - Actions simulated until the matching endSimulationFrame() can be
+            *   undone without undoing the actions that were simulated before
+            */
+            void beginSimulationFrame();
+
+            /*
+            * Undoes every action in the current simulation frame and ends it
+            *
+            * Returns:
+            * - true if the actions are successfully reverted
+            * - false if there is no frame or a revert goes wrong
+            */
+            bool endSimulationFrame();
+
             /*
             * Applies the symptomatic effects of all of the actions and 
-            * clears the simulated actions stack
+            * clears the simulated actions stack and every simulation frame
             */
             void applySimulation();
 
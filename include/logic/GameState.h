@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdint>
 
 #include "HashPair.h"
 #include "Piece.h"
@@ -46,9 +47,32 @@ namespace logic {
             int crntPlayerIdx{};
 
             /*
-            * Stores the maximum priority of all of the current player's possible moves
+            * The priorities of a player's moves for the game state they were 
+            * found in
+            * - Reused until the turn, current player, or board changes, so 
+            *   finding the moves of every piece only finds each priority once
             */
-            int crntMaxPriority{};
+            struct PriorityCacheEntry
+            {
+                std::uint64_t positionHash{0};
+                int turn{-1};
+                Player crntPlayer{Player::last};
+                bool hasMaxPriority{false};
+                int maxPriority{0};
+                bool hasMinPriority{false};
+                int minPriority{0};
+            };
+
+            /*
+            * Stores the cached priorities of each player
+            */
+            std::unordered_map<Player, PriorityCacheEntry> priorityCache{};
+
+            /*
+            * Whether the moves currently being generated are pseudo-legal
+            * (see Piece::getPseudoLegalMoves())
+            */
+            bool pseudoLegalGeneration{false};
 
             /*
             * The current turn in the game, incremented whenever a move is made
@@ -60,7 +84,89 @@ namespace logic {
             */
             int minPriority {0};
 
+            /*
+            * The player and turn information from before each simulated move
+            * (see makeSimulatedMove())
+            */
+            struct SimulatedMoveState
+            {
+                Player crntPlayer{};
+                int crntPlayerIdx{};
+                int turn{};
+                int minPriority{};
+                int halfmoveClock{};
+            };
+
+            /*
+            * The simulated moves that have not been unmade yet, from first to last
+            */
+            std::vector<SimulatedMoveState> simulatedMoves{};
+
+            /*
+            * The key of the position at the start of every turn (see 
+            * getPositionKey()), from first to last, and the number of times
+            * each key appears in the history
+            * - Simulated moves are added and removed like any other move, so
+            *   repetitions can be found during searches
+            */
+            std::vector<std::uint64_t> positionHistory{};
+            std::unordered_map<std::uint64_t, int> positionCounts{};
+
+            /*
+            * The number of moves made since the last capture or move that
+            * resets the clock (see resetsHalfmoveClock())
+            */
+            int halfmoveClock{0};
+
+        protected:
+            /*
+            * Returns whether moving the inputted piece resets the halfmove clock
+            * even when nothing is captured
+            * - Captures always reset the clock
+            * - Defaults to false
+            */
+            virtual bool resetsHalfmoveClock(Piece* piece) { return false; }
+
         public:
+            /*
+            * Returns a hash of the state that changes which moves are legal but
+            * is not on the board (ex: En Passant and castling rights in chess)
+            * - Mixed into getPositionKey() and into the keys of the move and
+            *   priority caches, so positions that only differ in this state
+            *   are never mixed up
+            * - Defaults to 0
+            */
+            virtual std::uint64_t getStateKey() { return 0; }
+
+            /*
+            * Returns whether the current player loses when they have no legal
+            * moves (ex: checkmate) instead of drawing (ex: stalemate)
+            * - Used by searches to score positions without moves
+            * - Defaults to false
+            */
+            virtual bool losesWithoutMoves() { return false; }
+
+            /*
+            * The number of moves without a capture or clock reset after which
+            * the game is drawn (50 moves for each of 2 players)
+            */
+            static constexpr int halfmoveLimit = 100;
+
+            /*
+            * A single legal move of a piece from start to end
+            * - idx is the index of the move in the vector returned by 
+            *   getMovesOfPiece(start, end), so it can be passed straight to movePiece()
+            */
+            struct LegalMove
+            {
+                Move::position start{};
+                Move::position end{};
+                int idx{0};
+                int priority{0};
+
+                bool operator==(const LegalMove& other) const = default;
+            };
+
             /*
             * Constructor: Assigns gameBoard to pre-initialized board object and sets 
             * player information
@@ -70,7 +176,7 @@ namespace logic {
             /*
             * Destructor: Frees gameBoard
             */
-            ~GameState();
+            virtual ~GameState();
 
             /*
             * Returns the player idxOffset away from the current player
@@ -83,6 +189,11 @@ namespace logic {
             */
             Player getCrntPlayer();
 
+            /*
+            * Returns the number of players in the game
+            */
+            int getPlayerCount();
+
             /*
             * Sets the current player to the player idxOffset spots away from the current
             * player in allPlayers
@@ -119,6 +230,8 @@ namespace logic {
             /*
             * Get the priority of a given player's possible moves
             * - Returns 0 if the player has no moves
+            * - Cached until the turn, current player, or board changes (see 
+            *   invalidatePriorities())
             */
             int getPriorityOfPlayer(Player player);
 
@@ -128,6 +241,13 @@ namespace logic {
             */
             int getPriority();
 
+            /*
+            * Returns the minimum priority allowed for the current player's moves
+            * on the current turn
+            * - If the player's highest priority is below this, they have no moves
+            */
+            int getPriorityBound();
+
             /*
             * Returns all of the moves a player has that move a piece from start to end
             * - Ex: A pawn on (1, 7) may have multiple moves to (1, 8) for each type of promotion
@@ -145,6 +265,36 @@ namespace logic {
             std::vector<Move> getMovesOfPiece(int startX, int startY, Move::position end);
             std::vector<Move> getMovesOfPiece(Move::position start, Move::position end);
 
+            /*
+            * Returns whether the current player can make a move from start to end
+            * that was returned by Piece::getPseudoLegalMoves()
+            * - Lets searches check each move only when it is about to be made
+            *   instead of checking every move up front
+            * - Defaults to true since moves are only ever filtered while they
+            *   are generated in a generic game
+            */
+            virtual bool isLegal(Move::position start, Move::position end, Move& move) { return true; }
+
+            /*
+            * Returns whether the moves currently being generated are pseudo-legal,
+            * meaning checks that would simulate the move should be skipped
+            * - Set by Piece while it generates moves
+            */
+            bool generatingPseudoLegalMoves();
+            void setPseudoLegalGeneration(bool pseudoLegal);
+
+            /*
+            * Fills legalMoves with every move the inputted player can make, in one 
+            * pass over the player's pieces
+            * - Gives the same moves as calling getMovesOfPiece() for every piece 
+            *   and every end position, but only finds the player's priority once
+            * - legalMoves is cleared first, so reusing the same vector avoids 
+            *   allocating on every call
+            * - If no player is inputted, the current player is used
+            */
+            void generateAllLegalMoves(Player player, std::vector<LegalMove>& legalMoves);
+            void generateAllLegalMoves(std::vector<LegalMove>& legalMoves);
+
             /*
             * Returns true if the inputted player can move a piece from the start position 
             * to the end position and false otherwise
@@ -152,7 +302,8 @@ namespace logic {
             *     - There is a piece at start that is controlled by the current player
             *     - The piece at start has a move in its list of moves that allows 
             *       it to move to end
-            *     - The priority of the move from start to end is equal to crntMaxPriority
+            *     - The priority of the move from start to end is equal to the current
+            *       player's priority (see getPriority())
             * - If no player is inputted, the current player is used
             */
             bool canMovePiece(int startX, int startY, int endX, int endY);
@@ -193,6 +344,49 @@ namespace logic {
             bool movePiece(int startX, int startY, Move::position end, int idx = 0);
             bool movePiece(Move::position start, Move::position end, int idx = 0);
 
+            /*
+            * Calls the actions of a move from start to end in the board's current
+            * simulation frame without applying them or changing the player
+            * - The caller owns the simulation frame and must revert it, even if 
+            *   this fails
+            *
+            * Returns:
+            * - true if every action of the move was called successfully
+            * - false if an action failed
+            */
+            bool simulateMove(Move::position start, Move::position end, Move& move);
+
+            /*
+            * Makes a move in a new simulation frame and passes the turn to the 
+            * next player, so searches can play moves without applying them
+            * - The move should come from Piece::getPseudoLegalMoves() or 
+            *   getMovesOfPiece(), and pseudo-legal moves should be checked with
+            *   isLegal() first
+            * - Symptomatic effects are never applied, so moves made this way 
+            *   are never captured or marked as moved
+            * - Do not call movePiece() until every simulated move is unmade
+            *
+            * Returns:
+            * - true if the move was made
+            * - false if an action of the move failed, in which case nothing changes
+            */
+            bool makeSimulatedMove(Move::position start, Move::position end, Move& move);
+
+            /*
+            * Unmakes the most recent simulated move and gives the turn back to 
+            * the player who made it
+            *
+            * Returns:
+            * - true if a move was unmade
+            * - false if there are no simulated moves to unmake
+            */
+            bool unmakeSimulatedMove();
+
+            /*
+            * Returns the number of simulated moves that have not been unmade
+            */
+            int getSimulatedMoveCount();
+
             /*
             * Returns whether or not the inputted player has at least one valid move
             * - Defaults to the current player when no player is provided
@@ -237,12 +431,79 @@ namespace logic {
             int getTurn();
 
             /*
-             * Increments the turn count and updates the minimum priority for the current turn
+            * Jumps to the inputted turn, making the player whose move it is on
+            * that turn the current player (ex: when loading a position)
+            * - Turn 1 is the first player's first move
+            * - The position history restarts at the current position
+            * 
+            * Returns:
+            * - True if the turn is set
+            * - False if the turn is below 1, there are 0 players, or a move is
+            *   being simulated, in which case nothing is changed
+            */
+            bool setTurn(int turn);
+
+            /*
+            * Returns a hash of the board, the current player, and getStateKey(),
+            * which is the same whenever the same player is to move in the same 
+            * position with the same rights
+            */
+            std::uint64_t getPositionKey();
+
+            /*
+            * Returns the number of times the current position has been reached
+            * with the current player to move, including now, in O(1) time
+            */
+            int getRepetitionCount();
+
+            /*
+            * Replaces the position history with the history of the inputted
+            * game state, so a copy of its position made another way (ex: from
+            * a FEN) finds the same repetitions
+            * - Returns false if either game state is simulating a move or the
+            *   current positions differ, in which case nothing is changed
+            */
+            bool copyPositionHistory(GameState& other);
+
+            /*
+            * Returns the number of moves made since the last capture or clock
+            * reset (see resetsHalfmoveClock())
+            */
+            int getHalfmoveClock();
+
+            /*
+            * Sets the halfmove clock (ex: when loading a position)
+            */
+            void setHalfmoveClock(int clock);
+
+            /*
+            * Returns whether the current position has been reached 3 times
+            */
+            bool isDrawByRepetition();
+
+            /*
+            * Returns whether halfmoveLimit moves have been made without a capture
+            * or clock reset
+            */
+            bool isDrawByHalfmoveClock();
+
+            /*
+             * Increments the turn count, updates the minimum priority for the current turn,
+             * and adds the new position to the position history
              * - Note: The function is called automatically by setNextPlayer()
              *         so you will not need to call this in regular circumstances
             */
             void nextTurn();
 
+            /*
+            * Forgets every cached priority and updates the minimum priority for
+            * the current turn
+            * - Priorities are cached by the turn, current player, and board 
+            *   position, so call this after changing anything else that moves
+            *   depend on in the middle of a turn (ex: which players control a piece)
+            */
+            void invalidatePriorities();
+
             /*
             * Applies the action and adds it to the simulation
             *
@@ -263,11 +524,50 @@ namespace logic {
             bool callActions(std::vector<std::shared_ptr<Action>>& actions, Move::position targetPosition);
 
         private:
+            /*
+            * Returns the cached priorities of the inputted player, clearing them 
+            * first if they were found for a different game state
+            * - Returns nullptr while moves are being generated since cached 
+            *   priorities would hide what the moves depend on
+            */
+            PriorityCacheEntry* getPriorityCacheEntry(Player player);
+
+            /*
+            * Returns the lowest priority a move of the inputted piece can have 
+            * for the inputted player to make it, or -1 if the player cannot 
+            * move the piece at all
+            */
+            int getMovePriorityBound(Player player, Piece* piece);
+
             /* 
             * Returns the minimum priority of all moves for the inputted player
             */
             int getMinPriority(Player player);
 
+            /*
+            * Returns the number of pieces controlled by the current player's
+            * opponents
+            */
+            int getOpponentPieceCount();
+
+            /*
+            * Updates the halfmove clock after a move by the inputted piece 
+            * - opponentPiecesBefore is getOpponentPieceCount() before the move,
+            *   so captures are found for any game
+            * - Must be called before the next player is set
+            */
+            void updateHalfmoveClock(Piece* piece, int opponentPiecesBefore);
+
+            /*
+            * Adds the current position to the position history
+            */
+            void recordPosition();
+
+            /*
+            * Removes the most recent position from the position history
+            */
+            void forgetPosition();
+
             /* 
             * Updates the minimum priority based on current player
             * - Note: Called automatically in most circumstances, but make sure
@@ -0,0 +1,80 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace logic {
+    class MappedFile
+    {
+        /*
+        * A read-only file mapped into memory, so large files can be read
+        * without copying them
+        * - Uses mmap() on POSIX systems and file mappings on Windows
+        * - The data stays valid until the file is closed or the object is
+        *   destroyed
+        */
+        private:
+            const unsigned char* data{nullptr};
+            std::size_t size{0};
+            bool opened{false};
+
+            /*
+            * The platform's handles for the open file
+            */
+#ifdef _WIN32
+            void* file{nullptr};
+            void* mapping{nullptr};
+#else
+            int descriptor{-1};
+#endif
+
+        public:
+            /*
+            * How the file will be read, passed to the OS so it can read ahead
+            * (or not) to match
+            */
+            enum class Access
+            {
+                sequential,
+                random
+            };
+
+            MappedFile() = default;
+
+            /*
+            * Destructor: Closes the file
+            */
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            /*
+            * Maps the file at the inputted path, closing any file that is
+            * already open
+            * - Returns false if the file cannot be opened or mapped
+            * - Empty files open successfully with no data
+            * - Files that are searched (ex: an opening book) should be opened
+            *   with Access::random so the OS doesn't read ahead for nothing
+            */
+            bool open(const std::string& path, Access access = Access::sequential);
+
+            /*
+            * Unmaps and closes the file if one is open
+            */
+            void close();
+
+            /*
+            * Returns whether a file is open
+            */
+            bool isOpen();
+
+            /*
+            * Returns the file's contents and their size in bytes
+            */
+            const unsigned char* getData();
+            std::size_t getSize();
+    };
+}
+#endif
@@ -26,6 +26,11 @@ namespace logic {
             */
             using position = std::pair<int, int>;
 
+            /*
+            * The priority of regular moves, which no move can be below
+            */
+            static constexpr int lowestPriority = 1;
+
         private:
             /*
             * The positions this move allows
@@ -56,9 +61,9 @@ namespace logic {
             * Constructor: Initialize priority and onMove() callback function
             */
             Move(int movePriority = 1, std::vector<std::shared_ptr<Action>> preMoveActions = {}, std::vector<std::shared_ptr<Action>> postMoveActions = {}) : 
-                priority{std::max(movePriority, 1)}, preMoveActions{preMoveActions}, postMoveActions{postMoveActions}{}
+                priority{std::max(movePriority, lowestPriority)}, preMoveActions{preMoveActions}, postMoveActions{postMoveActions}{}
             Move(std::vector<position> newPositions, int movePriority = 1, std::vector<std::shared_ptr<Action>> preMoveActions = {}, std::vector<std::shared_ptr<Action>> postMoveActions = {}) : 
-                positions{newPositions}, priority{std::max(movePriority, 1)}, preMoveActions{preMoveActions}, postMoveActions{postMoveActions}{}
+                positions{newPositions}, priority{std::max(movePriority, lowestPriority)}, preMoveActions{preMoveActions}, postMoveActions{postMoveActions}{}
 
             /*
             * Allow printing of moves for debugging
@@ -0,0 +1,169 @@
+#ifndef PERSISTENTBOARD_H
+#define PERSISTENTBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "GameBoard.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+    class PersistentBoard
+    {
+        /*
+        * An immutable board where every change makes a new board that shares
+        * everything it did not change with the board it came from
+        * - Pieces are kept in a balanced search tree ordered by position, and
+        *   a change only copies the O(log n) nodes on the path to the changed
+        *   position, so keeping many boards that each differ by a move costs
+        *   memory for the moves rather than for the boards
+        * - Nodes are never changed once made, so boards can be copied and
+        *   read from any number of threads at once
+        * - Only the piece type, its players, and whether it moved are kept,
+        *   so state that pieces keep themselves (ex: En Passant) is lost when
+        *   converting to and from a GameBoard
+        * - Changes are rule-free edits (see movePiece()), boards made from a
+        *   game should be taken with fromBoard() after each move is played
+        */
+        public:
+            /*
+            * A piece on the board
+            */
+            struct PieceInfo
+            {
+                Move::position position{};
+                Piece::ID id{0};
+                std::uint32_t playerMask{0};
+                bool moved{false};
+
+                bool operator==(const PieceInfo& other) const = default;
+            };
+
+            /*
+            * Makes a piece of the inputted type at the inputted position, or
+            * returns nullptr if there is no such type
+            * - The players and moved flag are set afterwards (see toBoard())
+            */
+            using PieceFactory = std::function<Piece*(Piece::ID id, Move::position position)>;
+
+        private:
+            /*
+            * A node of a treap, where priorities come from the position so the
+            * shape of the tree only depends on which positions are occupied
+            */
+            struct Node
+            {
+                PieceInfo piece{};
+                std::uint64_t priority{0};
+                std::shared_ptr<const Node> left{};
+                std::shared_ptr<const Node> right{};
+            };
+            using NodePtr = std::shared_ptr<const Node>;
+
+            NodePtr root{};
+            std::size_t pieceCount{0};
+
+            PersistentBoard(NodePtr root, std::size_t pieceCount);
+
+            static std::uint64_t getPriority(Move::position position);
+
+            /*
+            * Returns a copy of node with new children
+            */
+            static NodePtr copyNode(const NodePtr& node, NodePtr left, NodePtr right);
+
+            /*
+            * Returns the tree with the inputted piece added or replacing the
+            * piece at its position
+            */
+            static NodePtr insert(const NodePtr& node, const PieceInfo& piece, std::uint64_t priority);
+
+            /*
+            * Returns the tree without the piece at the inputted position, which
+            * must be in the tree
+            */
+            static NodePtr erase(const NodePtr& node, Move::position position);
+
+            /*
+            * Joins two trees where every position in left comes before every
+            * position in right
+            */
+            static NodePtr merge(const NodePtr& left, const NodePtr& right);
+
+            static void collect(const NodePtr& node, std::vector<PieceInfo>& pieces);
+
+        public:
+            /*
+            * Constructor: An empty board
+            */
+            PersistentBoard();
+
+            /*
+            * Copies the pieces that are on the inputted board
+            * - Must not be called while a move is simulated
+            */
+            static PersistentBoard fromBoard(GameBoard& board);
+
+            /*
+            * Adds a copy of every piece to the inputted board, using the factory
+            * to make each piece
+            * - Returns false if the factory does not know a piece or a space is
+            *   already occupied, in which case the pieces added before the
+            *   failure stay on the board
+            */
+            bool toBoard(GameBoard& board, const PieceFactory& factory) const;
+
+            /*
+            * Returns the piece at the inputted position, or nullptr if there is
+            * none
+            */
+            const PieceInfo* getPiece(Move::position position) const;
+
+            /*
+            * Returns the pieces on the board, sorted by position
+            */
+            std::vector<PieceInfo> getPieces() const;
+
+            std::size_t getPieceCount() const;
+
+            /*
+            * Returns a board with the inputted piece added at its position,
+            * replacing any piece that was there
+            */
+            PersistentBoard setPiece(const PieceInfo& piece) const;
+
+            /*
+            * Returns a board without the piece at the inputted position
+            */
+            PersistentBoard removePiece(Move::position position) const;
+
+            /*
+            * Returns a board where the piece at start moved to end, capturing
+            * any piece at end and marking the moved piece as moved
+            * - Returns an unchanged board if there is no piece at start or
+            *   start is end
+            * - This is a plain edit that knows nothing about the game's rules,
+            *   so castling, En Passant, promotion, and other moves with extra
+            *   actions are not followed. To keep a line of a real game, play
+            *   each move with GameState::movePiece() and snapshot the result
+            *   with fromBoard()
+            */
+            PersistentBoard movePiece(Move::position start, Move::position end) const;
+
+            /*
+            * Returns whether both boards have the same pieces
+            */
+            bool operator==(const PersistentBoard& other) const;
+
+            /*
+            * Returns the number of different nodes used by all of the inputted
+            * boards together, to measure how much they share
+            */
+            static std::size_t countNodes(const std::vector<PersistentBoard>& boards);
+    };
+}
+#endif
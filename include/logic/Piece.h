@@ -3,8 +3,11 @@
 
 #include <string>
 #include <unordered_map>
+#include <cstdint>
 
 #include "Move.h"
+#include "Dependencies.h"
+#include "DestinationIndex.h"
 
 namespace logic {
     class GameState;
@@ -28,6 +31,68 @@ namespace logic {
                 last // Here for iteration, do not use as a player!!
             };
         
+            /*
+            * Identifies the game state that a cached list of moves was generated for
+            * - Simulated positions are cached by the exact position (including
+            *   GameState::getStateKey()), turn, and current player so revisiting
+            *   a simulated position reuses its moves
+            */
+            struct MoveCacheKey
+            {
+                std::uint64_t positionHash{0};
+                int turn{-1};
+                Player player{Player::last};
+
+                bool operator==(const MoveCacheKey& other) const = default;
+            };
+
+            struct MoveCacheKeyHash
+            {
+                std::size_t operator()(const MoveCacheKey& key) const;
+            };
+
+            /*
+            * The maximum number of simulated game states cached for each piece
+            * - Entries from previous turns are dropped once a cache is full
+            */
+            static constexpr std::size_t simulatedCacheCapacity = 64;
+
+            /*
+            * A cached list of moves
+            * - The moves can be reused in any game state with the same current
+            *   player where the dependencies hold, even after other pieces moved
+            */
+            struct MoveCacheEntry
+            {
+                std::vector<Move> moves{};
+
+                /*
+                * The lowest and highest priorities in moves (both 0 when there
+                * are no moves)
+                */
+                int minPriority{0};
+                int maxPriority{0};
+
+                /*
+                * The moves with at least filteredPriority priority
+                * - Only built when some moves are below the priority being 
+                *   filtered for, and reused until the priority changes
+                */
+                std::vector<Move> filteredMoves{};
+                int filteredPriority{-1};
+
+                /*
+                * The moves that contain each position
+                * - Only built once a position is looked up (see getDestinations())
+                */
+                DestinationIndex destinations{};
+                bool destinationsBuilt{false};
+
+                MoveCacheKey key{};
+                Dependencies dependencies{};
+                bool valid{false};
+            };
+
         private:
             /*
             * The current position of the piece
@@ -46,6 +111,12 @@ namespace logic {
             */
             std::unordered_map<Player, bool> players{};
 
+            /*
+            * The players in players that can move this piece as a bit mask
+            * (see getPlayerMask())
+            */
+            std::uint32_t playerMask{0};
+
             /*
             * Stores whether or not the piece is currently on a board
             * 
@@ -55,36 +126,48 @@ namespace logic {
             bool onBoard{ false };
 
             /* 
-            * A cache that stores all of the possible moves for this turn 
+            * A cache that stores all of the possible moves for the most recent
+            * non-simulated game state where they were generated
+            * - Used whenever its dependencies still hold, including during 
+            *   simulations, so moves are only generated again when a position
+            *   they depend on changes
             */
-            std::vector<Move> moveCache{};
-
-            /* 
-            * The most recent turn when the move cache was updated
-            */
-            int moveCacheUpdateTurn{-1};
+            MoveCacheEntry moveCache{};
 
             /*
-            * During a simulation, use this cache instead of the regular cache
+            * During a simulation, use this cache when the regular cache cannot be used
             * so the regular cache can still be used later
+            * - Keyed by the simulated game state, so returning to a simulated
+            *   position reuses the moves generated for it
             */
-            std::vector<Move> simulatedMoveCache{};
+            std::unordered_map<MoveCacheKey, MoveCacheEntry, MoveCacheKeyHash> simulatedMoveCache{};
 
             /* 
-            * A cache that stores all of the possible attacking moves for this turn
+            * A cache that stores all of the possible attacking moves for the most
+            * recent non-simulated game state where they were generated
             */
-            std::vector<Move> attackMoveCache{};
+            MoveCacheEntry attackMoveCache{};
+
+            /*
+            * During a simulation, use this cache when the regular cache cannot be used
+            * so the regular cache can still be used later
+            */
+            std::unordered_map<MoveCacheKey, MoveCacheEntry, MoveCacheKeyHash> simulatedAttackMoveCache{};
 
             /* 
-             * The most recent turn when the attack move cache was updated
+            * Caches that store the pseudo-legal moves (see getPseudoLegalMoves())
+            * in the same way as the caches above
             */
-            int attackMoveCacheUpdateTurn{-1};
+            MoveCacheEntry pseudoLegalMoveCache{};
+            std::unordered_map<MoveCacheKey, MoveCacheEntry, MoveCacheKeyHash> simulatedPseudoLegalMoveCache{};
 
             /*
-            * During a simulation, use this cache instead of the regular cache
-            * so the regular cache can still be used later
+            * Holds newly generated simulated moves when the simulated caches are 
+            * full of entries from the current turn
             */
-            std::vector<Move> simulatedAttackMoveCache{};
+            MoveCacheEntry overflowMoveCache{};
+            MoveCacheEntry overflowAttackMoveCache{};
+            MoveCacheEntry overflowPseudoLegalMoveCache{};
 
             /*
             * Whether this piece has been moved from its starting location
@@ -115,6 +198,11 @@ namespace logic {
             */
             const std::unordered_map<Player, bool>& getAllPlayersAccess();
 
+            /*
+            * Returns a mask where bit i is set when Player i can move this piece
+            */
+            std::uint32_t getPlayerMask();
+
             /*
             * Adds a player to the piece, meaning that player can now control the piece
             */
@@ -189,6 +277,33 @@ namespace logic {
             // Default initialization for testing only
             virtual std::vector<Move> generateAttackingMoves(GameState& gameState) { return {}; }
 
+            /*
+            * The lists of moves that are cached separately
+            */
+            enum class MoveList
+            {
+                moves = 0,
+                attackingMoves,
+                pseudoLegalMoves
+            };
+
+            /*
+            * Returns the cached moves (or attacking or pseudo-legal moves) for the
+            * current game state, generating them first if they are not cached
+            */
+            MoveCacheEntry& getCachedMoves(GameState& gameState, MoveList list);
+
+            /*
+            * Returns the index of the positions in a cache entry's moves, building
+            * it first if needed
+            */
+            DestinationIndex& getDestinations(MoveCacheEntry& entry);
+
+            /*
+            * Returns whether a cache entry can be used for the inputted game state
+            */
+            bool cacheEntryValid(MoveCacheEntry& entry, GameState& gameState, MoveCacheKey& key);
+
         public:
             /*
              * Returns the ID of the piece
@@ -201,6 +316,11 @@ namespace logic {
             * to the move cache which contains the current possible moves
             * - Priority will be considered only when the current player controls
             *   the piece and ignorePriority is not enabled
+            * - Moves are cached for each position, so this only generates moves
+            *   when the board, turn, or current player has changed, even while
+            *   simulating
+            * - Nothing is copied unless some of the moves are filtered out by
+            *   priority, and the filtered moves are cached alongside the moves
             */
             std::vector<Move>& getMoves(GameState& gameState, bool ignorePriority = false);
 
@@ -208,13 +328,60 @@ namespace logic {
             * Updates the attack moves cache if neccessary and then returns a 
             * reference to the attack move cache which contains the current
             * possible attack moves
-            * - Priority will be considered only when the current player controls
-            *   the piece and ignorePriority is not enabled
+            * - Attacking moves are never filtered by priority, since a piece
+            *   attacks a position whether or not its move there is forced
             */
-            std::vector<Move>& getAttackingMoves(GameState& gameState, bool ignorePriority = false);
+            std::vector<Move>& getAttackingMoves(GameState& gameState);
+
+            /*
+            * Updates the pseudo-legal move cache if necessary and then returns a
+            * reference to it
+            * - Pseudo-legal moves are generated without the checks that would
+            *   simulate each move (ex: whether a Chess move leaves its king in
+            *   check), so they can contain moves that cannot be made. Check each
+            *   move with GameState::isLegal() before making it.
+            * - Priority is never considered since the priorities of the legal 
+            *   moves are not known
+            * - Pieces without any such checks return the same moves as getMoves()
+            */
+            std::vector<Move>& getPseudoLegalMoves(GameState& gameState);
             
+            /*
+            * Returns whether any of this piece's moves with at least minPriority
+            * priority contains the end position
+            * - Uses the moves from getMoves(gameState, true), so pass the priority
+            *   to filter by
+            * - O(1) whenever the moves are cached
+            */
+            bool canReach(GameState& gameState, Move::position end, int minPriority = 0);
+
+            /*
+            * Adds every move with at least minPriority priority that contains the 
+            * end position to movesTo
+            * - Moves are added in the same order as getMoves(gameState, true)
+            */
+            void getMovesTo(GameState& gameState, Move::position end, int minPriority, std::vector<Move>& movesTo);
+
+            /*
+            * Returns whether this piece's moves can change from one turn to the 
+            * next even if the board does not change
+            * - When false, cached moves are reused across turns for as long as
+            *   the positions they depend on do not change. Pieces that only read
+            *   the turn in some positions can return false and call 
+            *   GameBoard::recordTurnDependency() when they do.
+            * - Defaults to true so new pieces are always safe to cache
+            */
+            virtual bool movesDependOnTurn() { return true; }
+
+            /*
+            * Forgets every cached move so the next query generates moves again
+            */
+            void clearMoveCache();
+
             /*
             * Returns the maximum priority of all of the moves generated by GenerateMoves()
+            * - Stored with the cached moves, so this is O(1) whenever the moves 
+            *   are cached
             */
             int getMaxPriorityOfMoves(GameState& gameState);
 
@@ -0,0 +1,148 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <functional>
+#include <cstdint>
+
+#include "Move.h"
+#include "Piece.h"
+#include "GameState.h"
+
+namespace logic {
+    class Search
+    {
+        /*
+        * An alpha-beta search over a game state
+        * - Moves are made with GameState::makeSimulatedMove(), so the game
+        *   state is back where it started whenever a search returns
+        * - Once the depth runs out, a quiescence search keeps playing tactical
+        *   moves (forced moves, captures, promotions, and knight boosts, see
+        *   StagedMoveGenerator) until the position is quiet, so the result is
+        *   not thrown off by a capture at the last move
+        * - Scores are from the point of view of the player to move
+        * - Positions drawn by repetition or by the halfmove clock score 0
+        * - Positions without moves score 0, or lose by mateScore minus the 
+        *   number of moves made to reach them if GameState::losesWithoutMoves()
+        *   (ex: checkmate), so faster wins score higher
+        */
+        public:
+            /*
+            * Scores a position from the point of view of the current player
+            * - Never called for positions where the current player has no moves,
+            *   which the search scores itself
+            */
+            using Evaluation = std::function<double(GameState&)>;
+
+            /*
+            * The best move found by a search and its score
+            * - found is false if the current player had no moves
+            */
+            struct Result
+            {
+                GameState::LegalMove move{};
+                double score{0.0};
+                bool found{false};
+            };
+
+            /*
+            * The most tactical moves in a row that a quiescence search plays
+            */
+            static constexpr int maxQuiescencePly = 16;
+
+            /*
+            * The score of winning right away, which is far above any evaluation
+            */
+            static constexpr double mateScore = 1000000.0;
+
+        private:
+            GameState& gameState;
+
+            Evaluation evaluate;
+
+            /*
+            * The number of positions visited by each part of the search since
+            * the counts were last reset
+            */
+            std::uint64_t nodes{0};
+            std::uint64_t quiescenceNodes{0};
+
+            /*
+            * Returns whether a position reached during the search is drawn by
+            * repetition or by the halfmove clock
+            */
+            bool isDraw();
+
+            /*
+            * Returns the score of a position where the current player has no
+            * legal moves
+            */
+            double scoreWithoutMoves();
+
+        public:
+            /*
+            * Constructor: Searches the inputted game state using the inputted
+            * evaluation (see boardEvaluation())
+            */
+            Search(GameState& gameState, Evaluation evaluate = boardEvaluation);
+
+            /*
+            * Returns the score of the board's evaluator for the current player in
+            * O(1) time (see GameBoard::setEvaluator())
+            * - Uses materialEvaluation() if the board has no evaluator
+            */
+            static double boardEvaluation(GameState& gameState);
+
+            /*
+            * Returns the current player's material minus the material of every
+            * other player, using Piece::getValue()
+            * - Visits every piece, so prefer boardEvaluation()
+            */
+            static double materialEvaluation(GameState& gameState);
+
+            /*
+            * Searches every move of the current player to the inputted depth and
+            * returns the best one
+            * - The move can be passed straight to GameState::movePiece()
+            * - Searches at least 1 move deep
+            */
+            Result findBestMove(int depth);
+
+            /*
+            * Returns the score of the current position searched to the inputted
+            * depth, followed by a quiescence search
+            * - Scores of at least beta or at most alpha are only bounds
+            */
+            double alphaBeta(int depth, double alpha, double beta);
+
+            /*
+            * Returns the score of the current position after playing tactical
+            * moves until the position is quiet
+            * - The current player may stop instead of making a tactical move
+            *   ("stand pat"), unless a forced move must be made
+            * - ply is the number of tactical moves already played in a row
+            */
+            double quiescence(double alpha, double beta, int ply = 0);
+
+            /*
+            * Returns the number of sequences of legal moves with the inputted
+            * length from the current position ("perft")
+            * - Used to check move generation against known counts
+            * - Does not stop at drawn positions and does not change the node
+            *   counts
+            */
+            std::uint64_t perft(int depth);
+
+            /*
+            * Returns the number of positions visited by alphaBeta() and by
+            * quiescence() since the counts were last reset
+            */
+            std::uint64_t getNodeCount();
+            std::uint64_t getQuiescenceNodeCount();
+
+            /*
+            * Sets both node counts to 0
+            */
+            void resetNodeCounts();
+    };
+}
+#endif
@@ -0,0 +1,151 @@
+#ifndef SHAREDGAMESTATE_H
+#define SHAREDGAMESTATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+    class GameSnapshot
+    {
+        /*
+        * An immutable copy of what is usually asked about a position: its
+        * pieces, the legal moves of the current player, and the spaces each
+        * player attacks
+        * - Queries on a GameState fill caches, so they cannot run on several
+        *   threads at once. Every query here is const and only reads the
+        *   snapshot, so any number of threads can share one
+        * - Taking a snapshot queries the game state, so it must be done by
+        *   the thread that owns the game state
+        */
+        public:
+            /*
+            * A piece on the board
+            */
+            struct PieceInfo
+            {
+                Move::position position{};
+                Piece::ID id{0};
+                std::uint32_t playerMask{0};
+                bool moved{false};
+            };
+
+        private:
+            int turn{0};
+            Piece::Player crntPlayer{Piece::Player::white};
+            std::uint64_t positionKey{0};
+
+            /*
+            * Sorted by start, end, then index, so they can be searched
+            */
+            std::vector<GameState::LegalMove> legalMoves{};
+
+            /*
+            * Sorted by position
+            */
+            std::vector<PieceInfo> pieces{};
+
+            /*
+            * The sorted spaces attacked by each player
+            */
+            std::vector<std::pair<Piece::Player, std::vector<Move::position>>> attackedSpaces{};
+
+        public:
+            /*
+            * Constructor: Copies the current position of the inputted game state
+            * - Must not be called while a move is simulated
+            */
+            GameSnapshot(GameState& gameState);
+
+            int getTurn() const;
+            Piece::Player getCrntPlayer() const;
+
+            /*
+            * Returns GameState::getPositionKey() of the position
+            */
+            std::uint64_t getPositionKey() const;
+
+            /*
+            * Returns the legal moves of the current player, in the same form as
+            * GameState::generateAllLegalMoves()
+            */
+            const std::vector<GameState::LegalMove>& getLegalMoves() const;
+
+            /*
+            * Returns whether the current player can move the piece at start to
+            * end with the inputted move index
+            */
+            bool isLegal(Move::position start, Move::position end, int idx = 0) const;
+
+            /*
+            * Returns the pieces on the board, sorted by position
+            */
+            const std::vector<PieceInfo>& getPieces() const;
+
+            /*
+            * Returns the piece at the inputted position, or nullptr if there is
+            * none
+            */
+            const PieceInfo* getPiece(Move::position position) const;
+
+            /*
+            * Returns the sorted spaces that the pieces of the inputted player
+            * attack (see GameState::getSpacesAttackedByPlayer())
+            */
+            const std::vector<Move::position>& getSpacesAttackedByPlayer(Piece::Player player) const;
+
+            /*
+            * Returns whether the inputted position is attacked by any player
+            * besides the inputted player (see GameState::isAttacked())
+            */
+            bool isAttacked(Piece::Player player, Move::position position) const;
+    };
+
+    class SharedGameState
+    {
+        /*
+        * Lets one thread move pieces in a game state while any number of
+        * other threads read its latest snapshot (see GameSnapshot)
+        * - A new snapshot is published after every move, and readers keep
+        *   the snapshot they hold until they ask for a new one
+        * - Only moves made through this class are safe while readers are
+        *   running, and other changes must be followed by publish()
+        */
+        private:
+            GameState& gameState;
+            std::mutex writeMutex{};
+            std::atomic<std::shared_ptr<const GameSnapshot>> snapshot{};
+
+        public:
+            /*
+            * Constructor: Shares the inputted game state, which must outlive
+            * this object, and publishes its current position
+            */
+            SharedGameState(GameState& gameState);
+
+            /*
+            * Returns the latest snapshot
+            * - Safe to call from any thread
+            */
+            std::shared_ptr<const GameSnapshot> getSnapshot() const;
+
+            /*
+            * Moves a piece (see GameState::movePiece()) and publishes the new
+            * position if the move was made
+            */
+            bool movePiece(Move::position start, Move::position end, int idx = 0);
+
+            /*
+            * Publishes the current position of the game state
+            */
+            void publish();
+    };
+}
+#endif
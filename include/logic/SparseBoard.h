@@ -0,0 +1,212 @@
+#ifndef SPARSEBOARD_H
+#define SPARSEBOARD_H
+
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <array>
+
+#include "HashPair.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+    class SparseBoard
+    {
+        /*
+        * The storage behind GameBoard that maps positions to pieces
+        * - The board is split into square tiles that are only allocated once a
+        *   piece enters them, so boards with pieces thousands of spaces apart
+        *   only pay for the tiles that are actually used
+        * - Each tile keeps an occupancy mask with one bit per position, which
+        *   lets ray walks skip over empty tiles in a single step
+        * - Every row, column, and diagonal also keeps a sorted list of its
+        *   occupied coordinates, so straight rays can jump directly to their
+        *   first blocker in O(log n) time
+        */
+        public:
+            /*
+            * The number of bits used for each coordinate inside of a tile
+            * - Tiles are tileSize x tileSize, and tileSize * tileSize must fit
+            *   in the occupancy mask
+            */
+            static constexpr int tileBits = 3;
+            static constexpr int tileSize = 1 << tileBits;
+
+        private:
+            /*
+            * A single tileSize x tileSize section of the board
+            */
+            struct Tile
+            {
+                /*
+                * Bit i is set when squares[i] contains a piece
+                */
+                std::uint64_t occupancy{0};
+
+                /*
+                * The pieces in the tile, indexed by localIndex()
+                */
+                Piece* squares[tileSize * tileSize]{};
+            };
+
+            /*
+            * The sorted coordinates of the occupied positions on each line of a 
+            * single family of lines (rows, columns, diagonals, or anti-diagonals)
+            */
+            struct LineIndex
+            {
+                /*
+                * Maps a line's key to the sorted coordinates of its pieces
+                */
+                std::unordered_map<std::int64_t, std::vector<int>> lines{};
+
+                /*
+                * Adds or removes a coordinate from a line
+                */
+                void insert(std::int64_t key, int coord);
+                void erase(std::int64_t key, int coord);
+
+                /*
+                * Returns the distance from coord to the closest occupied coordinate
+                * on the line in the direction of sign (1 or -1), or -1 if there is none
+                */
+                long long distanceToNext(std::int64_t key, int coord, int sign) const;
+            };
+
+            /*
+            * Line indices for rows (key y, coordinate x), columns (key x, 
+            * coordinate y), diagonals (key x - y, coordinate x), and 
+            * anti-diagonals (key x + y, coordinate x)
+            */
+            LineIndex rows{};
+            LineIndex columns{};
+            LineIndex diagonals{};
+            LineIndex antiDiagonals{};
+
+            /*
+            * All of the tiles that have been used so far, keyed by tile coordinates
+            * - Tiles are never freed while the board is alive because simulations
+            *   constantly move pieces in and out of the same tiles
+            */
+            std::unordered_map<Move::position, std::unique_ptr<Tile>, hash_tuple::int_pair_hash> tiles{};
+
+            /*
+            * The number of occupied positions on the board
+            */
+            int pieceCount{0};
+
+            /*
+            * The XOR of pieceKey() for every piece on the board
+            */
+            std::uint64_t positionHash{0};
+
+            /*
+            * The XOR of pieceKey() for every piece on the board controlled by
+            * each player, indexed by Player
+            */
+            std::array<std::uint64_t, static_cast<int>(Piece::Player::last)> rosterHashes{};
+
+            /*
+            * The number of pieces on the board controlled by each player,
+            * indexed by Player
+            */
+            std::array<int, static_cast<int>(Piece::Player::last)> rosterSizes{};
+
+            /*
+            * Returns the coordinates of the tile containing the position
+            */
+            static Move::position tileOf(Move::position position);
+
+            /*
+            * Returns the index of the position inside of its tile
+            */
+            static int localIndex(Move::position position);
+
+            /*
+            * Returns the tile containing the position or nullptr if that tile
+            * has never been used
+            */
+            const Tile* findTile(Move::position position) const;
+
+            /*
+            * Adds or removes (XOR) a piece on a position from the position hash
+            * and the hashes of the players that control it
+            */
+            void updateHashes(Piece* piece, Move::position position);
+
+            /*
+            * Adds change to the roster sizes of the players that control a piece
+            */
+            void updateRosterSizes(Piece* piece, int change);
+
+        public:
+            /*
+            * Returns the piece at the position or nullptr if the position is empty
+            * - Unlike unordered_map::operator[], this never inserts anything
+            */
+            Piece* get(Move::position position) const;
+
+            /*
+            * Returns true if there is a piece at the position
+            */
+            bool occupied(Move::position position) const;
+
+            /*
+            * Places a piece at the position, replacing anything that was there
+            * - Setting a position to nullptr clears it
+            */
+            void set(Move::position position, Piece* piece);
+
+            /*
+            * Returns the number of occupied positions
+            */
+            int size() const;
+
+            /*
+            * Returns the number of tiles that have been allocated
+            */
+            int tileCount() const;
+
+            /*
+            * Returns a hash of every piece and its position on the board
+            * - Updated incrementally in set(), so this is O(1)
+            * - Two boards with the same pieces (by ID and controlling players)
+            *   on the same positions always have the same hash
+            */
+            std::uint64_t hash() const;
+
+            /*
+            * Returns a hash of the pieces controlled by a player and their positions
+            * - Updated incrementally in set(), so this is O(1)
+            */
+            std::uint64_t rosterHash(Piece::Player player) const;
+
+            /*
+            * Returns the number of pieces controlled by a player
+            * - Updated incrementally in set(), so this is O(1)
+            */
+            int rosterSize(Piece::Player player) const;
+
+            /*
+            * Returns the contribution of a piece on a position to hash()
+            * - Note: The key uses the players that control the piece when it 
+            *   is placed, so a piece's players should not change while it is
+            *   on the board
+            */
+            static std::uint64_t pieceKey(Piece* piece, Move::position position);
+
+            /*
+            * Walks from start (exclusive) in steps of direction and returns the
+            * number of steps taken to reach the first occupied position
+            * - Horizontal, vertical, and diagonal unit directions use the line 
+            *   indices and take O(log n) time regardless of distance
+            * - Other directions skip empty or unallocated tiles in a single step
+            * - Returns -1 if no occupied position is found within maxSteps steps
+            *   or if direction is (0, 0)
+            */
+            int findNextOccupied(Move::position start, Move::position direction, int maxSteps) const;
+    };
+}
+#endif
@@ -0,0 +1,178 @@
+#ifndef STAGEDMOVEGENERATOR_H
+#define STAGEDMOVEGENERATOR_H
+
+#include <vector>
+#include <cstddef>
+
+#include "Move.h"
+#include "Piece.h"
+#include "GameState.h"
+
+namespace logic {
+    class StagedMoveGenerator
+    {
+        /*
+        * Hands out the current player's legal moves one at a time in the order a
+        * search wants to try them
+        * - Moves come from Piece::getPseudoLegalMoves() and are only checked
+        *   with GameState::isLegal() right before they are handed out, so a
+        *   search that stops early never checks the rest
+        * - Each stage is only collected once it is reached, and promotions and
+        *   quiet moves are read from each piece as they are handed out, so a
+        *   search that stops early never looks at the later stages
+        * - Forced moves have more than the priority of regular moves (see
+        *   Move::lowestPriority) and come first. Once a legal forced move is
+        *   found, only moves with the same priority follow, and moves below
+        *   the lowest priority allowed this turn (see
+        *   GameState::getPriorityBound()) are never handed out, which matches
+        *   the moves allowed by GameState::getMovesOfPiece()
+        * - A tactical generator skips the quiet moves, which is what a 
+        *   quiescence search needs
+        */
+        public:
+            /*
+            * The stages in the order they are handed out
+            */
+            enum class Stage
+            {
+                forced = 0, // Priority above regular moves (ex: En Passant, Il Vaticano), highest priority first
+                captures,   // Moves onto an opponent's piece, most valuable victim first, then least valuable attacker
+                promotions, // Moves that add a new piece in place of the moved piece (ex: promotion, knight boosting)
+                quiets,     // Every other move, in the order they were generated
+                done
+            };
+
+            /*
+            * A single legal move handed out by the generator
+            * - move points into the generator and stays valid until next() is
+            *   called again
+            */
+            struct StagedMove
+            {
+                Move::position start{};
+                Move::position end{};
+                Move* move{nullptr};
+                int priority{0};
+                Stage stage{Stage::done};
+            };
+
+        private:
+            /*
+            * A pseudo-legal move that has not been handed out yet
+            * - moveIdx is the index of the move in the pseudo-legal moves of the
+            *   piece at start
+            */
+            struct Candidate
+            {
+                Move::position start{};
+                Move::position end{};
+                std::size_t moveIdx{0};
+                int priority{0};
+                double victimValue{0.0};
+                double attackerValue{0.0};
+            };
+
+            GameState& gameState;
+
+            /*
+            * The positions of the current player's pieces
+            */
+            std::vector<Move::position> piecePositions{};
+
+            /*
+            * The lowest priority allowed this turn
+            */
+            int minPriority{Move::lowestPriority};
+
+            /*
+            * The candidates of the current stage when it is forced moves or
+            * captures, and the index of the next one to hand out
+            */
+            std::vector<Candidate> candidates{};
+            std::size_t nextCandidate{0};
+            bool collected{false};
+
+            /*
+            * The piece, move, and position that promotions and quiet moves are
+            * read from next
+            */
+            std::size_t pieceIdx{0};
+            std::size_t moveIdx{0};
+            std::size_t positionIdx{0};
+
+            /*
+            * A copy of the last move handed out, since the moves of a piece can
+            * change while other positions are searched
+            */
+            Move move{};
+
+            /*
+            * The stage currently being handed out
+            */
+            Stage stage{Stage::forced};
+
+            /*
+            * Whether quiet moves are skipped
+            */
+            bool tacticalOnly{false};
+
+            /*
+            * The only priority allowed once it is known, or -1 before then
+            */
+            int allowedPriority{-1};
+
+            /*
+            * Returns the stage of a pseudo-legal move to a position, or
+            * Stage::done if the move is never allowed this turn
+            */
+            Stage getStageOf(Piece* attacker, Move& pseudoLegalMove, Move::position position);
+
+            /*
+            * Fills candidates with every candidate of the current stage
+            */
+            void collectCandidates();
+
+            /*
+            * Sets candidate to the next candidate of the current stage and
+            * returns its pseudo-legal move, which is only valid until the board
+            * changes, or returns nullptr if the stage has no candidates left
+            * - Forced moves and captures are picked by selection so only the
+            *   moves that are handed out are ever ordered
+            * - Promotions and quiet moves keep the order they were generated in
+            */
+            Move* takeCandidate(Candidate& candidate);
+
+            /*
+            * Returns whether a is a better candidate than b in the current stage
+            */
+            bool better(const Candidate& a, const Candidate& b);
+
+            /*
+            * Returns whether the move adds a new piece after moving (ex: promotion)
+            */
+            static bool addsPiece(Move& move);
+
+        public:
+            /*
+            * Constructor: Finds the current player's pieces
+            * - If tacticalOnly is true, only forced moves, captures, promotions,
+            *   and knight boosts are handed out
+            */
+            StagedMoveGenerator(GameState& gameState, bool tacticalOnly = false);
+
+            /*
+            * Sets nextMove to the next legal move
+            *
+            * Returns:
+            * - true if a move was found
+            * - false if every legal move has been handed out
+            */
+            bool next(StagedMove& nextMove);
+
+            /*
+            * Returns the stage that the next move will come from
+            */
+            Stage getStage();
+    };
+}
+#endif
@@ -0,0 +1,140 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <typeinfo>
+
+/*
+* Records a statistic if statistics are compiled in and enabled at runtime
+* - Ex: STATS_RECORD(recordCacheHit(Stats::Cache::moves));
+* - Compiles to nothing when ENABLE_STATS is not defined
+*/
+#ifdef ENABLE_STATS
+#define STATS_RECORD(call) do { if(logic::Stats::isEnabled()) { logic::Stats::call; } } while(0)
+#define STATS_SCOPED_TIMER(name, timer) logic::Stats::ScopedTimer name{timer}
+#else
+#define STATS_RECORD(call) do {} while(0)
+#define STATS_SCOPED_TIMER(name, timer) do {} while(0)
+#endif
+
+namespace logic {
+    class Stats
+    {
+        /*
+        * Counters for the engine's hot paths
+        * - Statistics are compiled in when ENABLE_STATS is defined (see the
+        *   ENABLE_STATS CMake option) and are off at runtime until setEnabled()
+        *   is called, so the only cost of leaving them compiled in is a single
+        *   relaxed atomic load per recording site (see isEnabled(), which is
+        *   inline for this reason)
+        * - All counters are atomic, so statistics can be recorded from several
+        *   threads at once
+        */
+        private:
+            /*
+            * Whether statistics are currently being recorded
+            */
+            static inline std::atomic<bool> enabled{false};
+
+        public:
+            /*
+            * The piece IDs that get their own counters
+            * - Larger IDs share the last counter
+            */
+            static constexpr int maxTrackedID = 64;
+
+            /*
+            * The caches that track hits and misses
+            */
+            enum class Cache
+            {
+                moves = 0,
+                attackMoves,
+                pseudoLegalMoves,
+                last // Here for iteration, do not use as a cache!!
+            };
+
+            /*
+            * The timers that track time spent in a function
+            */
+            enum class Timer
+            {
+                addToMove = 0,
+                last // Here for iteration, do not use as a timer!!
+            };
+
+            /*
+            * Adds the time between construction and destruction to a timer
+            */
+            class ScopedTimer
+            {
+                private:
+                    Timer timer;
+                    bool running;
+                    std::chrono::steady_clock::time_point start;
+
+                public:
+                    ScopedTimer(Timer timer);
+                    ~ScopedTimer();
+            };
+
+            /*
+            * Returns whether statistics are currently being recorded
+            */
+            static bool isEnabled()
+            {
+                return enabled.load(std::memory_order_relaxed);
+            }
+
+            /*
+            * Starts or stops recording statistics at runtime
+            * - Has no effect when statistics are not compiled in
+            */
+            static void setEnabled(bool enabled);
+
+            /*
+            * Returns whether statistics were compiled in
+            */
+            static bool compiledIn();
+
+            /*
+            * Sets every counter back to 0
+            */
+            static void reset();
+
+            /*
+            * Recording functions, normally called through STATS_RECORD
+            */
+            static void recordGenerateMoves(int id);
+            static void recordGenerateAttackingMoves(int id);
+            static void recordCacheHit(Cache cache);
+            static void recordCacheMiss(Cache cache);
+            static void recordSimulationStarted();
+            static void recordSimulationReverted();
+            static void recordAction(const std::type_info& type);
+            static void recordTime(Timer timer, std::chrono::nanoseconds duration);
+
+            /*
+            * Returns the current value of a counter
+            */
+            static std::uint64_t getGenerateMoves(int id);
+            static std::uint64_t getGenerateAttackingMoves(int id);
+            static std::uint64_t getCacheHits(Cache cache);
+            static std::uint64_t getCacheMisses(Cache cache);
+            static std::uint64_t getSimulationsStarted();
+            static std::uint64_t getSimulationsReverted();
+            static std::uint64_t getActions(const std::type_info& type);
+            static std::uint64_t getTimerCalls(Timer timer);
+            static std::uint64_t getTimerNanoseconds(Timer timer);
+
+            /*
+            * Writes every counter as a single JSON object
+            */
+            static void writeJSON(std::ostream& os);
+    };
+}
+#endif
@@ -0,0 +1,85 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace logic {
+    class ThreadPool
+    {
+        /*
+        * A fixed set of worker threads that run submitted tasks in the order
+        * they were submitted
+        * - Game states are not thread safe, so each task should work on its
+        *   own game state
+        * - The destructor finishes every submitted task before returning
+        */
+        private:
+            std::vector<std::thread> workers{};
+
+            /*
+            * Tasks that have not started yet, guarded by mutex
+            */
+            std::deque<std::function<void()>> tasks{};
+            std::mutex mutex{};
+            std::condition_variable taskAdded{};
+            bool stopping{false};
+
+            /*
+            * Runs tasks until the pool is destroyed
+            */
+            void work();
+
+        public:
+            /*
+            * Constructor: Starts the inputted number of worker threads
+            * - Uses one thread per hardware thread when threadCount is 0
+            */
+            ThreadPool(std::size_t threadCount = 0);
+
+            /*
+            * Destructor: Finishes every submitted task, then joins the workers
+            */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /*
+            * Returns the number of worker threads
+            */
+            std::size_t getThreadCount();
+
+            /*
+            * Queues the inputted task and returns a future for its result
+            * - Exceptions thrown by the task are rethrown by the future
+            */
+            template <typename Task>
+            std::future<std::invoke_result_t<Task>> submit(Task task);
+    };
+
+    // See above
+    template <typename Task>
+    std::future<std::invoke_result_t<Task>> ThreadPool::submit(Task task)
+    {
+        // std::function must be copyable, so the task is shared
+        using Result = std::invoke_result_t<Task>;
+        auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packagedTask->get_future();
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            tasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+        }
+        taskAdded.notify_one();
+        return result;
+    }
+}
+#endif
@@ -39,6 +39,12 @@ namespace logic {
             */
             Piece* movedPiece{};
 
+            /*
+            * Whether the moved piece had already moved before the most recent
+            * call of this action
+            */
+            bool wasMoved{false};
+
         public:
             /*
             * Create an action of this type with a starting position of startPos
@@ -52,7 +58,7 @@ namespace logic {
 
             /*
             * Moves a piece from end + startPos to end + endPos, sets appliedEnd = end,
-            * and stores the piece that was moved
+            * stores the piece that was moved, and marks the piece as moved
             *
             * Returns:
             * - true if the piece was successfully moved 
@@ -61,7 +67,8 @@ namespace logic {
             bool callAction(Move::position end, GameBoard* board) override;
 
             /*
-            * Moves a piece from appliedEnd + endPos to appliedEnd + startPos
+            * Moves a piece from appliedEnd + endPos to appliedEnd + startPos and
+            * restores whether the piece had moved
             *
             * Returns:
             * - true if the piece was successfully returned to its original position
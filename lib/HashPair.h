@@ -2,6 +2,8 @@
 #define HASHPAIR_H
 
 #include <functional>
+#include <cstdint>
+#include <tuple>
 
 // Credit to YoungForest on Stack Overflow for this solution https://stackoverflow.com/a/62035742
 namespace hash_tuple {
@@ -54,6 +56,14 @@ namespace hash_tuple {
         return seed;
     }
 
+    // Mixes a 64-bit value with the splitmix64 finalizer
+    inline std::uint64_t mix64(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
     struct pair_hash {
         template <class T1, class T2>
         std::size_t operator()(const std::pair<T1, T2> &p) const {
@@ -61,6 +71,32 @@ namespace hash_tuple {
         }
     };
 
+    // Hash for pairs of 32-bit integers such as board coordinates
+    // - Packs both values into 64 bits and runs them through the splitmix64
+    //   finalizer so that nearby coordinates do not collide into neighboring
+    //   buckets the way the combine hash above does
+    struct int_pair_hash {
+        template <class T1, class T2>
+        std::size_t operator()(const std::pair<T1, T2> &p) const {
+            std::uint64_t x = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(p.first)) << 32)
+                | static_cast<std::uint32_t>(p.second);
+            return static_cast<std::size_t>(mix64(x));
+        }
+    };
+
+    // Zobrist-style key for a piece standing on a position
+    // - Derived only from the piece's type, the players that control it, and
+    //   its coordinates (never from pointers), so the same position always
+    //   hashes to the same value in every run and every copy of a board
+    // - XOR the keys of every piece on a board together to get a position hash
+    //   that can be updated incrementally
+    inline std::uint64_t zobrist_key(int id, std::uint32_t playerMask, int x, int y) {
+        std::uint64_t piece = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) << 32) | playerMask;
+        std::uint64_t square = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+            | static_cast<std::uint32_t>(y);
+        return mix64(mix64(piece) ^ square);
+    }
+
     // https://stackoverflow.com/a/24847480
     struct enum_class_hash
     {
@@ -1,6 +1,8 @@
 #include <unordered_map>
+#include <algorithm>
 
 #include "ChessBoard.h"
+#include "ChessEvaluator.h"
 #include "GameState.h"
 #include "Bishop.h"
 #include "King.h"
@@ -16,6 +18,9 @@ namespace chess {
     // See ChessBoard.h
     ChessBoard::ChessBoard(bool setup) : GameBoard({Player::white, Player::black}) 
     {
+        // Score pieces as they are added so evaluating a position is O(1)
+        setEvaluator(new ChessEvaluator());
+
         // Don't add pieces if the setup flag is not enabled
         if(!setup) {
             return;
@@ -98,4 +103,9 @@ namespace chess {
         return boardSize;
     }
 
+    // See ChessBoard.h
+    int ChessBoard::getRayHorizon()
+    {
+        return std::max(maxX(), maxY()) - std::min(minX(), minY());
+    }
 }
\ No newline at end of file
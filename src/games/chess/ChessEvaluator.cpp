@@ -0,0 +1,33 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ChessEvaluator.h"
+#include "ChessPiece.h"
+
+namespace chess {
+    // See ChessEvaluator.h
+    double ChessEvaluator::getPieceSquareValue(Piece* piece, Move::position position)
+    {
+        // Pawns gain value for every row they advance past their starting row
+        if(piece->getID() == PAWN_ID) {
+            int advanced = piece->getPlayerAccess(Player::white) ? position.second - 2 : 7 - position.second;
+            return 0.05 * std::max(advanced, 0);
+        }
+
+        // Other pieces gain value for every ring closer they are to the center
+        // - The distance is 0.5 in the center and 3.5 on the edges
+        double distance = std::max(std::abs(position.first - 4.5), std::abs(position.second - 4.5));
+        double centerBonus = 3.5 - distance;
+        switch(piece->getID()) {
+            case KNIGHT_ID:
+                return 0.1 * centerBonus;
+            case BISHOP_ID:
+            case KNOOK_ID:
+                return 0.05 * centerBonus;
+            case QUEEN_ID:
+                return 0.02 * centerBonus;
+            default:
+                return 0.0;
+        }
+    }
+}
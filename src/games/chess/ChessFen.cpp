@@ -0,0 +1,429 @@
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+#include "ChessFen.h"
+#include "ChessBoard.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "Bishop.h"
+#include "King.h"
+#include "Knight.h"
+#include "Knook.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    namespace {
+        /*
+        * The letters of each piece ID and of each player
+        */
+        constexpr std::string_view pieceLetters = "?KBNPQRO";
+        constexpr std::string_view playerLetters = "wbsg";
+
+        /*
+        * The castling rights of each player, indexed by the letters in
+        * "KQkq"
+        */
+        constexpr int kingsideWhite = 1 << 0;
+        constexpr int queensideWhite = 1 << 1;
+        constexpr int kingsideBlack = 1 << 2;
+        constexpr int queensideBlack = 1 << 3;
+
+        /*
+        * Returns a new piece with the inputted letter, or nullptr if there is
+        * no piece with the letter
+        */
+        Piece* createPiece(char letter, Move::position position)
+        {
+            switch(letter) {
+                case 'K': return new King(position);
+                case 'B': return new Bishop(position);
+                case 'N': return new Knight(position);
+                case 'P': return new Pawn(position);
+                case 'Q': return new Queen(position);
+                case 'R': return new Rook(position);
+                case 'O': return new Knook(position);
+                default:  return nullptr;
+            }
+        }
+
+        /*
+        * Returns the player whose side of the board the piece starts on
+        * - Pieces are oriented the same way as in the rest of the chess code,
+        *   where anything white can move is treated as white
+        */
+        Player getSide(Piece* piece)
+        {
+            return piece->getPlayerAccess(Player::white) ? Player::white : Player::black;
+        }
+
+        /*
+        * Returns whether load() treats the inputted piece as moved even without
+        * a *, given the castling rights
+        */
+        bool impliedMoved(Piece* piece, int castling)
+        {
+            if(piece->getPlayerMask() == 0) {
+                return false;
+            }
+            Player side = getSide(piece);
+            Move::position position = piece->getPosition();
+            int homeY = side == Player::white ? 1 : 8;
+            int kingside = side == Player::white ? kingsideWhite : kingsideBlack;
+            int queenside = side == Player::white ? queensideWhite : queensideBlack;
+            switch(piece->getID()) {
+                case PAWN_ID:
+                    return position.second != (side == Player::white ? 2 : 7);
+                case KING_ID:
+                    return position == std::make_pair(5, homeY) && !(castling & (kingside | queenside));
+                case ROOK_ID:
+                    if(position == std::make_pair(8, homeY)) {
+                        return !(castling & kingside);
+                    }
+                    if(position == std::make_pair(1, homeY)) {
+                        return !(castling & queenside);
+                    }
+                    return false;
+                default:
+                    return false;
+            }
+        }
+
+        /*
+        * Returns whether the piece at the inputted position is an unmoved piece
+        * with the inputted ID that belongs to the inputted player
+        */
+        bool unmovedAt(GameBoard* board, Move::position position, Piece::ID id, Player player)
+        {
+            Piece* piece = board->getPiece(position);
+            return piece && piece->getID() == id && piece->getPlayerAccess(player) && !piece->previouslyMoved();
+        }
+
+        /*
+        * Moves past the next field of the inputted string and returns it
+        */
+        std::string_view nextField(std::string_view& fen)
+        {
+            std::size_t start = fen.find_first_not_of(' ');
+            if(start == std::string_view::npos) {
+                fen = {};
+                return {};
+            }
+            fen.remove_prefix(start);
+            std::size_t end = std::min(fen.find(' '), fen.size());
+            std::string_view field = fen.substr(0, end);
+            fen.remove_prefix(end);
+            return field;
+        }
+
+        /*
+        * Reads a whole field as a number, returning false if it is not one
+        */
+        bool parseNumber(std::string_view field, int& number)
+        {
+            auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), number);
+            return error == std::errc{} && end == field.data() + field.size();
+        }
+
+        /*
+        * Appends a number to the inputted string without allocating a
+        * temporary string
+        */
+        void appendNumber(std::string& fen, int number)
+        {
+            char buffer[16];
+            auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            fen.append(buffer, end);
+        }
+
+        /*
+        * Adds the pieces in the placement field to the inputted board and
+        * returns whether the field was valid
+        * - Pieces are set up before they are added since the board scores
+        *   them by their controllers, and the board deletes them on failure
+        */
+        bool parsePlacement(std::string_view placement, int castling, ChessBoard* board)
+        {
+            int x = 1;
+            int y = 8;
+            for(std::size_t i = 0; i < placement.size(); i++) {
+                char letter = placement[i];
+                if(letter == '/') {
+                    if(x != 9 || y == 1) {
+                        return false;
+                    }
+                    x = 1;
+                    y--;
+                    continue;
+                }
+                if('1' <= letter && letter <= '8') {
+                    x += letter - '0';
+                    if(x > 9) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                // Create the piece
+                bool isWhite = 'A' <= letter && letter <= 'Z';
+                char upper = isWhite ? letter : static_cast<char>(letter - 'a' + 'A');
+                if(x > 8) {
+                    return false;
+                }
+                std::unique_ptr<Piece> piece{createPiece(upper, std::make_pair(x, y))};
+                if(!piece) {
+                    return false;
+                }
+
+                // Give the piece its controllers
+                if(i + 1 < placement.size() && placement[i + 1] == '[') {
+                    std::size_t close = placement.find(']', i + 1);
+                    if(close == std::string_view::npos) {
+                        return false;
+                    }
+                    for(char player : placement.substr(i + 2, close - i - 2)) {
+                        std::size_t idx = playerLetters.find(player);
+                        if(idx == std::string_view::npos) {
+                            return false;
+                        }
+                        piece->addPlayer(static_cast<Player>(idx));
+                    }
+                    i = close;
+                }
+                else {
+                    piece->addPlayer(isWhite ? Player::white : Player::black);
+                }
+
+                // Mark moved pieces
+                if(i + 1 < placement.size() && placement[i + 1] == '*') {
+                    piece->validateMove();
+                    i++;
+                }
+                if(impliedMoved(piece.get(), castling)) {
+                    piece->validateMove();
+                }
+
+                // No pawn boosted last turn unless there is an En Passant square
+                if(piece->getID() == PAWN_ID) {
+                    static_cast<Pawn*>(piece.get())->setBoostTurn(-1);
+                }
+                board->addPiece(piece.release());
+                x++;
+            }
+            return x == 9 && y == 1;
+        }
+    }
+
+    // See ChessFen.h
+    ChessGameState* ChessFen::load(std::string_view fen)
+    {
+        std::string_view placement = nextField(fen);
+        std::string_view active = nextField(fen);
+        std::string_view castlingField = nextField(fen);
+        std::string_view enPassant = nextField(fen);
+        std::string_view halfmoveField = nextField(fen);
+        std::string_view fullmoveField = nextField(fen);
+        if(enPassant.empty() || !nextField(fen).empty() || (active != "w" && active != "b")) {
+            return nullptr;
+        }
+
+        // Read the numbers first since the En Passant pawn needs the turn
+        int halfmoveClock = 0;
+        int fullmove = 1;
+        if(!halfmoveField.empty() && !parseNumber(halfmoveField, halfmoveClock)) {
+            return nullptr;
+        }
+        if(!fullmoveField.empty() && !parseNumber(fullmoveField, fullmove)) {
+            return nullptr;
+        }
+        if(halfmoveClock < 0 || fullmove < 1) {
+            return nullptr;
+        }
+        int turn = 2 * (fullmove - 1) + (active == "w" ? 1 : 2);
+
+        // Read the castling rights
+        int castling = 0;
+        if(castlingField != "-") {
+            for(char right : castlingField) {
+                std::size_t idx = std::string_view{"KQkq"}.find(right);
+                if(idx == std::string_view::npos) {
+                    return nullptr;
+                }
+                castling |= 1 << idx;
+            }
+        }
+
+        // Add the pieces
+        std::unique_ptr<ChessBoard> board{new ChessBoard(false)};
+        if(!parsePlacement(placement, castling, board.get())) {
+            return nullptr;
+        }
+        bool hasKing[2]{};
+        for(Player player : {Player::white, Player::black}) {
+            for(Move::position position : board->getPiecesOfPlayer(player)) {
+                hasKing[static_cast<int>(player)] |= board->getPiece(position)->getID() == KING_ID;
+            }
+        }
+        if(!hasKing[0] || !hasKing[1]) {
+            return nullptr;
+        }
+
+        // Find the pawn that boosted last turn
+        Piece* boostedPawn = nullptr;
+        if(enPassant != "-") {
+            Player boosted = active == "w" ? Player::black : Player::white;
+            int x = enPassant.size() == 2 ? enPassant[0] - 'a' + 1 : 0;
+            int y = boosted == Player::white ? 4 : 5;
+            Piece* pawn = board->getPiece(x, y);
+            if(enPassant.size() != 2 || enPassant[1] != (boosted == Player::white ? '3' : '6')
+                || !pawn || pawn->getID() != PAWN_ID || getSide(pawn) != boosted) {
+                return nullptr;
+            }
+            static_cast<Pawn*>(pawn)->setBoostTurn(turn - 1);
+            pawn->validateMove();
+            boostedPawn = pawn;
+        }
+
+        // Set up the game state
+        ChessGameState* chessState = new ChessGameState(board.release());
+        chessState->setBoostedPawn(boostedPawn);
+        chessState->setTurn(turn);
+        chessState->setHalfmoveClock(halfmoveClock);
+        return chessState;
+    }
+
+    // See ChessFen.h
+    ChessGameState* ChessFen::copy(ChessGameState& chessState)
+    {
+        if(chessState.getSimulatedMoveCount() > 0) {
+            return nullptr;
+        }
+        std::unique_ptr<ChessGameState> copied{load(toString(chessState))};
+        if(!copied || !copied->copyPositionHistory(chessState)) {
+            return nullptr;
+        }
+        return copied.release();
+    }
+
+    // See ChessFen.h
+    void ChessFen::write(ChessGameState& chessState, std::string& fen)
+    {
+        fen.clear();
+        GameBoard* board = chessState.getBoard();
+
+        // Find the castling rights first since they decide which pieces need a *
+        int castling = 0;
+        for(Player player : {Player::white, Player::black}) {
+            int homeY = player == Player::white ? 1 : 8;
+            if(!unmovedAt(board, std::make_pair(5, homeY), KING_ID, player)) {
+                continue;
+            }
+            if(unmovedAt(board, std::make_pair(8, homeY), ROOK_ID, player)) {
+                castling |= player == Player::white ? kingsideWhite : kingsideBlack;
+            }
+            if(unmovedAt(board, std::make_pair(1, homeY), ROOK_ID, player)) {
+                castling |= player == Player::white ? queensideWhite : queensideBlack;
+            }
+        }
+
+        // Write the pieces
+        Piece* boostedPawn = nullptr;
+        for(int y = 8; y >= 1; y--) {
+            int empty = 0;
+            for(int x = 1; x <= 8; x++) {
+                Piece* piece = board->getPiece(x, y);
+                if(!piece) {
+                    empty++;
+                    continue;
+                }
+                if(empty > 0) {
+                    fen.push_back(static_cast<char>('0' + empty));
+                    empty = 0;
+                }
+
+                // Lowercase pieces belong to black, and pieces with other
+                // controllers list them
+                char letter = pieceLetters[static_cast<std::size_t>(piece->getID()) < pieceLetters.size() ? piece->getID() : 0];
+                std::uint32_t mask = piece->getPlayerMask();
+                if(mask == (1u << static_cast<int>(Player::white))) {
+                    fen.push_back(letter);
+                }
+                else if(mask == (1u << static_cast<int>(Player::black))) {
+                    fen.push_back(static_cast<char>(letter - 'A' + 'a'));
+                }
+                else {
+                    fen.push_back(letter);
+                    fen.push_back('[');
+                    for(std::size_t player = 0; player < playerLetters.size(); player++) {
+                        if(mask & (1u << player)) {
+                            fen.push_back(playerLetters[player]);
+                        }
+                    }
+                    fen.push_back(']');
+                }
+                if(piece->previouslyMoved() && !impliedMoved(piece, castling)) {
+                    fen.push_back('*');
+                }
+
+                // Remember the pawn that just boosted
+                if(piece->getID() == PAWN_ID && mask != 0 && getSide(piece) != chessState.getCrntPlayer()
+                    && y == (getSide(piece) == Player::white ? 4 : 5)
+                    && static_cast<Pawn*>(piece)->getBoostTurn() == chessState.getTurn() - 1) {
+                    boostedPawn = piece;
+                }
+            }
+            if(empty > 0) {
+                fen.push_back(static_cast<char>('0' + empty));
+            }
+            if(y > 1) {
+                fen.push_back('/');
+            }
+        }
+
+        // Write the player to move and the castling rights
+        fen.push_back(' ');
+        fen.push_back(chessState.getCrntPlayer() == Player::white ? 'w' : 'b');
+        fen.push_back(' ');
+        if(castling == 0) {
+            fen.push_back('-');
+        }
+        for(int right = 0; right < 4; right++) {
+            if(castling & (1 << right)) {
+                fen.push_back("KQkq"[right]);
+            }
+        }
+
+        // Write the square behind the pawn that just boosted
+        fen.push_back(' ');
+        if(boostedPawn) {
+            Move::position position = boostedPawn->getPosition();
+            fen.push_back(static_cast<char>('a' + position.first - 1));
+            fen.push_back(getSide(boostedPawn) == Player::white ? '3' : '6');
+        }
+        else {
+            fen.push_back('-');
+        }
+
+        // Write the halfmove clock and the move number
+        fen.push_back(' ');
+        appendNumber(fen, chessState.getHalfmoveClock());
+        fen.push_back(' ');
+        appendNumber(fen, (chessState.getTurn() - 1) / 2 + 1);
+    }
+
+    // See ChessFen.h
+    std::string ChessFen::toString(ChessGameState& chessState)
+    {
+        std::string fen{};
+        write(chessState, fen);
+        return fen;
+    }
+}
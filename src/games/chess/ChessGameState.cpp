@@ -1,9 +1,12 @@
 #include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 #include "ChessGameState.h"
 #include "ChessPiece.h"
 #include "GameState.h"
+#include "Pawn.h"
+#include "HashPair.h"
 
 namespace chess {
     using namespace logic;
@@ -13,6 +16,9 @@ namespace chess {
     ChessGameState::ChessGameState() : GameState(new ChessBoard(), {Player::white, Player::black}) {
         kings[Player::white] = getBoard()->getPiece(std::make_pair(5, 1));
         kings[Player::black] = getBoard()->getPiece(std::make_pair(5, 8));
+
+        // Record the first position again now that its key has the castling rights
+        setTurn(getTurn());
     }
 
     // See ChessGameState.h
@@ -43,6 +49,9 @@ namespace chess {
         if(kings[Player::white] == nullptr || kings[Player::black] == nullptr) {
             std::cerr << "Error: At least one player does not have a king!";
         }
+
+        // Record the first position again now that its key has the castling rights
+        setTurn(getTurn());
     }
 
     // See ChessGameState.h
@@ -73,4 +82,81 @@ namespace chess {
     {
         return isInCheckmate(getCrntPlayer());
     }
-}
\ No newline at end of file
+
+    // See ChessGameState.h
+    ChessGameState::Result ChessGameState::getResult()
+    {
+        if(isDrawByRepetition()) {
+            return Result::repetition;
+        }
+        if(isDrawByHalfmoveClock()) {
+            return Result::fiftyMoves;
+        }
+        if(getPriority() != 0) {
+            return Result::ongoing;
+        }
+        return isInCheck() ? Result::checkmate : Result::stalemate;
+    }
+
+    // See ChessGameState.h
+    bool ChessGameState::resetsHalfmoveClock(Piece* piece)
+    {
+        return piece->getID() == PAWN_ID;
+    }
+
+    // See ChessGameState.h
+    bool ChessGameState::isLegal(Move::position start, Move::position end, Move& move)
+    {
+        // Simulate the move in its own frame so only its actions are reverted
+        GameBoard* board = getBoard();
+        board->beginSimulationFrame();
+        bool isSafe = simulateMove(start, end, move) && !isInCheck();
+        board->endSimulationFrame();
+        return isSafe;
+    }
+
+    // See ChessGameState.h
+    std::uint64_t ChessGameState::getStateKey()
+    {
+        std::uint64_t key = 0;
+        GameBoard* board = getBoard();
+
+        // Castling rights, using the rook positions from King::addKingsideCastle()
+        // and King::addQueensideCastle()
+        for(auto& [player, king] : kings) {
+            if(!king || !king->getOnBoard() || king->previouslyMoved()) {
+                continue;
+            }
+            Move::position position = king->getPosition();
+            for(int offset : {3, -4}) {
+                Piece* rook = board->getPiece(position.first + offset, position.second);
+                if(rook && rook->getID() == ROOK_ID && !rook->previouslyMoved()) {
+                    key ^= hash_tuple::mix64(hash_tuple::zobrist_key(KING_ID, 0, position.first + offset, position.second));
+                }
+            }
+        }
+
+        // The pawn that can be captured En Passant
+        if(boostedPawn && boostedPawn->getOnBoard() && static_cast<Pawn*>(boostedPawn)->getBoostTurn() == getTurn() - 1) {
+            Move::position position = boostedPawn->getPosition();
+            key ^= hash_tuple::mix64(hash_tuple::zobrist_key(PAWN_ID, 0, position.first, position.second));
+        }
+        return key;
+    }
+
+    // See ChessGameState.h
+    bool ChessGameState::losesWithoutMoves()
+    {
+        return isInCheck();
+    }
+
+    // See ChessGameState.h
+    Piece* ChessGameState::getBoostedPawn()
+    {
+        return boostedPawn;
+    }
+    void ChessGameState::setBoostedPawn(Piece* pawn)
+    {
+        boostedPawn = pawn;
+    }
+}
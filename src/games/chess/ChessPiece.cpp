@@ -7,6 +7,7 @@
 #include "Move.h"
 #include "Action.h"
 #include "MovePieceAction.h"
+#include "Stats.h"
 
 namespace chess {
     using namespace logic;
@@ -21,44 +22,22 @@ namespace chess {
     // See ChessPiece.h
     bool ChessPiece::addToMove(Move::position position, Move& move, ChessGameState& chessState)
     {    
+        STATS_SCOPED_TIMER(timer, Stats::Timer::addToMove);
+
         // If this piece is not controlled by the current player, bypass Checkmate checks
         // to prevent infinite loops
-        if(!controlledByPlayer(chessState)) {
+        // - Pseudo-legal moves are checked later with ChessGameState::isLegal()
+        if(!controlledByPlayer(chessState) || chessState.generatingPseudoLegalMoves()) {
             move.addPosition(position);
             return true;
         }
 
-        // Store values for later
-        GameBoard* board = chessState.getBoard();
-        Move::position curPosition = getPosition();
-
-        // Create an action that, when called, will move the piece from start to end
-        std::shared_ptr<Action> moveAction = make_action(new MovePieceAction(std::make_pair(position.first - curPosition.first, position.second - curPosition.second)));
-        
-        // Simulate all premove actions
-        if(!chessState.callActions(move.getPreMoveActions(), position)) {
-            return false;
-        }
-
-        // Simulate moving the piece
-        if(!chessState.callAction(moveAction, curPosition)) {
-            return false;
-        }
-
-        // Simulate all postmove actions
-        if(!chessState.callActions(move.getPostMoveActions(), position)) {
-            return false;
-        }
-
-        // Make sure the moves did not cause check
-        bool isSafe = !chessState.isInCheck();
-        board->revertSimulation();
-
         // Add the move only if it does not put the player in check
-        if(isSafe) {
-            move.addPosition(position);
+        if(!chessState.isLegal(getPosition(), position, move)) {
+            return false;
         }
-        return isSafe;
+        move.addPosition(position);
+        return true;
     }
 
     // See ChessPiece.h
@@ -138,14 +117,13 @@ namespace chess {
             }
             
             // Add the position to the move
+            // - A position that would leave the player in check does not stop the
+            //   positions after it, which may still block the check
             if(addToMove(position, newMove, chessState)) {
                 added = true;
             }
-            else {
-                break;
-            }
 
-            // Stop if the tile just added is occupied
+            // Stop if the tile just checked is occupied
             if(occupied) {
                 break;
             }
@@ -205,6 +183,12 @@ namespace chess {
         addRelatedPositions(positions, moves, chessState, priority, preMoves, postMoves);
     }
 
+    // See ChessPiece.h
+    void ChessPiece::addRay(Move::position direction, std::vector<Move>& moves, ChessGameState& chessState, int priority)
+    {
+        addRelatedPositions(chessState.getBoard()->castRay(getPosition(), direction), moves, chessState, priority);
+    }
+
     // See ChessPiece.h
     Player ChessPiece::getPlayer() {
         return getPlayerAccess(Player::white) ? Player::white : Player::black;
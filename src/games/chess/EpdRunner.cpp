@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "EpdRunner.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameState.h"
+#include "Search.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+
+    namespace {
+        /*
+        * Returns the inputted string without spaces at either end
+        */
+        std::string_view trim(std::string_view text)
+        {
+            std::size_t start = text.find_first_not_of(" \t\r");
+            if(start == std::string_view::npos) {
+                return {};
+            }
+            std::size_t end = text.find_last_not_of(" \t\r");
+            return text.substr(start, end - start + 1);
+        }
+
+        /*
+        * Reads a whole string as a number, returning false if it is not one
+        */
+        template <typename Number>
+        bool parseNumber(std::string_view text, Number& number)
+        {
+            auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+            return error == std::errc{} && end == text.data() + text.size();
+        }
+
+        /*
+        * Returns the inputted position in algebraic notation, ex: e4
+        */
+        std::string toSquare(Move::position position)
+        {
+            return {static_cast<char>('a' + position.first - 1), static_cast<char>('0' + position.second)};
+        }
+    }
+
+    // See EpdRunner.h
+    EpdRunner::EpdRunner(Options options) : options{ options } {}
+
+    // See EpdRunner.h
+    bool EpdRunner::isSkipped(std::string_view line)
+    {
+        line = trim(line);
+        return line.empty() || line[0] == '#';
+    }
+
+    // See EpdRunner.h
+    EpdRunner::LineResult EpdRunner::runLine(std::string_view line, const Options& options)
+    {
+        // The position is the first 4 fields
+        line = trim(line);
+        std::size_t fieldEnd = 0;
+        for(int field = 0; field < 4 && fieldEnd != std::string_view::npos; field++) {
+            std::size_t start = line.find_first_not_of(' ', fieldEnd);
+            fieldEnd = start == std::string_view::npos ? start : line.find(' ', start);
+        }
+        std::string_view fen = line.substr(0, fieldEnd);
+        std::string_view operations = fieldEnd == std::string_view::npos ? std::string_view{} : line.substr(fieldEnd);
+
+        // Read the operations
+        std::string_view id{};
+        std::uint64_t expected = 0;
+        bool hasExpected = false;
+        int halfmoveClock = 0;
+        int fullmove = 1;
+        while(!operations.empty()) {
+            std::size_t end = std::min(operations.find(';'), operations.size());
+            std::string_view operation = trim(operations.substr(0, end));
+            operations.remove_prefix(std::min(end + 1, operations.size()));
+            std::size_t split = std::min(operation.find(' '), operation.size());
+            std::string_view opcode = operation.substr(0, split);
+            std::string_view operand = trim(operation.substr(split));
+
+            int number = 0;
+            if(opcode == "id") {
+                id = operand.size() >= 2 && operand.front() == '"' && operand.back() == '"' ? operand.substr(1, operand.size() - 2) : operand;
+            }
+            else if(opcode == "hmvc" && parseNumber(operand, number) && number >= 0) {
+                halfmoveClock = number;
+            }
+            else if(opcode == "fmvn" && parseNumber(operand, number) && number >= 1) {
+                fullmove = number;
+            }
+            else if(opcode.size() > 1 && opcode[0] == 'D' && parseNumber(opcode.substr(1), number) && number == options.depth) {
+                hasExpected = parseNumber(operand, expected);
+            }
+        }
+
+        // The move numbers are loaded with the position, since changing the
+        // turn afterwards would lose the En Passant pawn
+        std::string fullFen = std::string{fen} + " " + std::to_string(halfmoveClock) + " " + std::to_string(fullmove);
+        std::unique_ptr<ChessGameState> chessState{ChessFen::load(fullFen)};
+        if(!chessState) {
+            return {"error invalid position", true};
+        }
+
+        // Run the task
+        LineResult result{};
+        std::ostringstream text{};
+        Search search{*chessState};
+        switch(options.task) {
+            case Task::perft: {
+                std::uint64_t nodes = search.perft(options.depth);
+                text << "perft " << options.depth << " " << nodes;
+                if(hasExpected) {
+                    result.failed = nodes != expected;
+                    text << (result.failed ? " FAIL expected " + std::to_string(expected) : " ok");
+                }
+                break;
+            }
+            case Task::count: {
+                std::vector<GameState::LegalMove> legalMoves{};
+                chessState->generateAllLegalMoves(legalMoves);
+                text << "moves " << legalMoves.size();
+                break;
+            }
+            case Task::search: {
+                Search::Result best = search.findBestMove(options.depth);
+                if(!best.found) {
+                    text << "bestmove none";
+                    break;
+                }
+                text << "bestmove " << toSquare(best.move.start) << toSquare(best.move.end)
+                     << " score " << best.score;
+                break;
+            }
+        }
+        if(!id.empty()) {
+            text << " id \"" << id << "\"";
+        }
+        result.text = text.str();
+        return result;
+    }
+
+    // See EpdRunner.h
+    EpdRunner::Summary EpdRunner::run(std::istream& input, std::ostream& output)
+    {
+        ThreadPool pool{options.threadCount};
+        std::size_t maxPending = options.maxPending > 0 ? options.maxPending : 4 * pool.getThreadCount();
+
+        // Results are written in order, so the oldest position is waited on
+        // once too many are in flight
+        Summary summary{};
+        std::deque<std::pair<std::size_t, std::future<LineResult>>> pending{};
+        auto writeOldest = [&]() {
+            LineResult result = pending.front().second.get();
+            output << pending.front().first << ": " << result.text << "\n";
+            summary.failed += result.failed;
+            pending.pop_front();
+        };
+
+        std::string line{};
+        std::size_t lineNumber = 0;
+        while(std::getline(input, line)) {
+            lineNumber++;
+            if(isSkipped(line)) {
+                continue;
+            }
+            summary.positions++;
+            pending.emplace_back(lineNumber, pool.submit([line, this]() { return runLine(line, options); }));
+            while(pending.size() >= maxPending) {
+                writeOldest();
+            }
+        }
+        while(!pending.empty()) {
+            writeOldest();
+        }
+        output.flush();
+        return summary;
+    }
+}
@@ -0,0 +1,207 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "GameRecord.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "MappedFile.h"
+
+namespace chess {
+    using namespace logic;
+
+    namespace {
+        /*
+        * The bytes at the start of every game record file
+        */
+        constexpr char magic[4] = {'A', 'C', 'G', 'R'};
+        constexpr std::size_t fileHeaderSize = 8;
+        constexpr std::size_t gameHeaderSize = 8;
+
+        /*
+        * Reads and writes little-endian numbers one byte at a time so the
+        * format does not depend on the machine
+        */
+        std::uint16_t read16(const unsigned char* bytes)
+        {
+            return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+        std::uint32_t read32(const unsigned char* bytes)
+        {
+            return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+                | (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        }
+        void write16(unsigned char* bytes, std::uint16_t number)
+        {
+            bytes[0] = static_cast<unsigned char>(number & 0xFF);
+            bytes[1] = static_cast<unsigned char>(number >> 8);
+        }
+        void write32(unsigned char* bytes, std::uint32_t number)
+        {
+            for(int i = 0; i < 4; i++) {
+                bytes[i] = static_cast<unsigned char>((number >> (8 * i)) & 0xFF);
+            }
+        }
+    }
+
+    // See GameRecord.h
+    bool GameRecord::encodeMove(Move::position start, Move::position end, int idx, std::uint16_t& encoded)
+    {
+        auto onBoard = [](Move::position position) {
+            return 1 <= position.first && position.first <= 8 && 1 <= position.second && position.second <= 8;
+        };
+        if(!onBoard(start) || !onBoard(end) || idx < 0 || idx > maxMoveIdx) {
+            return false;
+        }
+        int startSquare = (start.second - 1) * 8 + start.first - 1;
+        int endSquare = (end.second - 1) * 8 + end.first - 1;
+        encoded = static_cast<std::uint16_t>(startSquare | (endSquare << 6) | (idx << 12));
+        return true;
+    }
+
+    // See GameRecord.h
+    void GameRecord::decodeMove(std::uint16_t encoded, Move::position& start, Move::position& end, int& idx)
+    {
+        int startSquare = encoded & 0x3F;
+        int endSquare = (encoded >> 6) & 0x3F;
+        start = std::make_pair(startSquare % 8 + 1, startSquare / 8 + 1);
+        end = std::make_pair(endSquare % 8 + 1, endSquare / 8 + 1);
+        idx = encoded >> 12;
+    }
+
+    // See GameRecord.h
+    bool GameRecord::addMove(Move::position start, Move::position end, int idx)
+    {
+        std::uint16_t encoded = 0;
+        if(!encodeMove(start, end, idx, encoded)) {
+            return false;
+        }
+        moves.push_back(encoded);
+        return true;
+    }
+
+    // See GameRecord.h
+    GameRecordWriter::GameRecordWriter(std::ostream& output) : output{ output }
+    {
+        unsigned char header[fileHeaderSize]{};
+        std::memcpy(header, magic, sizeof(magic));
+        write16(header + 4, GameRecordReader::version);
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    // See GameRecord.h
+    bool GameRecordWriter::write(const GameRecord& record)
+    {
+        if(record.startFen.size() > UINT16_MAX) {
+            return false;
+        }
+
+        // Write the game's header and starting position
+        unsigned char header[gameHeaderSize]{};
+        write32(header, static_cast<std::uint32_t>(record.moves.size()));
+        header[4] = static_cast<unsigned char>(record.result);
+        write16(header + 6, static_cast<std::uint16_t>(record.startFen.size()));
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+        output.write(record.startFen.data(), static_cast<std::streamsize>(record.startFen.size()));
+        if(record.startFen.size() % 2 != 0) {
+            output.put('\0');
+        }
+
+        // Write the moves in blocks to avoid a call per move
+        unsigned char buffer[512];
+        std::size_t used = 0;
+        for(std::uint16_t move : record.moves) {
+            write16(buffer + used, move);
+            used += 2;
+            if(used == sizeof(buffer)) {
+                output.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        }
+        output.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(used));
+        return output.good();
+    }
+
+    // See GameRecord.h
+    void GameRecordReader::Game::getMove(std::uint32_t ply, Move::position& start, Move::position& end, int& idx) const
+    {
+        GameRecord::decodeMove(read16(moves + 2 * static_cast<std::size_t>(ply)), start, end, idx);
+    }
+
+    // See GameRecord.h
+    bool GameRecordReader::open(const std::string& path)
+    {
+        if(!file.open(path)) {
+            return false;
+        }
+        return setData(file.getData(), file.getSize());
+    }
+
+    // See GameRecord.h
+    bool GameRecordReader::setData(const unsigned char* newData, std::size_t newSize)
+    {
+        data = nullptr;
+        size = 0;
+        offset = 0;
+        if(!newData || newSize < fileHeaderSize || std::memcmp(newData, magic, sizeof(magic)) != 0
+            || read16(newData + 4) != version) {
+            return false;
+        }
+        data = newData;
+        size = newSize;
+        offset = fileHeaderSize;
+        return true;
+    }
+
+    // See GameRecord.h
+    bool GameRecordReader::next(Game& game)
+    {
+        if(!data || size - offset < gameHeaderSize) {
+            return false;
+        }
+
+        // Make sure the whole game is there before reading it
+        const unsigned char* header = data + offset;
+        std::uint32_t plyCount = read32(header);
+        std::size_t fenLength = read16(header + 6);
+        std::size_t paddedLength = fenLength + fenLength % 2;
+        std::size_t gameSize = gameHeaderSize + paddedLength + 2 * static_cast<std::size_t>(plyCount);
+        if(size - offset < gameSize) {
+            return false;
+        }
+
+        // Corrupt results would otherwise become results that don't exist
+        if(header[4] > static_cast<unsigned char>(ChessGameState::Result::fiftyMoves)) {
+            return false;
+        }
+
+        game.plyCount = plyCount;
+        game.result = static_cast<ChessGameState::Result>(header[4]);
+        game.startFen = std::string_view{reinterpret_cast<const char*>(header + gameHeaderSize), fenLength};
+        game.moves = header + gameHeaderSize + paddedLength;
+        offset += gameSize;
+        return true;
+    }
+
+    // See GameRecord.h
+    ChessGameState* GameRecordReader::replay(const Game& game)
+    {
+        std::unique_ptr<ChessGameState> chessState{game.startFen.empty() ? new ChessGameState() : ChessFen::load(game.startFen)};
+        if(!chessState) {
+            return nullptr;
+        }
+        for(std::uint32_t ply = 0; ply < game.plyCount; ply++) {
+            Move::position start{};
+            Move::position end{};
+            int idx = 0;
+            game.getMove(ply, start, end, idx);
+            if(!chessState->movePiece(start, end, idx)) {
+                return nullptr;
+            }
+        }
+        return chessState.release();
+    }
+}
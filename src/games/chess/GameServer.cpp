@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "GameServer.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "GameState.h"
+#include "San.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    namespace {
+        /*
+        * Splits the first word off of text, leaving the rest without spaces
+        * at either end
+        */
+        std::string_view nextWord(std::string_view& text)
+        {
+            std::size_t start = std::min(text.find_first_not_of(" \t\r"), text.size());
+            text.remove_prefix(start);
+            std::size_t end = std::min(text.find_first_of(" \t\r"), text.size());
+            std::string_view word = text.substr(0, end);
+            text.remove_prefix(end);
+            start = std::min(text.find_first_not_of(" \t\r"), text.size());
+            text.remove_prefix(start);
+            std::size_t last = text.find_last_not_of(" \t\r");
+            text = last == std::string_view::npos ? std::string_view{} : text.substr(0, last + 1);
+            return word;
+        }
+
+        /*
+        * Reads a whole string as a game id, returning false if it is not one
+        */
+        bool parseId(std::string_view text, std::uint64_t& id)
+        {
+            auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), id);
+            return !text.empty() && error == std::errc{} && end == text.data() + text.size();
+        }
+
+        /*
+        * Returns the name of a result in responses
+        */
+        const char* getResultName(ChessGameState::Result result)
+        {
+            switch(result) {
+                case ChessGameState::Result::ongoing:
+                    return "ongoing";
+                case ChessGameState::Result::checkmate:
+                    return "checkmate";
+                case ChessGameState::Result::stalemate:
+                    return "stalemate";
+                case ChessGameState::Result::repetition:
+                    return "repetition";
+                case ChessGameState::Result::fiftyMoves:
+                    return "fiftyMoves";
+            }
+            return "ongoing";
+        }
+    }
+
+    // See GameServer.h
+    SessionManager::SessionManager(Options options) : options{ options } {}
+
+    // See GameServer.h
+    std::shared_ptr<SessionManager::Session> SessionManager::find(std::uint64_t id)
+    {
+        std::shared_lock<std::shared_mutex> lock{sessionsMutex};
+        auto found = sessions.find(id);
+        return found != sessions.end() ? found->second : nullptr;
+    }
+
+    // See GameServer.h
+    bool SessionManager::activate(Session& session)
+    {
+        if(session.closed) {
+            return false;
+        }
+        session.lastUsed = ++clock;
+        if(session.chessState) {
+            return true;
+        }
+
+        // Replay the record of an evicted game
+        const GameRecord& record = session.record;
+        std::unique_ptr<ChessGameState> chessState{record.startFen.empty() ? new ChessGameState() : ChessFen::load(record.startFen)};
+        if(!chessState) {
+            return false;
+        }
+        for(std::uint16_t encoded : record.moves) {
+            Move::position start{};
+            Move::position end{};
+            int idx = 0;
+            GameRecord::decodeMove(encoded, start, end, idx);
+            if(!chessState->movePiece(start, end, idx)) {
+                return false;
+            }
+        }
+        session.chessState = std::move(chessState);
+        session.active = true;
+        activeCount++;
+        restores++;
+        return true;
+    }
+
+    // See GameServer.h
+    void SessionManager::evictIdle()
+    {
+        if(activeCount <= options.maxActiveSessions) {
+            return;
+        }
+
+        // Evict the least recently used games first
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<Session>>> candidates{};
+        {
+            std::shared_lock<std::shared_mutex> lock{sessionsMutex};
+            for(auto& [id, session] : sessions) {
+                if(session->active) {
+                    candidates.emplace_back(session->lastUsed.load(), session);
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::size_t target = options.maxActiveSessions - options.maxActiveSessions / 4;
+        for(auto& [lastUsed, session] : candidates) {
+            if(activeCount <= target) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock{session->mutex, std::try_to_lock};
+            if(!lock.owns_lock() || !session->chessState) {
+                continue;
+            }
+            session->chessState.reset();
+            session->active = false;
+            activeCount--;
+            evictions++;
+        }
+    }
+
+    // See GameServer.h
+    bool SessionManager::create(std::string_view fen, std::uint64_t& id)
+    {
+        std::shared_ptr<Session> session = std::make_shared<Session>();
+        if(!fen.empty()) {
+            session->chessState.reset(ChessFen::load(fen));
+            if(!session->chessState) {
+                return false;
+            }
+            session->record.startFen = fen;
+        }
+        else {
+            session->chessState = std::make_unique<ChessGameState>();
+        }
+        session->lastUsed = ++clock;
+        session->active = true;
+        activeCount++;
+        {
+            std::unique_lock<std::shared_mutex> lock{sessionsMutex};
+            id = nextId++;
+            sessions.emplace(id, session);
+        }
+        evictIdle();
+        return true;
+    }
+
+    // See GameServer.h
+    bool SessionManager::close(std::uint64_t id)
+    {
+        std::shared_ptr<Session> session{};
+        {
+            std::unique_lock<std::shared_mutex> lock{sessionsMutex};
+            auto found = sessions.find(id);
+            if(found == sessions.end()) {
+                return false;
+            }
+            session = std::move(found->second);
+            sessions.erase(found);
+        }
+
+        // Wait for requests that are still using the game
+        std::lock_guard<std::mutex> lock{session->mutex};
+        session->closed = true;
+        if(session->chessState) {
+            session->chessState.reset();
+            session->active = false;
+            activeCount--;
+        }
+        return true;
+    }
+
+    // See GameServer.h
+    bool SessionManager::contains(std::uint64_t id)
+    {
+        return find(id) != nullptr;
+    }
+
+    // See GameServer.h
+    bool SessionManager::getLegalMoves(std::uint64_t id, std::vector<std::string>& moves)
+    {
+        moves.clear();
+        std::shared_ptr<Session> session = find(id);
+        if(!session) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock{session->mutex};
+            if(!activate(*session)) {
+                return false;
+            }
+            std::vector<GameState::LegalMove> legalMoves{};
+            session->chessState->generateAllLegalMoves(legalMoves);
+            std::string san{};
+            for(const GameState::LegalMove& legalMove : legalMoves) {
+                if(San::write(*session->chessState, legalMove.start, legalMove.end, legalMove.idx, san)) {
+                    moves.push_back(san);
+                }
+            }
+        }
+        evictIdle();
+        return true;
+    }
+
+    // See GameServer.h
+    bool SessionManager::play(std::uint64_t id, std::string_view san, std::string& played)
+    {
+        std::shared_ptr<Session> session = find(id);
+        if(!session) {
+            return false;
+        }
+        bool moved = false;
+        {
+            std::lock_guard<std::mutex> lock{session->mutex};
+            GameState::LegalMove legalMove{};
+            if(!activate(*session) || !San::parse(*session->chessState, san, legalMove)) {
+                return false;
+            }
+
+            // Write the move before playing it, since San needs the position
+            // it is played from
+            San::write(*session->chessState, legalMove.start, legalMove.end, legalMove.idx, played);
+            std::uint16_t encoded = 0;
+            moved = GameRecord::encodeMove(legalMove.start, legalMove.end, legalMove.idx, encoded)
+                && session->chessState->movePiece(legalMove.start, legalMove.end, legalMove.idx);
+            if(moved) {
+                session->record.moves.push_back(encoded);
+                session->record.result = session->chessState->getResult();
+            }
+        }
+        evictIdle();
+        return moved;
+    }
+
+    // See GameServer.h
+    bool SessionManager::getStatus(std::uint64_t id, Status& status)
+    {
+        std::shared_ptr<Session> session = find(id);
+        if(!session) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock{session->mutex};
+            if(!activate(*session)) {
+                return false;
+            }
+            ChessGameState& chessState = *session->chessState;
+            status.result = chessState.getResult();
+            status.player = chessState.getCrntPlayer();
+            status.plies = session->record.moves.size();
+            ChessFen::write(chessState, status.fen);
+        }
+        evictIdle();
+        return true;
+    }
+
+    // See GameServer.h
+    bool SessionManager::getRecord(std::uint64_t id, GameRecord& record)
+    {
+        std::shared_ptr<Session> session = find(id);
+        if(!session) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{session->mutex};
+        if(session->closed) {
+            return false;
+        }
+        record = session->record;
+        return true;
+    }
+
+    // See GameServer.h
+    SessionManager::Counts SessionManager::getCounts()
+    {
+        Counts counts{};
+        {
+            std::shared_lock<std::shared_mutex> lock{sessionsMutex};
+            counts.sessions = sessions.size();
+        }
+        counts.active = activeCount;
+        counts.evictions = evictions;
+        counts.restores = restores;
+        return counts;
+    }
+
+    // See GameServer.h
+    GameServer::GameServer(Options options) : options{ options }, sessions{ options.sessions } {}
+
+    // See GameServer.h
+    std::string GameServer::handle(std::string_view request)
+    {
+        std::string_view rest = request;
+        std::string_view command = nextWord(rest);
+        if(command == "new") {
+            std::uint64_t id = 0;
+            return sessions.create(rest, id) ? "ok " + std::to_string(id) : "error invalid position";
+        }
+        if(command == "info") {
+            SessionManager::Counts counts = sessions.getCounts();
+            return "ok sessions " + std::to_string(counts.sessions) + " active " + std::to_string(counts.active)
+                + " evictions " + std::to_string(counts.evictions) + " restores " + std::to_string(counts.restores);
+        }
+        if(command != "moves" && command != "play" && command != "status" && command != "close") {
+            return "error unknown command";
+        }
+
+        // Every other request names a game
+        std::uint64_t id = 0;
+        if(!parseId(nextWord(rest), id) || !sessions.contains(id)) {
+            return "error unknown game";
+        }
+        if(command == "moves") {
+            std::vector<std::string> moves{};
+            if(!sessions.getLegalMoves(id, moves)) {
+                return "error unknown game";
+            }
+            std::string response = "ok";
+            for(const std::string& move : moves) {
+                response += " " + move;
+            }
+            return response;
+        }
+        if(command == "play") {
+            std::string played{};
+            return sessions.play(id, rest, played) ? "ok " + played : "error illegal move";
+        }
+        if(command == "status") {
+            SessionManager::Status status{};
+            if(!sessions.getStatus(id, status)) {
+                return "error unknown game";
+            }
+            return std::string{"ok "} + getResultName(status.result) + (status.player == Player::white ? " white " : " black ")
+                + std::to_string(status.plies) + " " + status.fen;
+        }
+        return sessions.close(id) ? "ok" : "error unknown game";
+    }
+
+    // See GameServer.h
+    GameServer::Summary GameServer::run(std::istream& input, std::ostream& output)
+    {
+        ThreadPool pool{options.threadCount};
+        std::size_t maxPending = options.maxPending > 0 ? options.maxPending : 4 * pool.getThreadCount();
+
+        // Finished responses wait here until every earlier response is written
+        Summary summary{};
+        std::mutex outputMutex{};
+        std::map<std::size_t, std::string> finished{};
+        std::size_t nextResponse = 0;
+        auto respond = [&](std::size_t number, std::string response) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            summary.failed += response.compare(0, 5, "error") == 0;
+            finished.emplace(number, std::move(response));
+            while(!finished.empty() && finished.begin()->first == nextResponse) {
+                output << finished.begin()->second << "\n";
+                finished.erase(finished.begin());
+                nextResponse++;
+            }
+            output.flush();
+        };
+
+        // Each request for a game waits for the previous request for the
+        // same game, which always started first since tasks run in order
+        // - New games wait for each other so their ids follow the requests,
+        //   and the first request for a game waits for the games being created
+        std::deque<std::shared_future<void>> pending{};
+        std::unordered_map<std::uint64_t, std::shared_future<void>> lastRequests{};
+        std::shared_future<void> lastNew{};
+        std::string line{};
+        while(std::getline(input, line)) {
+            std::string_view rest = line;
+            std::string_view command = nextWord(rest);
+            if(command.empty()) {
+                continue;
+            }
+            if(command == "quit") {
+                break;
+            }
+            std::uint64_t id = 0;
+            bool hasId = command != "new" && parseId(nextWord(rest), id);
+            std::shared_future<void> previous{};
+            if(command == "new") {
+                previous = lastNew;
+            }
+            else if(hasId) {
+                auto found = lastRequests.find(id);
+                previous = found != lastRequests.end() ? found->second : lastNew;
+            }
+
+            std::size_t number = summary.requests++;
+            std::shared_future<void> request = pool.submit([this, &respond, line, number, previous]() {
+                if(previous.valid()) {
+                    previous.wait();
+                }
+                respond(number, handle(line));
+            }).share();
+            if(command == "new") {
+                lastNew = request;
+            }
+            else if(hasId) {
+                lastRequests[id] = request;
+            }
+            pending.push_back(request);
+
+            // Wait for the oldest requests once too many are in flight, and
+            // forget games whose requests have all finished
+            while(pending.size() >= maxPending) {
+                pending.front().wait();
+                pending.pop_front();
+            }
+            if(lastRequests.size() > 2 * maxPending) {
+                std::erase_if(lastRequests, [](const auto& entry) {
+                    return entry.second.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+                });
+            }
+        }
+        for(std::shared_future<void>& request : pending) {
+            request.wait();
+        }
+        return summary;
+    }
+
+    // See GameServer.h
+    SessionManager& GameServer::getSessions()
+    {
+        return sessions;
+    }
+}
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "MonteCarloSearch.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameState.h"
+#include "Move.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+
+    // See MonteCarloSearch.h
+    MonteCarloSearch::NodePool::NodePool(std::size_t capacity) : nodes{std::make_unique<Node[]>(capacity)}, capacity{capacity}
+    {
+
+    }
+
+    // See MonteCarloSearch.h
+    bool MonteCarloSearch::NodePool::allocate(std::size_t count, std::uint32_t& first)
+    {
+        std::size_t start = used.fetch_add(count);
+        if(start + count > capacity) {
+            used.fetch_sub(count);
+            return false;
+        }
+        first = static_cast<std::uint32_t>(start);
+        return true;
+    }
+
+    // See MonteCarloSearch.h
+    MonteCarloSearch::Node& MonteCarloSearch::NodePool::operator[](std::uint32_t index)
+    {
+        return nodes[index];
+    }
+
+    // See MonteCarloSearch.h
+    std::size_t MonteCarloSearch::NodePool::getUsed()
+    {
+        return std::min(used.load(), capacity);
+    }
+
+    // See MonteCarloSearch.h
+    void MonteCarloSearch::NodePool::clear()
+    {
+        used = 0;
+    }
+
+    // See MonteCarloSearch.h
+    double MonteCarloSearch::Stats::getRolloutsPerSecond() const
+    {
+        return seconds > 0.0 ? static_cast<double>(rollouts) / seconds : 0.0;
+    }
+
+    // See MonteCarloSearch.h
+    MonteCarloSearch::MonteCarloSearch(ChessGameState& chessState, Options options) :
+        chessState{chessState}, options{options}, pool{options.threadCount},
+        nodes{std::make_unique<NodePool>(std::max<std::size_t>(options.maxNodes, 1))},
+        spareNodes{std::make_unique<NodePool>(std::max<std::size_t>(options.maxNodes, 1))}
+    {
+
+    }
+
+    // See MonteCarloSearch.h
+    void MonteCarloSearch::prepareRoot()
+    {
+        std::uint64_t key = chessState.getPositionKey();
+        if(nodes->getUsed() > 0) {
+            Node& root = (*nodes)[0];
+            if(root.key == key && matchesPosition(root)) {
+                return;
+            }
+
+            // Look for the position among the children and grandchildren
+            auto findChild = [this, key](Node& node, std::uint32_t& found) {
+                if(node.state != Node::expanded) {
+                    return false;
+                }
+                for(std::uint32_t i = 0; i < node.childCount; i++) {
+                    Node& child = (*nodes)[node.firstChild + i];
+                    if(child.key == key && matchesPosition(child)) {
+                        found = node.firstChild + i;
+                        return true;
+                    }
+                }
+                return false;
+            };
+            std::uint32_t found = 0;
+            if(findChild(root, found)) {
+                reuseSubtree(found);
+                return;
+            }
+            for(std::uint32_t i = 0; root.state == Node::expanded && i < root.childCount; i++) {
+                if(findChild((*nodes)[root.firstChild + i], found)) {
+                    reuseSubtree(found);
+                    return;
+                }
+            }
+        }
+
+        // Start a new tree
+        nodes->clear();
+        std::uint32_t rootIndex = 0;
+        nodes->allocate(1, rootIndex);
+        Node& root = (*nodes)[rootIndex];
+        root.move = {};
+        root.key = key;
+        root.visits = 0;
+        root.points = 0;
+        root.state = Node::unexpanded;
+        root.childCount = 0;
+    }
+
+    // See MonteCarloSearch.h
+    bool MonteCarloSearch::matchesPosition(Node& node)
+    {
+        if(node.state != Node::expanded) {
+            return true;
+        }
+        std::vector<GameState::LegalMove> legalMoves{};
+        chessState.generateAllLegalMoves(legalMoves);
+        if(legalMoves.size() != node.childCount) {
+            return false;
+        }
+        for(std::uint32_t i = 0; i < node.childCount; i++) {
+            if(std::find(legalMoves.begin(), legalMoves.end(), (*nodes)[node.firstChild + i].move) == legalMoves.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // See MonteCarloSearch.h
+    void MonteCarloSearch::reuseSubtree(std::uint32_t index)
+    {
+        // Copy the subtree breadth first so children stay next to each other
+        spareNodes->clear();
+        std::uint32_t rootIndex = 0;
+        spareNodes->allocate(1, rootIndex);
+        std::deque<std::pair<std::uint32_t, std::uint32_t>> copies{{index, rootIndex}};
+        while(!copies.empty()) {
+            Node& from = (*nodes)[copies.front().first];
+            Node& to = (*spareNodes)[copies.front().second];
+            copies.pop_front();
+            to.move = from.move;
+            to.key = from.key.load();
+            to.visits = from.visits.load();
+            to.points = from.points.load();
+            to.state = from.state == Node::expanded ? Node::expanded : Node::unexpanded;
+            to.childCount = to.state == Node::expanded ? from.childCount : 0;
+            if(to.childCount > 0) {
+                spareNodes->allocate(to.childCount, to.firstChild);
+                for(std::uint32_t i = 0; i < to.childCount; i++) {
+                    copies.emplace_back(from.firstChild + i, to.firstChild + i);
+                }
+            }
+        }
+        std::swap(nodes, spareNodes);
+    }
+
+    // See MonteCarloSearch.h
+    bool MonteCarloSearch::expand(Node& node, ChessGameState& state)
+    {
+        std::uint8_t unexpanded = Node::unexpanded;
+        if(!node.state.compare_exchange_strong(unexpanded, Node::expanding)) {
+            return false;
+        }
+
+        // Give the node back if the pool is full, so it is played out instead
+        std::vector<GameState::LegalMove> legalMoves{};
+        state.generateAllLegalMoves(legalMoves);
+        std::uint32_t first = 0;
+        if(!legalMoves.empty() && !nodes->allocate(legalMoves.size(), first)) {
+            node.state = Node::unexpanded;
+            return false;
+        }
+        for(std::size_t i = 0; i < legalMoves.size(); i++) {
+            Node& child = (*nodes)[first + static_cast<std::uint32_t>(i)];
+            child.move = legalMoves[i];
+            child.key.store(0, std::memory_order_relaxed);
+            child.visits.store(0, std::memory_order_relaxed);
+            child.points.store(0, std::memory_order_relaxed);
+            child.state.store(Node::unexpanded, std::memory_order_relaxed);
+            child.childCount = 0;
+        }
+        node.firstChild = first;
+        node.childCount = static_cast<std::uint32_t>(legalMoves.size());
+        node.state.store(Node::expanded, std::memory_order_release);
+        return true;
+    }
+
+    // See MonteCarloSearch.h
+    MonteCarloSearch::Node& MonteCarloSearch::selectChild(Node& node)
+    {
+        // Unvisited children are tried first
+        double logVisits = std::log(static_cast<double>(std::max<std::uint32_t>(node.visits, 1)));
+        Node* best = &(*nodes)[node.firstChild];
+        double bestScore = -std::numeric_limits<double>::infinity();
+        for(std::uint32_t i = 0; i < node.childCount; i++) {
+            Node& child = (*nodes)[node.firstChild + i];
+            std::uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            if(visits == 0) {
+                return child;
+            }
+            double average = static_cast<double>(child.points.load(std::memory_order_relaxed)) / (2.0 * visits);
+            double score = average + options.exploration * std::sqrt(logVisits / visits);
+            if(score > bestScore) {
+                best = &child;
+                bestScore = score;
+            }
+        }
+        return *best;
+    }
+
+    // See MonteCarloSearch.h
+    bool MonteCarloSearch::rollout(ChessGameState& state, std::mt19937_64& random, Player& loser)
+    {
+        std::vector<GameState::LegalMove> legalMoves{};
+        int made = 0;
+        bool decisive = false;
+        while(true) {
+            ChessGameState::Result result = state.getResult();
+            if(result != ChessGameState::Result::ongoing) {
+                decisive = result == ChessGameState::Result::checkmate;
+                loser = state.getCrntPlayer();
+                break;
+            }
+            if(made >= options.maxRolloutPly) {
+                break;
+            }
+            state.generateAllLegalMoves(legalMoves);
+            if(legalMoves.empty()) {
+                break;
+            }
+            const GameState::LegalMove& legalMove = legalMoves[std::min(options.rolloutPolicy(state, legalMoves, random), legalMoves.size() - 1)];
+            std::vector<Move> moves = state.getMovesOfPiece(legalMove.start, legalMove.end);
+            if(static_cast<std::size_t>(legalMove.idx) >= moves.size()
+                || !state.makeSimulatedMove(legalMove.start, legalMove.end, moves[legalMove.idx])) {
+                break;
+            }
+            made++;
+        }
+        for(int i = 0; i < made; i++) {
+            state.unmakeSimulatedMove();
+        }
+        return decisive;
+    }
+
+    // See MonteCarloSearch.h
+    void MonteCarloSearch::work(ChessGameState& state, std::uint64_t seed, std::atomic<std::int64_t>& count)
+    {
+        std::mt19937_64 random{seed};
+        std::uint32_t virtualLoss = options.virtualLoss;
+
+        // The nodes of the path and the player who made the move into each
+        std::vector<std::pair<Node*, Player>> path{};
+        while(count.fetch_sub(1) > 0) {
+            path.clear();
+            Node* node = &(*nodes)[0];
+            node->visits += virtualLoss;
+            path.emplace_back(node, state.getPlayer(-1));
+            int made = 0;
+            while(node->state.load(std::memory_order_acquire) == Node::expanded && node->childCount > 0) {
+                Node& child = selectChild(*node);
+                child.visits += virtualLoss;
+                Player mover = state.getCrntPlayer();
+                std::vector<Move> moves = state.getMovesOfPiece(child.move.start, child.move.end);
+                if(static_cast<std::size_t>(child.move.idx) >= moves.size()
+                    || !state.makeSimulatedMove(child.move.start, child.move.end, moves[child.move.idx])) {
+                    child.visits -= virtualLoss;
+                    break;
+                }
+                made++;
+                child.key.store(state.getPositionKey(), std::memory_order_relaxed);
+                path.emplace_back(&child, mover);
+                node = &child;
+            }
+
+            // Add the children of the leaf, then play it out
+            if(node->state.load(std::memory_order_acquire) == Node::unexpanded
+                && state.getResult() == ChessGameState::Result::ongoing) {
+                expand(*node, state);
+            }
+            Player loser = state.getCrntPlayer();
+            bool decisive = rollout(state, random, loser);
+            for(int i = 0; i < made; i++) {
+                state.unmakeSimulatedMove();
+            }
+
+            // Replace the virtual losses with the result
+            for(std::pair<Node*, Player>& step : path) {
+                step.first->points += decisive ? (step.second == loser ? 0 : 2) : 1;
+                step.first->visits += 1;
+                step.first->visits -= virtualLoss;
+            }
+        }
+    }
+
+    // See MonteCarloSearch.h
+    MonteCarloSearch::Result MonteCarloSearch::search(std::uint64_t rollouts)
+    {
+        auto start = std::chrono::steady_clock::now();
+        prepareRoot();
+        stats = {};
+        stats.reusedNodes = nodes->getUsed() - 1;
+
+        // Each thread plays on its own copy of the game state, which keeps the
+        // positions before it so rollouts find repetitions. The copies are
+        // made here since copying reads the game state
+        std::atomic<std::int64_t> count{static_cast<std::int64_t>(rollouts)};
+        std::vector<std::future<void>> workers{};
+        std::size_t threadCount = pool.getThreadCount();
+        std::vector<std::unique_ptr<ChessGameState>> states{};
+        for(std::size_t i = 0; i < threadCount; i++) {
+            states.emplace_back(ChessFen::copy(chessState));
+        }
+        for(std::size_t i = 0; i < threadCount; i++) {
+            std::uint64_t seed = options.seed + searches * threadCount + i;
+            workers.push_back(pool.submit([this, state = states[i].get(), &count, seed]() {
+                if(state) {
+                    work(*state, seed, count);
+                }
+            }));
+        }
+        for(std::future<void>& worker : workers) {
+            worker.get();
+        }
+        searches++;
+        stats.rollouts = rollouts;
+        stats.nodes = nodes->getUsed();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Play the most visited move
+        Result result{};
+        Node& root = (*nodes)[0];
+        for(std::uint32_t i = 0; root.state == Node::expanded && i < root.childCount; i++) {
+            Node& child = (*nodes)[root.firstChild + i];
+            if(!result.found || child.visits > result.visits) {
+                result.move = child.move;
+                result.visits = child.visits;
+                result.score = child.visits > 0 ? static_cast<double>(child.points) / (2.0 * child.visits) : 0.0;
+                result.found = true;
+            }
+        }
+        return result;
+    }
+
+    // See MonteCarloSearch.h
+    const MonteCarloSearch::Stats& MonteCarloSearch::getStats()
+    {
+        return stats;
+    }
+
+    // See MonteCarloSearch.h
+    std::size_t MonteCarloSearch::getNodeCount()
+    {
+        return nodes->getUsed();
+    }
+
+    // See MonteCarloSearch.h
+    std::size_t MonteCarloSearch::randomRollout(ChessGameState&, const std::vector<GameState::LegalMove>& legalMoves, std::mt19937_64& random)
+    {
+        return static_cast<std::size_t>(random() % legalMoves.size());
+    }
+}
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "OpeningBook.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "GameState.h"
+#include "MappedFile.h"
+#include "Move.h"
+
+namespace chess {
+    using namespace logic;
+
+    namespace {
+        /*
+        * The bytes at the start of every opening book file
+        */
+        constexpr char magic[4] = {'A', 'C', 'O', 'B'};
+
+        /*
+        * Reads and writes little-endian numbers one byte at a time so the
+        * format does not depend on the machine
+        */
+        std::uint16_t read16(const unsigned char* bytes)
+        {
+            return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+        std::uint64_t read64(const unsigned char* bytes)
+        {
+            std::uint64_t number = 0;
+            for(int i = 7; i >= 0; i--) {
+                number = (number << 8) | bytes[i];
+            }
+            return number;
+        }
+        void write16(unsigned char* bytes, std::uint16_t number)
+        {
+            bytes[0] = static_cast<unsigned char>(number & 0xFF);
+            bytes[1] = static_cast<unsigned char>(number >> 8);
+        }
+        void write64(unsigned char* bytes, std::uint64_t number)
+        {
+            for(int i = 0; i < 8; i++) {
+                bytes[i] = static_cast<unsigned char>((number >> (8 * i)) & 0xFF);
+            }
+        }
+    }
+
+    // See OpeningBook.h
+    bool OpeningBook::open(const std::string& path)
+    {
+        if(!file.open(path, MappedFile::Access::random)) {
+            return false;
+        }
+        return setData(file.getData(), file.getSize());
+    }
+
+    // See OpeningBook.h
+    bool OpeningBook::setData(const unsigned char* data, std::size_t size)
+    {
+        entries = nullptr;
+        entryCount = 0;
+        if(!data || size < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0
+            || read16(data + 4) != version || (size - headerSize) % entrySize != 0) {
+            return false;
+        }
+        entries = data + headerSize;
+        entryCount = (size - headerSize) / entrySize;
+        return true;
+    }
+
+    // See OpeningBook.h
+    std::size_t OpeningBook::getEntryCount()
+    {
+        return entryCount;
+    }
+
+    // See OpeningBook.h
+    std::uint64_t OpeningBook::getKey(std::size_t index)
+    {
+        return read64(entries + index * entrySize);
+    }
+
+    // See OpeningBook.h
+    OpeningBook::Entry OpeningBook::getEntry(std::size_t index)
+    {
+        const unsigned char* entry = entries + index * entrySize;
+        return {read64(entry), read16(entry + 8), read16(entry + 10)};
+    }
+
+    // See OpeningBook.h
+    std::size_t OpeningBook::findMoves(std::uint64_t key, Entry* found, std::size_t maxFound)
+    {
+        // Narrow down to the first entry with at least the key by guessing
+        // where the key falls between the keys at either end, and fall back to
+        // halving the range whenever a guess does not shrink it enough
+        std::size_t low = 0;
+        std::size_t high = entryCount;
+        while(high - low > 8) {
+            std::uint64_t lowKey = getKey(low);
+            std::uint64_t highKey = getKey(high - 1);
+            if(key <= lowKey) {
+                break;
+            }
+            if(key > highKey) {
+                low = high;
+                break;
+            }
+            double fraction = static_cast<double>(key - lowKey) / static_cast<double>(highKey - lowKey);
+            std::size_t guess = low + static_cast<std::size_t>(fraction * static_cast<double>(high - 1 - low));
+            guess = std::min(std::max(guess, low), high - 1);
+            std::size_t previousRange = high - low;
+            if(getKey(guess) < key) {
+                low = guess + 1;
+            }
+            else {
+                high = guess;
+            }
+            if(high - low > previousRange / 2) {
+                std::size_t middle = low + (high - low) / 2;
+                if(getKey(middle) < key) {
+                    low = middle + 1;
+                }
+                else {
+                    high = middle;
+                }
+            }
+        }
+        while(low < entryCount && getKey(low) < key) {
+            low++;
+        }
+
+        // Copy every entry of the position
+        std::size_t count = 0;
+        for(std::size_t index = low; index < entryCount && getKey(index) == key; index++) {
+            if(count < maxFound) {
+                found[count] = getEntry(index);
+            }
+            count++;
+        }
+        return count;
+    }
+    std::size_t OpeningBook::findMoves(ChessGameState& chessState, Entry* found, std::size_t maxFound)
+    {
+        return findMoves(chessState.getPositionKey(), found, maxFound);
+    }
+
+    // See OpeningBook.h
+    bool OpeningBook::pickMove(ChessGameState& chessState, std::uint64_t random, std::vector<GameState::LegalMove>& legalMoves, GameState::LegalMove& legalMove)
+    {
+        Entry found[maxPositionMoves];
+        std::size_t count = std::min(findMoves(chessState, found, maxPositionMoves), maxPositionMoves);
+        if(count == 0) {
+            return false;
+        }
+
+        // Leave out moves that are not legal, remembering where each legal
+        // move is so it does not have to be found again
+        chessState.generateAllLegalMoves(legalMoves);
+        std::size_t legalIndices[maxPositionMoves];
+        std::uint64_t totalWeight = 0;
+        for(std::size_t i = 0; i < count; i++) {
+            Move::position start{};
+            Move::position end{};
+            int idx = 0;
+            GameRecord::decodeMove(found[i].move, start, end, idx);
+            auto legal = std::find_if(legalMoves.begin(), legalMoves.end(), [&](const GameState::LegalMove& candidate) {
+                return candidate.start == start && candidate.end == end && candidate.idx == idx;
+            });
+            if(legal == legalMoves.end()) {
+                found[i].weight = 0;
+            }
+            legalIndices[i] = static_cast<std::size_t>(legal - legalMoves.begin());
+            totalWeight += found[i].weight;
+        }
+        if(totalWeight == 0) {
+            return false;
+        }
+
+        // Pick a move with probability proportional to its weight
+        std::uint64_t target = random % totalWeight;
+        for(std::size_t i = 0; i < count; i++) {
+            if(target >= found[i].weight) {
+                target -= found[i].weight;
+                continue;
+            }
+            legalMove = legalMoves[legalIndices[i]];
+            return true;
+        }
+        return false;
+    }
+
+    // See OpeningBook.h
+    void OpeningBookBuilder::add(std::uint64_t key, std::uint16_t move, std::uint16_t weight)
+    {
+        entries.push_back({key, move, weight});
+    }
+
+    // See OpeningBook.h
+    bool OpeningBookBuilder::addGame(const GameRecordReader::Game& game, std::uint32_t maxPly)
+    {
+        std::unique_ptr<ChessGameState> chessState{game.startFen.empty() ? new ChessGameState() : ChessFen::load(game.startFen)};
+        if(!chessState) {
+            return false;
+        }
+        std::uint32_t plies = std::min(game.plyCount, maxPly);
+        for(std::uint32_t ply = 0; ply < plies; ply++) {
+            // The player who made the last move of a checkmate won
+            std::uint16_t weight = 1;
+            if(game.result == ChessGameState::Result::checkmate) {
+                weight = (game.plyCount - 1 - ply) % 2 == 0 ? 2 : 0;
+            }
+            Move::position start{};
+            Move::position end{};
+            int idx = 0;
+            std::uint16_t encoded = 0;
+            game.getMove(ply, start, end, idx);
+            GameRecord::encodeMove(start, end, idx, encoded);
+            std::uint64_t key = chessState->getPositionKey();
+            if(!chessState->movePiece(start, end, idx)) {
+                return false;
+            }
+            add(key, encoded, weight);
+        }
+        return true;
+    }
+
+    // See OpeningBook.h
+    std::size_t OpeningBookBuilder::getAddedCount()
+    {
+        return entries.size();
+    }
+
+    // See OpeningBook.h
+    bool OpeningBookBuilder::write(std::ostream& output)
+    {
+        unsigned char header[OpeningBook::headerSize]{};
+        std::memcpy(header, magic, sizeof(magic));
+        write16(header + 4, OpeningBook::version);
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        std::sort(entries.begin(), entries.end(), [](const OpeningBook::Entry& first, const OpeningBook::Entry& second) {
+            return first.key != second.key ? first.key < second.key : first.move < second.move;
+        });
+
+        // Merge the weights of each move, stopping at the largest weight
+        unsigned char entry[OpeningBook::entrySize]{};
+        for(std::size_t i = 0; i < entries.size();) {
+            std::uint32_t weight = 0;
+            std::size_t next = i;
+            for(; next < entries.size() && entries[next].key == entries[i].key && entries[next].move == entries[i].move; next++) {
+                weight = std::min<std::uint32_t>(weight + entries[next].weight, UINT16_MAX);
+            }
+            if(weight > 0) {
+                write64(entry, entries[i].key);
+                write16(entry + 8, entries[i].move);
+                write16(entry + 10, static_cast<std::uint16_t>(weight));
+                output.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+            }
+            i = next;
+        }
+        return output.good();
+    }
+}
@@ -0,0 +1,255 @@
+#include <cctype>
+#include <deque>
+#include <functional>
+#include <future>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Pgn.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "GameState.h"
+#include "San.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+
+    namespace {
+        /*
+        * Returns whether the inputted character ends a move token
+        */
+        bool endsToken(int c)
+        {
+            return c == std::char_traits<char>::eof() || std::isspace(c) || c == '[' || c == ']'
+                || c == '{' || c == '}' || c == '(' || c == ')' || c == ';';
+        }
+
+        /*
+        * Skips characters up to and including the inputted character
+        */
+        void skipPast(std::istream& input, char end)
+        {
+            input.ignore(std::numeric_limits<std::streamsize>::max(), end);
+        }
+
+        /*
+        * Returns the move in a token without its move number, ex: e4 for 1.e4,
+        * or an empty string if the token is only a move number
+        */
+        std::string_view stripMoveNumber(std::string_view token)
+        {
+            std::size_t digits = 0;
+            while(digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits]))) {
+                digits++;
+            }
+            if(digits < token.size() && token[digits] != '.') {
+                return token; // Castling with zeros, ex: 0-0
+            }
+            std::size_t dots = token.find_first_not_of('.', digits);
+            return dots == std::string_view::npos ? std::string_view{} : token.substr(dots);
+        }
+    }
+
+    // See Pgn.h
+    std::string_view PgnGame::getTag(std::string_view name) const
+    {
+        for(const std::pair<std::string, std::string>& tag : tags) {
+            if(tag.first == name) {
+                return tag.second;
+            }
+        }
+        return {};
+    }
+
+    // See Pgn.h
+    PgnReader::PgnReader(std::istream& input) : input{ input } {}
+
+    // See Pgn.h
+    bool PgnReader::next(PgnGame& game)
+    {
+        game = PgnGame{};
+        bool started = false;
+        bool lineStart = true;
+        std::string token{};
+        while(true) {
+            int c = input.peek();
+            if(c == std::char_traits<char>::eof()) {
+                return started;
+            }
+
+            // Escape lines start with % in the first column
+            if(c == '%' && lineStart) {
+                skipPast(input, '\n');
+                continue;
+            }
+            lineStart = c == '\n';
+            if(std::isspace(c)) {
+                input.get();
+                continue;
+            }
+
+            switch(c) {
+                // Tag pairs, ex: [White "Carlsen"]
+                case '[': {
+                    // A tag after the moves starts the next game
+                    if(!game.moves.empty()) {
+                        return true;
+                    }
+                    input.get();
+                    std::string name{};
+                    while(!endsToken(input.peek()) && input.peek() != '"') {
+                        name.push_back(static_cast<char>(input.get()));
+                    }
+                    std::string value{};
+                    while(input.peek() != std::char_traits<char>::eof() && input.peek() != '"' && input.peek() != ']') {
+                        input.get();
+                    }
+                    if(input.peek() == '"') {
+                        input.get();
+                        for(int next = input.get(); next != std::char_traits<char>::eof() && next != '"'; next = input.get()) {
+                            if(next == '\\' && input.peek() != std::char_traits<char>::eof()) {
+                                next = input.get();
+                            }
+                            value.push_back(static_cast<char>(next));
+                        }
+                    }
+                    skipPast(input, ']');
+                    game.tags.emplace_back(std::move(name), std::move(value));
+                    started = true;
+                    break;
+                }
+
+                // Comments
+                case '{':
+                    skipPast(input, '}');
+                    break;
+                case ';':
+                    skipPast(input, '\n');
+                    lineStart = true;
+                    break;
+
+                // Variations, which may hold comments and other variations
+                case '(': {
+                    int depth = 0;
+                    for(int next = input.get(); next != std::char_traits<char>::eof(); next = input.get()) {
+                        if(next == '{') {
+                            skipPast(input, '}');
+                        }
+                        depth += (next == '(') - (next == ')');
+                        if(depth == 0) {
+                            break;
+                        }
+                    }
+                    break;
+                }
+                case ')':
+                case ']':
+                case '}':
+                    input.get();
+                    break;
+
+                // Moves, move numbers, annotation glyphs, and results
+                default: {
+                    token.clear();
+                    while(!endsToken(input.peek())) {
+                        token.push_back(static_cast<char>(input.get()));
+                    }
+                    if(token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*") {
+                        game.result = token;
+                        return true;
+                    }
+                    std::string_view move = stripMoveNumber(token);
+                    if(move.empty() || move.front() == '$') {
+                        break;
+                    }
+                    game.moves.emplace_back(move);
+                    started = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // See Pgn.h
+    PgnImporter::PgnImporter(Options options) : options{ options } {}
+
+    // See Pgn.h
+    PgnImporter::ImportedGame PgnImporter::validate(PgnGame game)
+    {
+        ImportedGame imported{};
+        imported.game = std::move(game);
+        std::string_view fen = imported.game.getTag("FEN");
+        std::unique_ptr<ChessGameState> chessState{fen.empty() ? new ChessGameState() : ChessFen::load(fen)};
+        if(!chessState) {
+            imported.error = "invalid FEN";
+            return imported;
+        }
+        imported.record.startFen = fen;
+
+        // Replay the moves
+        for(std::size_t ply = 0; ply < imported.game.moves.size(); ply++) {
+            const std::string& san = imported.game.moves[ply];
+            GameState::LegalMove move{};
+            if(!San::parse(*chessState, san, move)) {
+                imported.error = "illegal or ambiguous move " + san;
+            }
+            else if(!imported.record.addMove(move.start, move.end, move.idx)) {
+                imported.error = "move cannot be stored " + san;
+            }
+            else if(!chessState->movePiece(move.start, move.end, move.idx)) {
+                imported.record.moves.pop_back();
+                imported.error = "move cannot be played " + san;
+            }
+            if(!imported.error.empty()) {
+                imported.failedPly = static_cast<int>(ply);
+                imported.record.result = chessState->getResult();
+                return imported;
+            }
+        }
+        imported.record.result = chessState->getResult();
+        imported.valid = true;
+        return imported;
+    }
+
+    // See Pgn.h
+    PgnImporter::Summary PgnImporter::run(std::istream& input, const std::function<void(const ImportedGame&)>& onGame)
+    {
+        ThreadPool pool{options.threadCount};
+        std::size_t maxPending = options.maxPending > 0 ? options.maxPending : 4 * pool.getThreadCount();
+
+        // Games are reported in order, so the oldest game is waited on once
+        // too many are in flight
+        Summary summary{};
+        std::deque<std::future<ImportedGame>> pending{};
+        auto reportOldest = [&]() {
+            ImportedGame imported = pending.front().get();
+            pending.pop_front();
+            summary.invalid += !imported.valid;
+            onGame(imported);
+        };
+
+        PgnReader reader{input};
+        PgnGame game{};
+        while(reader.next(game)) {
+            std::size_t index = summary.games++;
+            pending.push_back(pool.submit([game = std::move(game), index]() mutable {
+                ImportedGame imported = validate(std::move(game));
+                imported.index = index;
+                return imported;
+            }));
+            while(pending.size() >= maxPending) {
+                reportOldest();
+            }
+        }
+        while(!pending.empty()) {
+            reportOldest();
+        }
+        return summary;
+    }
+}
@@ -0,0 +1,338 @@
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "San.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    namespace {
+        /*
+        * The letters of each piece ID
+        */
+        constexpr std::string_view pieceLetters = "?KBNPQRO";
+
+        /*
+        * Returns the ID of the piece with the inputted letter, or 0 for pawns
+        * and letters that are not pieces
+        */
+        Piece::ID getPieceID(char letter)
+        {
+            std::size_t id = pieceLetters.find(letter);
+            return id == std::string_view::npos || id == 0 || id == PAWN_ID ? 0 : static_cast<Piece::ID>(id);
+        }
+
+        /*
+        * Reads a square like e4, returning false if it is not on the board
+        */
+        bool parseSquare(std::string_view text, Move::position& square)
+        {
+            if(text.size() != 2 || text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8') {
+                return false;
+            }
+            square = std::make_pair(text[0] - 'a' + 1, text[1] - '0');
+            return true;
+        }
+
+        /*
+        * Appends a square like e4 to the inputted string
+        */
+        void appendSquare(std::string& text, Move::position square)
+        {
+            text.push_back(static_cast<char>('a' + square.first - 1));
+            text.push_back(static_cast<char>('0' + square.second));
+        }
+
+        /*
+        * What a move leaves behind, found by simulating it
+        */
+        struct Simulated
+        {
+            Piece::ID resultID{0};
+            bool captured{false};
+            bool probeEmpty{false};
+        };
+
+        /*
+        * Simulates a move to find the ID of the piece left on the end square,
+        * whether an opponent's piece was captured, and whether the probe
+        * square is empty afterwards
+        */
+        bool simulate(ChessGameState& chessState, Move::position start, Move::position end, Move& move, Move::position probe, Simulated& simulated)
+        {
+            std::vector<Player> opponents{};
+            std::size_t opponentPieces = 0;
+            for(int i = 1; i < chessState.getPlayerCount(); i++) {
+                opponents.push_back(chessState.getPlayer(i));
+                opponentPieces += chessState.getBoard()->getPiecesOfPlayer(opponents.back()).size();
+            }
+            if(!chessState.makeSimulatedMove(start, end, move)) {
+                return false;
+            }
+            GameBoard* board = chessState.getBoard();
+            Piece* piece = board->getPiece(end);
+            simulated.resultID = piece ? piece->getID() : 0;
+            std::size_t remaining = 0;
+            for(Player opponent : opponents) {
+                remaining += board->getPiecesOfPlayer(opponent).size();
+            }
+            simulated.captured = remaining < opponentPieces;
+            simulated.probeEmpty = board->getPiece(probe) == nullptr;
+            chessState.unmakeSimulatedMove();
+            return true;
+        }
+
+        /*
+        * Returns whether a knight can jump between the inputted squares
+        */
+        bool isKnightJump(Move::position first, Move::position second)
+        {
+            int dx = std::abs(first.first - second.first);
+            int dy = std::abs(first.second - second.second);
+            return (dx == 1 && dy == 2) || (dx == 2 && dy == 1);
+        }
+    }
+
+    // See San.h
+    bool San::parse(ChessGameState& chessState, std::string_view san, GameState::LegalMove& legalMove)
+    {
+        // Ignore checks and annotations
+        while(!san.empty() && std::string_view{"+#!? "}.find(san.back()) != std::string_view::npos) {
+            san.remove_suffix(1);
+        }
+        while(!san.empty() && san.front() == ' ') {
+            san.remove_prefix(1);
+        }
+        if(san.empty()) {
+            return false;
+        }
+
+        // Castling moves the king 2 spaces
+        if(san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+            Piece* king = chessState.getKing();
+            if(!king) {
+                return false;
+            }
+            Move::position start = king->getPosition();
+            Move::position end = std::make_pair(start.first + (san.size() == 3 ? 2 : -2), start.second);
+            if(!chessState.canMovePiece(start, end)) {
+                return false;
+            }
+            std::vector<Move> moves = chessState.getMovesOfPiece(start, end);
+            legalMove = {start, end, 0, moves[0].getPriority()};
+            return true;
+        }
+
+        // Read the moving piece and the promotion
+        Piece::ID movingID = getPieceID(san.front());
+        if(movingID != 0) {
+            san.remove_prefix(1);
+        }
+        else {
+            movingID = PAWN_ID;
+        }
+        std::size_t equals = san.find('=');
+        std::string_view promotion = equals == std::string_view::npos ? std::string_view{} : san.substr(equals + 1);
+        std::string_view main = san.substr(0, equals);
+
+        // Read the destination and any disambiguation, skipping captures
+        char text[4]{};
+        std::size_t length = 0;
+        for(char c : main) {
+            if(c == 'x' || c == ':' || c == '-') {
+                continue;
+            }
+            if(length == sizeof(text)) {
+                return false;
+            }
+            text[length++] = c;
+        }
+        Move::position end{};
+        if(length < 2 || !parseSquare(std::string_view{text + length - 2, 2}, end)) {
+            return false;
+        }
+        int fromX = 0;
+        int fromY = 0;
+        for(std::size_t i = 0; i + 2 < length; i++) {
+            if('a' <= text[i] && text[i] <= 'h') {
+                fromX = text[i] - 'a' + 1;
+            }
+            else if('1' <= text[i] && text[i] <= '8') {
+                fromY = text[i] - '0';
+            }
+            else {
+                return false;
+            }
+        }
+
+        // Pawns stay in their file unless they capture
+        if(movingID == PAWN_ID && fromX == 0) {
+            fromX = end.first;
+        }
+
+        // Read what the piece becomes
+        Piece::ID resultID = movingID;
+        bool boosts = false;
+        Move::position probe = end;
+        if(!promotion.empty()) {
+            resultID = getPieceID(promotion.front());
+            promotion.remove_prefix(1);
+            if(!promotion.empty() && promotion.front() == 'x') {
+                promotion.remove_prefix(1);
+            }
+            bool promotes = movingID == PAWN_ID && resultID != 0 && resultID != KING_ID;
+            bool fuses = movingID == KNIGHT_ID && resultID == KNOOK_ID;
+            boosts = promotes && resultID == KNIGHT_ID && !promotion.empty();
+            if((!promotes && !fuses) || (!promotion.empty() && !boosts)) {
+                return false;
+            }
+
+            // Knight boosts end where the knight jumps to, and the square behind
+            // the promotion square is left empty by the pawn's last step
+            if(boosts) {
+                Move::position boostSquare = end;
+                if(!parseSquare(promotion, end) || !isKnightJump(boostSquare, end)
+                    || (boostSquare.second != 1 && boostSquare.second != 8)) {
+                    return false;
+                }
+                probe = std::make_pair(boostSquare.first, boostSquare.second == 8 ? 7 : 2);
+            }
+        }
+
+        // Find the moves that match
+        bool found = false;
+        for(Move::position start : chessState.getPiecesOfCrntPlayer()) {
+            Piece* piece = chessState.getBoard()->getPiece(start);
+            if(piece->getID() != movingID || start == end || (fromX != 0 && start.first != fromX) || (fromY != 0 && start.second != fromY)) {
+                continue;
+            }
+            if(!chessState.canMovePiece(start, end)) {
+                continue;
+            }
+            std::vector<Move> moves = chessState.getMovesOfPiece(start, end);
+            for(std::size_t idx = 0; idx < moves.size(); idx++) {
+                // Only simulate moves that could leave a different piece behind
+                if(moves.size() > 1 || resultID != movingID) {
+                    Simulated simulated{};
+                    if(!simulate(chessState, start, end, moves[idx], probe, simulated) || simulated.resultID != resultID
+                        || (boosts && !simulated.probeEmpty)) {
+                        continue;
+                    }
+                }
+                if(found) {
+                    return false; // Ambiguous
+                }
+                legalMove = {start, end, static_cast<int>(idx), moves[idx].getPriority()};
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // See San.h
+    bool San::write(ChessGameState& chessState, Move::position start, Move::position end, int idx, std::string& san)
+    {
+        san.clear();
+        GameBoard* board = chessState.getBoard();
+        Piece* piece = board->getPiece(start);
+        if(!piece || !piece->getPlayerAccess(chessState.getCrntPlayer())) {
+            return false;
+        }
+        std::vector<Move> moves = chessState.getMovesOfPiece(start, end);
+        if(idx < 0 || static_cast<std::size_t>(idx) >= moves.size()) {
+            return false;
+        }
+        Piece::ID movingID = piece->getID();
+        Simulated simulated{};
+        if(!simulate(chessState, start, end, moves[idx], end, simulated)) {
+            return false;
+        }
+        Piece::ID resultID = simulated.resultID;
+
+        // Castling
+        if(movingID == KING_ID && std::abs(end.first - start.first) == 2 && end.second == start.second) {
+            san = end.first > start.first ? "O-O" : "O-O-O";
+            return true;
+        }
+
+        if(movingID == PAWN_ID) {
+            // Knight boosts name the promotion square they jump from, which is
+            // the one whose square behind the pawn's last step leaves empty
+            int lastY = piece->getPlayerAccess(Player::white) ? 8 : 1;
+            if(resultID == KNIGHT_ID && end.second != lastY) {
+                for(int dx : {0, -1, 1}) {
+                    Move::position boostSquare = std::make_pair(start.first + dx, lastY);
+                    Move::position probe = std::make_pair(boostSquare.first, lastY == 8 ? 7 : 2);
+                    Simulated boosted{};
+                    if(!isKnightJump(boostSquare, end) || !simulate(chessState, start, end, moves[idx], probe, boosted)
+                        || !boosted.probeEmpty) {
+                        continue;
+                    }
+                    if(dx != 0) {
+                        san.push_back(static_cast<char>('a' + start.first - 1));
+                        san.push_back('x');
+                    }
+                    appendSquare(san, boostSquare);
+                    san += "=N";
+                    if(simulated.captured) {
+                        san.push_back('x');
+                    }
+                    appendSquare(san, end);
+                    return true;
+                }
+                return false;
+            }
+
+            // Pawns that change file always capture
+            if(start.first != end.first) {
+                san.push_back(static_cast<char>('a' + start.first - 1));
+                san.push_back('x');
+            }
+            appendSquare(san, end);
+            if(resultID != PAWN_ID) {
+                san.push_back('=');
+                san.push_back(pieceLetters[resultID]);
+            }
+            return true;
+        }
+
+        // Add the file, rank, or both of the start if another piece of the same
+        // type could move to the same square
+        san.push_back(pieceLetters[movingID]);
+        bool sameFile = false;
+        bool sameRank = false;
+        bool ambiguous = false;
+        for(Move::position other : chessState.getPiecesOfCrntPlayer()) {
+            if(other == start || other == end || board->getPiece(other)->getID() != movingID || !chessState.canMovePiece(other, end)) {
+                continue;
+            }
+            ambiguous = true;
+            sameFile |= other.first == start.first;
+            sameRank |= other.second == start.second;
+        }
+        if(ambiguous && (!sameFile || sameRank)) {
+            san.push_back(static_cast<char>('a' + start.first - 1));
+        }
+        if(ambiguous && sameFile) {
+            san.push_back(static_cast<char>('0' + start.second));
+        }
+        if(simulated.captured) {
+            san.push_back('x');
+        }
+        appendSquare(san, end);
+        if(resultID != movingID) {
+            san.push_back('=');
+            san.push_back(pieceLetters[resultID]);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,1101 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Tablebase.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "GameBoard.h"
+#include "MappedFile.h"
+#include "Piece.h"
+#include "Search.h"
+#include "ThreadPool.h"
+
+namespace chess {
+    using namespace logic;
+    using Player = Piece::Player;
+
+    namespace {
+        /*
+        * The bytes at the start of every table file
+        */
+        constexpr char magic[4] = {'A', 'C', 'T', 'B'};
+        constexpr std::size_t headerSize = 16;
+
+        /*
+        * Reads and writes little-endian numbers one byte at a time so the
+        * format does not depend on the machine
+        */
+        std::uint16_t read16(const unsigned char* bytes)
+        {
+            return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+        std::uint32_t read32(const unsigned char* bytes)
+        {
+            return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+                | (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        }
+        void write16(unsigned char* bytes, std::uint16_t number)
+        {
+            bytes[0] = static_cast<unsigned char>(number & 0xFF);
+            bytes[1] = static_cast<unsigned char>(number >> 8);
+        }
+        void write32(unsigned char* bytes, std::uint32_t number)
+        {
+            for(int i = 0; i < 4; i++) {
+                bytes[i] = static_cast<unsigned char>((number >> (8 * i)) & 0xFF);
+            }
+        }
+
+        /*
+        * Finds the length of the Huffman code of each value from the number
+        * of times it appears, giving a lone value a 1 bit code
+        * - Returns false if a code is longer than Tablebase::maxCodeLength
+        */
+        bool getCodeLengths(const std::uint64_t* counts, unsigned char* lengths)
+        {
+            // Repeatedly merge the 2 least common nodes, where the first 256
+            // nodes are the values and each merge adds a node
+            std::vector<std::pair<std::uint64_t, int>> queue{};
+            std::vector<int> parents(256, -1);
+            for(int value = 0; value < 256; value++) {
+                if(counts[value] > 0) {
+                    queue.emplace_back(counts[value], value);
+                }
+            }
+            std::fill(lengths, lengths + 256, 0);
+            if(queue.size() == 1) {
+                lengths[queue[0].second] = 1;
+                return true;
+            }
+            auto greater = [](const std::pair<std::uint64_t, int>& a, const std::pair<std::uint64_t, int>& b) {
+                return a > b;
+            };
+            std::make_heap(queue.begin(), queue.end(), greater);
+            while(queue.size() > 1) {
+                std::pop_heap(queue.begin(), queue.end(), greater);
+                std::pair<std::uint64_t, int> first = queue.back();
+                queue.pop_back();
+                std::pop_heap(queue.begin(), queue.end(), greater);
+                std::pair<std::uint64_t, int> second = queue.back();
+                queue.pop_back();
+                int merged = static_cast<int>(parents.size());
+                parents.push_back(-1);
+                parents[first.second] = merged;
+                parents[second.second] = merged;
+                queue.emplace_back(first.first + second.first, merged);
+                std::push_heap(queue.begin(), queue.end(), greater);
+            }
+
+            // The length of a code is the depth of its value
+            for(int value = 0; value < 256; value++) {
+                if(counts[value] == 0) {
+                    continue;
+                }
+                int depth = 0;
+                for(int node = parents[value]; node >= 0; node = parents[node]) {
+                    depth++;
+                }
+                if(depth > Tablebase::maxCodeLength) {
+                    return false;
+                }
+                lengths[value] = static_cast<unsigned char>(depth);
+            }
+            return true;
+        }
+
+        /*
+        * The pieces a table can hold, strongest first, which is the order
+        * they are stored in
+        */
+        constexpr Piece::ID pieceOrder[] = {KING_ID, QUEEN_ID, KNOOK_ID, ROOK_ID, BISHOP_ID, KNIGHT_ID};
+        constexpr std::string_view pieceLetters = "KQORBN";
+
+        /*
+        * Returns the place of a piece in pieceOrder, or -1 if tables cannot
+        * hold it
+        */
+        int getRank(Piece::ID id)
+        {
+            for(int i = 0; i < static_cast<int>(std::size(pieceOrder)); i++) {
+                if(pieceOrder[i] == id) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        /*
+        * The pieces of each side of a table, white first, each in pieceOrder
+        */
+        struct Material
+        {
+            std::vector<Piece::ID> sides[2]{};
+
+            int getPieceCount() const
+            {
+                return static_cast<int>(sides[0].size() + sides[1].size());
+            }
+
+            std::string toString() const
+            {
+                std::string text{};
+                for(int side = 0; side < 2; side++) {
+                    for(Piece::ID id : sides[side]) {
+                        text.push_back(pieceLetters[getRank(id)]);
+                    }
+                    text += side == 0 ? "v" : "";
+                }
+                return text;
+            }
+
+            void sort()
+            {
+                for(std::vector<Piece::ID>& side : sides) {
+                    std::sort(side.begin(), side.end(), [](Piece::ID first, Piece::ID second) {
+                        return getRank(first) < getRank(second);
+                    });
+                }
+            }
+
+            /*
+            * Puts the stronger side first and returns whether the sides were
+            * swapped
+            */
+            bool canonicalize()
+            {
+                sort();
+                const std::vector<Piece::ID>& white = sides[0];
+                const std::vector<Piece::ID>& black = sides[1];
+                bool swap = false;
+                if(white.size() != black.size()) {
+                    swap = black.size() > white.size();
+                }
+                else {
+                    for(std::size_t i = 0; i < white.size(); i++) {
+                        if(white[i] != black[i]) {
+                            swap = getRank(black[i]) < getRank(white[i]);
+                            break;
+                        }
+                    }
+                }
+                if(swap) {
+                    std::swap(sides[0], sides[1]);
+                }
+                return swap;
+            }
+        };
+
+        /*
+        * Reads material like KQvKR, returning false if it is not valid
+        */
+        bool parseMaterial(std::string_view text, Material& material)
+        {
+            material = Material{};
+            std::size_t split = text.find('v');
+            if(split == std::string_view::npos) {
+                return false;
+            }
+            for(int side = 0; side < 2; side++) {
+                std::string_view letters = side == 0 ? text.substr(0, split) : text.substr(split + 1);
+                int kings = 0;
+                for(char letter : letters) {
+                    std::size_t rank = pieceLetters.find(letter);
+                    if(rank == std::string_view::npos) {
+                        return false;
+                    }
+                    kings += rank == 0;
+                    material.sides[side].push_back(pieceOrder[rank]);
+                }
+                if(kings != 1) {
+                    return false;
+                }
+            }
+            material.sort();
+            return material.getPieceCount() <= Tablebase::maxPieces;
+        }
+
+        /*
+        * A piece of a table and the side it belongs to
+        */
+        struct Slot
+        {
+            int side{0};
+            Piece::ID id{0};
+        };
+
+        /*
+        * Returns the pieces of a table in the order they are indexed
+        */
+        std::vector<Slot> getSlots(const Material& material)
+        {
+            std::vector<Slot> slots{};
+            for(int side = 0; side < 2; side++) {
+                for(Piece::ID id : material.sides[side]) {
+                    slots.push_back({side, id});
+                }
+            }
+            return slots;
+        }
+
+        /*
+        * The movement of each type of piece
+        */
+        constexpr int kingSteps[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+        constexpr int knightJumps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+        constexpr int rookRays[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        constexpr int bishopRays[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+
+        /*
+        * Calls visit(target) for every square a piece on start can reach or
+        * attack, where rays stop at (and include) the first occupied square
+        * - Squares are numbered y * 8 + x from 0, and occupant holds the slot
+        *   on each square or -1
+        * - Stops early once visit() returns true, and returns whether it did
+        */
+        template <typename Visit>
+        bool forEachTarget(Piece::ID id, int start, const int* occupant, Visit visit)
+        {
+            int x = start % 8;
+            int y = start / 8;
+            auto step = [&](const int (*deltas)[2], int count, bool slide) {
+                for(int i = 0; i < count; i++) {
+                    int targetX = x + deltas[i][0];
+                    int targetY = y + deltas[i][1];
+                    while(0 <= targetX && targetX < 8 && 0 <= targetY && targetY < 8) {
+                        int target = targetY * 8 + targetX;
+                        if(visit(target)) {
+                            return true;
+                        }
+                        if(!slide || occupant[target] >= 0) {
+                            break;
+                        }
+                        targetX += deltas[i][0];
+                        targetY += deltas[i][1];
+                    }
+                }
+                return false;
+            };
+            switch(id) {
+                case KING_ID:
+                    return step(kingSteps, 8, false);
+                case KNIGHT_ID:
+                    return step(knightJumps, 8, false);
+                case BISHOP_ID:
+                    return step(bishopRays, 4, true);
+                case ROOK_ID:
+                    return step(rookRays, 4, true);
+                case QUEEN_ID:
+                    return step(rookRays, 4, true) || step(bishopRays, 4, true);
+                case KNOOK_ID:
+                    // Knooks slide diagonally in this engine (see Knook.cpp)
+                    return step(bishopRays, 4, true) || step(knightJumps, 8, false);
+            }
+            return false;
+        }
+
+        /*
+        * How to find a position in the table that a capture or Knooklear
+        * fusion leads to
+        * - slots holds the slot of this table whose square is used for each
+        *   slot of the other table
+        */
+        struct Transition
+        {
+            const std::vector<std::uint8_t>* table{nullptr};
+            bool swapped{false};
+            int count{0};
+            int slots[Tablebase::maxPieces]{};
+        };
+
+        /*
+        * A solved position waiting to be claimed at a distance
+        */
+        struct Pending
+        {
+            std::uint64_t index{0};
+            int distance{0};
+            bool win{false};
+
+            std::uint8_t getValue() const
+            {
+                return static_cast<std::uint8_t>(win ? distance : Tablebase::lossValue + distance);
+            }
+        };
+
+        /*
+        * Solves every position of a single table
+        */
+        class TableBuilder
+        {
+            private:
+                std::vector<Slot> slots;
+                int count;
+                std::uint64_t sideSize;
+                std::uint64_t powers[Tablebase::maxPieces]{};
+                int kings[2]{};
+
+                /*
+                * Tables reached by capturing a slot, and by fusing a knight
+                * slot into a rook slot
+                */
+                std::vector<Transition> captures{};
+                std::vector<std::vector<Transition>> fusions{};
+
+                /*
+                * The value of each position (0 until solved), the number of
+                * moves in the table each position has that are not yet known
+                * to lose, and the least distance a loss can have because of
+                * captures (or 255 if captures keep the position from losing)
+                */
+                std::unique_ptr<std::atomic<std::uint8_t>[]> values{};
+                std::unique_ptr<std::atomic<std::uint8_t>[]> counters{};
+                std::unique_ptr<std::uint8_t[]> lossFloors{};
+                static constexpr std::uint8_t noLoss = 255;
+
+            public:
+                TableBuilder(const Material& material) : slots{ getSlots(material) }
+                {
+                    count = static_cast<int>(slots.size());
+                    sideSize = std::uint64_t{1} << (6 * count);
+                    for(int i = 0; i < count; i++) {
+                        powers[i] = std::uint64_t{1} << (6 * (count - 1 - i));
+                    }
+                    kings[0] = 0;
+                    kings[1] = static_cast<int>(material.sides[0].size());
+                    captures.resize(count);
+                    fusions.resize(count, std::vector<Transition>(count));
+                }
+
+                /*
+                * Returns the material of the table left after removing a slot
+                * and turning another slot (or -1) into a knook
+                */
+                Material getChildMaterial(int removed, int fused)
+                {
+                    Material child{};
+                    for(int i = 0; i < count; i++) {
+                        if(i != removed) {
+                            child.sides[slots[i].side].push_back(i == fused ? KNOOK_ID : slots[i].id);
+                        }
+                    }
+                    return child;
+                }
+
+                /*
+                * Sets up the transition to a table with the inputted values
+                */
+                Transition makeTransition(int removed, int fused, const std::vector<std::uint8_t>* table)
+                {
+                    Transition transition{};
+                    Material child = getChildMaterial(removed, fused);
+                    transition.table = table;
+                    transition.swapped = child.canonicalize();
+                    std::vector<Slot> childSlots = getSlots(child);
+                    transition.count = static_cast<int>(childSlots.size());
+                    std::vector<bool> used(count, false);
+                    for(int childSlot = 0; childSlot < transition.count; childSlot++) {
+                        for(int i = 0; i < count; i++) {
+                            Piece::ID id = i == fused ? KNOOK_ID : slots[i].id;
+                            if(!used[i] && i != removed && (slots[i].side ^ transition.swapped) == childSlots[childSlot].side
+                                && id == childSlots[childSlot].id) {
+                                transition.slots[childSlot] = i;
+                                used[i] = true;
+                                break;
+                            }
+                        }
+                    }
+                    return transition;
+                }
+
+                void setCapture(int removed, const std::vector<std::uint8_t>* table)
+                {
+                    captures[removed] = makeTransition(removed, -1, table);
+                }
+                void setFusion(int knight, int rook, const std::vector<std::uint8_t>* table)
+                {
+                    fusions[knight][rook] = makeTransition(knight, rook, table);
+                }
+
+                /*
+                * Returns the value of the position a capture or fusion leads
+                * to, with the other player to move
+                */
+                std::uint8_t lookUp(const Transition& transition, const int* squares, int player)
+                {
+                    std::uint64_t index = static_cast<std::uint64_t>(player ^ 1 ^ transition.swapped);
+                    for(int childSlot = 0; childSlot < transition.count; childSlot++) {
+                        index = index * 64 + static_cast<std::uint64_t>(squares[transition.slots[childSlot]]);
+                    }
+                    return (*transition.table)[index];
+                }
+
+                /*
+                * Reads the squares of every slot and the player to move out of
+                * an index, returning false if 2 slots share a square
+                */
+                bool decode(std::uint64_t index, int* squares, int* occupant, int& player)
+                {
+                    std::fill(occupant, occupant + 64, -1);
+                    player = static_cast<int>(index / sideSize);
+                    for(int i = count - 1; i >= 0; i--) {
+                        squares[i] = static_cast<int>(index % 64);
+                        index /= 64;
+                        if(occupant[squares[i]] >= 0) {
+                            return false;
+                        }
+                        occupant[squares[i]] = i;
+                    }
+                    return true;
+                }
+
+                /*
+                * Returns whether a square is attacked by a side's pieces
+                */
+                bool isAttacked(int square, int side, const int* squares, const int* occupant)
+                {
+                    for(int i = 0; i < count; i++) {
+                        if(slots[i].side != side || squares[i] < 0) {
+                            continue;
+                        }
+                        if(forEachTarget(slots[i].id, squares[i], occupant, [square](int target) { return target == square; })) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                /*
+                * Finds what is known about a position from its moves, and
+                * returns the positions that are already solved
+                */
+                void initialize(std::uint64_t first, std::uint64_t last, std::vector<Pending>& solved)
+                {
+                    int squares[Tablebase::maxPieces];
+                    int occupant[64];
+                    int player = 0;
+                    for(std::uint64_t index = first; index < last; index++) {
+                        counters[index] = 0;
+                        lossFloors[index] = noLoss;
+                        if(!decode(index, squares, occupant, player) || isAttacked(squares[kings[player ^ 1]], player, squares, occupant)) {
+                            values[index] = Tablebase::illegalValue;
+                            continue;
+                        }
+                        values[index] = 0;
+
+                        // Try every move of the player to move
+                        int moves = 0;
+                        int quietMoves = 0;
+                        int bestWin = Tablebase::maxDistance + 2;
+                        int lossFloor = 0;
+                        bool canDraw = false;
+                        for(int mover = 0; mover < count; mover++) {
+                            if(slots[mover].side != player) {
+                                continue;
+                            }
+                            int start = squares[mover];
+                            forEachTarget(slots[mover].id, start, occupant, [&](int target) {
+                                int other = occupant[target];
+                                bool fusion = false;
+                                if(other >= 0 && slots[other].side == player) {
+                                    if(slots[mover].id != KNIGHT_ID || slots[other].id != ROOK_ID) {
+                                        return false;
+                                    }
+                                    fusion = true;
+                                }
+
+                                // Make the move
+                                occupant[start] = -1;
+                                occupant[target] = fusion ? other : mover;
+                                squares[mover] = fusion ? -1 : target;
+                                if(other >= 0 && !fusion) {
+                                    squares[other] = -1;
+                                }
+                                int king = kings[player] == mover ? target : squares[kings[player]];
+                                bool legal = !isAttacked(king, player ^ 1, squares, occupant);
+
+                                // Find the value of captures and fusions in their table
+                                std::uint8_t childValue = 0;
+                                if(legal && other >= 0) {
+                                    childValue = lookUp(fusion ? fusions[mover][other] : captures[other], squares, player);
+                                }
+
+                                // Unmake the move
+                                squares[mover] = start;
+                                occupant[start] = mover;
+                                occupant[target] = other;
+                                if(other >= 0) {
+                                    squares[other] = target;
+                                }
+                                if(!legal) {
+                                    return false;
+                                }
+                                moves++;
+                                if(other < 0) {
+                                    quietMoves++;
+                                    return false;
+                                }
+                                Tablebase::Probe probe{};
+                                Tablebase::decodeValue(childValue, probe);
+                                if(probe.wdl == Tablebase::Wdl::loss) {
+                                    bestWin = std::min(bestWin, probe.distance + 1);
+                                }
+                                else if(probe.wdl == Tablebase::Wdl::win) {
+                                    lossFloor = std::max(lossFloor, probe.distance + 1);
+                                }
+                                else {
+                                    canDraw = true;
+                                }
+                                return false;
+                            });
+                        }
+
+                        // Checkmate and stalemate
+                        if(moves == 0) {
+                            if(isAttacked(squares[kings[player]], player ^ 1, squares, occupant)) {
+                                solved.push_back({index, 0, false});
+                            }
+                            continue;
+                        }
+
+                        // Captures and fusions that win make the position a win
+                        // unless a faster win is found, and any capture that does
+                        // not lose keeps the position from losing
+                        counters[index] = static_cast<std::uint8_t>(quietMoves);
+                        if(bestWin <= Tablebase::maxDistance + 1) {
+                            solved.push_back({index, bestWin, true});
+                            continue;
+                        }
+                        if(canDraw) {
+                            continue;
+                        }
+                        lossFloors[index] = static_cast<std::uint8_t>(lossFloor);
+                        if(quietMoves == 0) {
+                            solved.push_back({index, lossFloor, false});
+                        }
+                    }
+                }
+
+                /*
+                * Claims solved positions and finds the positions that move into
+                * them
+                */
+                void propagate(const Pending* first, const Pending* last, std::vector<Pending>& solved)
+                {
+                    int squares[Tablebase::maxPieces];
+                    int occupant[64];
+                    int player = 0;
+                    for(const Pending* pending = first; pending != last; pending++) {
+                        std::uint8_t expected = 0;
+                        if(!values[pending->index].compare_exchange_strong(expected, pending->getValue())) {
+                            continue; // Already solved at a lower distance
+                        }
+                        decode(pending->index, squares, occupant, player);
+
+                        // Unmake every move of the player who moved last, which
+                        // is always a quiet move since captures and fusions change
+                        // the material
+                        int mover = player ^ 1;
+                        std::uint64_t base = pending->index - static_cast<std::uint64_t>(player) * sideSize + static_cast<std::uint64_t>(mover) * sideSize;
+                        for(int slot = 0; slot < count; slot++) {
+                            if(slots[slot].side != mover) {
+                                continue;
+                            }
+                            int end = squares[slot];
+                            forEachTarget(slots[slot].id, end, occupant, [&](int start) {
+                                if(occupant[start] >= 0) {
+                                    return false;
+                                }
+                                std::uint64_t parent = base + (static_cast<std::uint64_t>(start) - static_cast<std::uint64_t>(end)) * powers[slot];
+                                std::uint8_t parentValue = values[parent].load();
+                                if(parentValue == Tablebase::illegalValue) {
+                                    return false;
+                                }
+
+                                // A move into a loss wins
+                                if(!pending->win) {
+                                    if(parentValue == 0) {
+                                        solved.push_back({parent, pending->distance + 1, true});
+                                    }
+                                    return false;
+                                }
+
+                                // A position loses once all of its moves are wins for
+                                // the other player, as slowly as possible
+                                if(counters[parent].fetch_sub(1) == 1 && lossFloors[parent] != noLoss) {
+                                    int distance = std::max(pending->distance + 1, static_cast<int>(lossFloors[parent]));
+                                    solved.push_back({parent, distance, false});
+                                }
+                                return false;
+                            });
+                        }
+                    }
+                }
+
+                /*
+                * Solves every position, returning false if a distance does not
+                * fit in a table
+                */
+                bool build(ThreadPool& pool, std::vector<std::uint8_t>& result)
+                {
+                    std::uint64_t entryCount = 2 * sideSize;
+                    values.reset(new std::atomic<std::uint8_t>[entryCount]);
+                    counters.reset(new std::atomic<std::uint8_t>[entryCount]);
+                    lossFloors.reset(new std::uint8_t[entryCount]);
+
+                    // Solved positions are claimed one distance at a time, so
+                    // each position is solved at its lowest distance
+                    std::vector<std::vector<Pending>> levels(Tablebase::maxDistance + 1);
+                    auto collect = [&](std::vector<std::future<std::vector<Pending>>>& tasks) {
+                        bool fits = true;
+                        for(std::future<std::vector<Pending>>& task : tasks) {
+                            for(const Pending& pending : task.get()) {
+                                if(pending.distance > Tablebase::maxDistance) {
+                                    fits = false;
+                                    continue;
+                                }
+                                levels[pending.distance].push_back(pending);
+                            }
+                        }
+                        tasks.clear();
+                        return fits;
+                    };
+
+                    std::vector<std::future<std::vector<Pending>>> tasks{};
+                    std::uint64_t chunk = std::max<std::uint64_t>(entryCount / (8 * pool.getThreadCount()), 4096);
+                    for(std::uint64_t first = 0; first < entryCount; first += chunk) {
+                        std::uint64_t last = std::min(first + chunk, entryCount);
+                        tasks.push_back(pool.submit([this, first, last]() {
+                            std::vector<Pending> solved{};
+                            initialize(first, last, solved);
+                            return solved;
+                        }));
+                    }
+                    bool fits = collect(tasks);
+
+                    for(std::size_t level = 0; level < levels.size(); level++) {
+                        std::vector<Pending> pending = std::move(levels[level]);
+                        std::size_t levelChunk = std::max<std::size_t>(pending.size() / (4 * pool.getThreadCount()), 1024);
+                        for(std::size_t first = 0; first < pending.size(); first += levelChunk) {
+                            std::size_t last = std::min(first + levelChunk, pending.size());
+                            const Pending* data = pending.data();
+                            tasks.push_back(pool.submit([this, data, first, last]() {
+                                std::vector<Pending> solved{};
+                                propagate(data + first, data + last, solved);
+                                return solved;
+                            }));
+                        }
+                        fits = collect(tasks) && fits;
+                    }
+                    if(!fits) {
+                        return false;
+                    }
+
+                    result.resize(entryCount);
+                    for(std::uint64_t index = 0; index < entryCount; index++) {
+                        result[index] = values[index].load();
+                    }
+                    return true;
+                }
+
+                int getCount()
+                {
+                    return count;
+                }
+                const Slot& getSlot(int slot)
+                {
+                    return slots[slot];
+                }
+        };
+    }
+
+    // See Tablebase.h
+    bool Tablebase::open(const std::string& path)
+    {
+        if(!file.open(path, MappedFile::Access::random)) {
+            return false;
+        }
+        return setData(file.getData(), file.getSize());
+    }
+
+    // See Tablebase.h
+    bool Tablebase::setData(const unsigned char* newData, std::size_t newSize)
+    {
+        data = nullptr;
+        size = 0;
+        blockCount = 0;
+        entryCount = 0;
+        material.clear();
+        if(!newData || newSize < headerSize || std::memcmp(newData, magic, sizeof(magic)) != 0
+            || read16(newData + 4) != version) {
+            return false;
+        }
+
+        // Read the material
+        std::size_t materialLength = newData[6];
+        std::size_t materialSize = (materialLength + 3) / 4 * 4;
+        std::uint32_t blocks = read32(newData + 8);
+        std::size_t lengthsStart = headerSize + materialSize;
+        std::size_t newOffsetsStart = lengthsStart + 256;
+        if(newSize < newOffsetsStart + 4 * (static_cast<std::size_t>(blocks) + 1)) {
+            return false;
+        }
+        Material parsed{};
+        std::string_view text{reinterpret_cast<const char*>(newData + headerSize), materialLength};
+        if(!parseMaterial(text, parsed) || parsed.toString() != text) {
+            return false;
+        }
+
+        // Rebuild the canonical code, which must not have more codes of a
+        // length than there is room for
+        std::uint16_t counts[Tablebase::maxCodeLength + 1]{};
+        for(int value = 0; value < 256; value++) {
+            if(newData[lengthsStart + value] > Tablebase::maxCodeLength) {
+                return false;
+            }
+            counts[newData[lengthsStart + value]]++;
+        }
+        counts[0] = 0;
+        std::int64_t room = 1;
+        for(int length = 1; length <= Tablebase::maxCodeLength; length++) {
+            room = room * 2 - counts[length];
+            if(room < 0) {
+                return false;
+            }
+        }
+        std::size_t next = 0;
+        for(int length = 1; length <= Tablebase::maxCodeLength; length++) {
+            for(int value = 0; value < 256; value++) {
+                if(newData[lengthsStart + value] == length) {
+                    codeValues[next++] = static_cast<std::uint8_t>(value);
+                }
+            }
+        }
+        std::copy(std::begin(counts), std::end(counts), std::begin(codeCounts));
+
+        // Make sure every block is inside the data
+        std::uint64_t entries = std::uint64_t{2} << (6 * parsed.getPieceCount());
+        if(blocks != (entries + blockSize - 1) / blockSize
+            || read32(newData + newOffsetsStart + 4 * static_cast<std::size_t>(blocks)) > newSize) {
+            return false;
+        }
+        material = text;
+        pieces[0] = parsed.sides[0];
+        pieces[1] = parsed.sides[1];
+        data = newData;
+        size = newSize;
+        blockCount = blocks;
+        entryCount = entries;
+        offsetsStart = newOffsetsStart;
+        return true;
+    }
+
+    // See Tablebase.h
+    const std::string& Tablebase::getMaterial()
+    {
+        return material;
+    }
+
+    // See Tablebase.h
+    std::uint64_t Tablebase::getEntryCount()
+    {
+        return entryCount;
+    }
+
+    // See Tablebase.h
+    std::uint8_t Tablebase::getValue(std::uint64_t index)
+    {
+        if(index >= entryCount) {
+            return illegalValue;
+        }
+
+        // Decode the block holding the position up to the position, one
+        // bit at a time
+        std::size_t block = static_cast<std::size_t>(index / blockSize);
+        std::size_t offset = read32(data + offsetsStart + 4 * block);
+        std::size_t end = read32(data + offsetsStart + 4 * (block + 1));
+        if(offset > end || end > size) {
+            return illegalValue;
+        }
+        std::size_t bit = 0;
+        std::size_t bitCount = 8 * (end - offset);
+        std::uint64_t remaining = index % blockSize;
+        while(true) {
+            // Codes of each length come right after all of the shorter codes
+            int code = 0;
+            int first = 0;
+            int position = 0;
+            int length = 1;
+            for(; length <= maxCodeLength; length++) {
+                if(bit >= bitCount) {
+                    return illegalValue;
+                }
+                code |= (data[offset + bit / 8] >> (7 - bit % 8)) & 1;
+                bit++;
+                if(code - first < codeCounts[length]) {
+                    break;
+                }
+                position += codeCounts[length];
+                first = (first + codeCounts[length]) << 1;
+                code <<= 1;
+            }
+            if(length > maxCodeLength) {
+                return illegalValue;
+            }
+            if(remaining == 0) {
+                return codeValues[position + code - first];
+            }
+            remaining--;
+        }
+    }
+
+    // See Tablebase.h
+    bool Tablebase::decodeValue(std::uint8_t value, Probe& result)
+    {
+        if(value == illegalValue) {
+            return false;
+        }
+        if(value == drawValue) {
+            result = {Wdl::draw, 0};
+        }
+        else if(value < lossValue) {
+            result = {Wdl::win, value};
+        }
+        else {
+            result = {Wdl::loss, value - lossValue};
+        }
+        return true;
+    }
+
+    // See Tablebase.h
+    bool Tablebase::probe(ChessGameState& chessState, Probe& result)
+    {
+        if(!data) {
+            return false;
+        }
+        GameBoard* board = chessState.getBoard();
+        std::vector<Move::position> positions[2] = {
+            board->getPiecesOfPlayer(Player::white),
+            board->getPiecesOfPlayer(Player::black)
+        };
+        std::size_t pieceCount = pieces[0].size() + pieces[1].size();
+        if(positions[0].size() + positions[1].size() != pieceCount || static_cast<std::size_t>(board->getPieceCount()) != pieceCount) {
+            return false;
+        }
+
+        // Find which side of the board holds the first side of the table
+        Material onBoard{};
+        for(int side = 0; side < 2; side++) {
+            for(Move::position position : positions[side]) {
+                Piece* piece = board->getPiece(position);
+                if(getRank(piece->getID()) < 0) {
+                    return false;
+                }
+                onBoard.sides[side].push_back(piece->getID());
+            }
+        }
+        onBoard.sort();
+        int swapped = 0;
+        if(onBoard.sides[0] != pieces[0] || onBoard.sides[1] != pieces[1]) {
+            if(onBoard.sides[1] != pieces[0] || onBoard.sides[0] != pieces[1]) {
+                return false;
+            }
+            swapped = 1;
+        }
+
+        // Tables do not know about castling
+        for(int side = 0; side < 2; side++) {
+            bool kingMoved = true;
+            bool rookMoved = true;
+            for(Move::position position : positions[side]) {
+                Piece* piece = board->getPiece(position);
+                kingMoved &= piece->getID() != KING_ID || piece->previouslyMoved();
+                rookMoved &= piece->getID() != ROOK_ID || piece->previouslyMoved();
+            }
+            if(!kingMoved && !rookMoved) {
+                return false;
+            }
+        }
+
+        // Find the index by giving each piece of the table a piece on the board
+        int player = chessState.getCrntPlayer() == Player::white ? 0 : 1;
+        std::uint64_t index = static_cast<std::uint64_t>(player ^ swapped);
+        std::vector<bool> used[2] = {std::vector<bool>(positions[0].size()), std::vector<bool>(positions[1].size())};
+        for(int side = 0; side < 2; side++) {
+            int boardSide = side ^ swapped;
+            for(Piece::ID id : pieces[side]) {
+                for(std::size_t i = 0; i < positions[boardSide].size(); i++) {
+                    if(!used[boardSide][i] && board->getPiece(positions[boardSide][i])->getID() == id) {
+                        used[boardSide][i] = true;
+                        Move::position position = positions[boardSide][i];
+                        if(position.first < 1 || position.first > 8 || position.second < 1 || position.second > 8) {
+                            return false;
+                        }
+                        index = index * 64 + static_cast<std::uint64_t>((position.second - 1) * 8 + position.first - 1);
+                        break;
+                    }
+                }
+            }
+        }
+        return decodeValue(getValue(index), result);
+    }
+
+    // See Tablebase.h
+    Search::Evaluation Tablebase::makeEvaluation(Search::Evaluation fallback)
+    {
+        return [this, fallback](GameState& gameState) {
+            Probe result{};
+            if(!probe(static_cast<ChessGameState&>(gameState), result)) {
+                return fallback(gameState);
+            }
+            switch(result.wdl) {
+                case Wdl::win:
+                    return winScore - result.distance;
+                case Wdl::loss:
+                    return -(winScore - result.distance);
+                case Wdl::draw:
+                    break;
+            }
+            return 0.0;
+        };
+    }
+
+    // See Tablebase.h
+    TablebaseGenerator::TablebaseGenerator(Options options) : options{ options } {}
+
+    // See Tablebase.h
+    std::string TablebaseGenerator::getCanonicalMaterial(std::string_view material)
+    {
+        Material parsed{};
+        if(!parseMaterial(material, parsed)) {
+            return {};
+        }
+        parsed.canonicalize();
+        return parsed.toString();
+    }
+
+    // See Tablebase.h
+    const std::vector<std::uint8_t>* TablebaseGenerator::generate(std::string_view material)
+    {
+        Material parsed{};
+        if(!parseMaterial(material, parsed)) {
+            return nullptr;
+        }
+        parsed.canonicalize();
+        std::string name = parsed.toString();
+        auto found = tables.find(name);
+        if(found != tables.end()) {
+            return &found->second;
+        }
+
+        // Build the tables that captures and fusions lead to first
+        TableBuilder builder{parsed};
+        int count = builder.getCount();
+        for(int removed = 0; removed < count; removed++) {
+            if(builder.getSlot(removed).id == KING_ID) {
+                continue;
+            }
+            const std::vector<std::uint8_t>* child = generate(builder.getChildMaterial(removed, -1).toString());
+            if(!child) {
+                return nullptr;
+            }
+            builder.setCapture(removed, child);
+        }
+        for(int knight = 0; knight < count; knight++) {
+            for(int rook = 0; rook < count; rook++) {
+                const Slot& knightSlot = builder.getSlot(knight);
+                const Slot& rookSlot = builder.getSlot(rook);
+                if(knightSlot.id != KNIGHT_ID || rookSlot.id != ROOK_ID || knightSlot.side != rookSlot.side) {
+                    continue;
+                }
+                const std::vector<std::uint8_t>* child = generate(builder.getChildMaterial(knight, rook).toString());
+                if(!child) {
+                    return nullptr;
+                }
+                builder.setFusion(knight, rook, child);
+            }
+        }
+
+        ThreadPool pool{options.threadCount};
+        std::vector<std::uint8_t> values{};
+        if(!builder.build(pool, values)) {
+            return nullptr;
+        }
+        return &(tables[name] = std::move(values));
+    }
+
+    // See Tablebase.h
+    bool TablebaseGenerator::write(std::ostream& output, std::string_view material, const std::vector<std::uint8_t>& values)
+    {
+        // Give every value a code, shortening the longest codes by
+        // flattening the counts until they all fit
+        std::uint64_t counts[256]{};
+        for(std::uint8_t value : values) {
+            counts[value]++;
+        }
+        unsigned char lengths[256]{};
+        while(!getCodeLengths(counts, lengths)) {
+            for(std::uint64_t& count : counts) {
+                count = count > 0 ? count / 2 + 1 : 0;
+            }
+        }
+
+        // Number the codes canonically: shorter codes first, then by value
+        std::uint32_t codes[256]{};
+        std::uint32_t code = 0;
+        for(int length = 1; length <= Tablebase::maxCodeLength; length++) {
+            for(int value = 0; value < 256; value++) {
+                if(lengths[value] == length) {
+                    codes[value] = code++;
+                }
+            }
+            code <<= 1;
+        }
+
+        // Pack each block starting at a new byte
+        std::uint32_t blocks = static_cast<std::uint32_t>((values.size() + Tablebase::blockSize - 1) / Tablebase::blockSize);
+        std::size_t materialSize = (material.size() + 3) / 4 * 4;
+        std::size_t dataStart = headerSize + materialSize + 256 + 4 * (static_cast<std::size_t>(blocks) + 1);
+        std::vector<unsigned char> offsets(4 * (static_cast<std::size_t>(blocks) + 1));
+        std::vector<unsigned char> packed{};
+        for(std::uint32_t block = 0; block < blocks; block++) {
+            write32(offsets.data() + 4 * block, static_cast<std::uint32_t>(dataStart + packed.size()));
+            std::size_t end = std::min(values.size(), (static_cast<std::size_t>(block) + 1) * Tablebase::blockSize);
+            int bit = 0;
+            for(std::size_t index = static_cast<std::size_t>(block) * Tablebase::blockSize; index < end; index++) {
+                std::uint8_t value = values[index];
+                for(int shift = lengths[value] - 1; shift >= 0; shift--) {
+                    if(bit == 0) {
+                        packed.push_back(0);
+                    }
+                    packed.back() |= static_cast<unsigned char>(((codes[value] >> shift) & 1) << (7 - bit));
+                    bit = (bit + 1) % 8;
+                }
+            }
+        }
+        write32(offsets.data() + 4 * static_cast<std::size_t>(blocks), static_cast<std::uint32_t>(dataStart + packed.size()));
+
+        unsigned char header[headerSize]{};
+        std::memcpy(header, magic, sizeof(magic));
+        write16(header + 4, Tablebase::version);
+        header[6] = static_cast<unsigned char>(material.size());
+        write32(header + 8, blocks);
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+        std::string paddedMaterial{material};
+        paddedMaterial.resize(materialSize, '\0');
+        output.write(paddedMaterial.data(), static_cast<std::streamsize>(paddedMaterial.size()));
+        output.write(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+        output.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size()));
+        output.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+        return output.good();
+    }
+}
@@ -49,26 +49,11 @@ namespace chess {
     // See Bishop.h
     void Bishop::addStandardMoves(std::vector<Move>& moves, ChessGameState& chessState)
     {
-        // Store for later use
-        ChessBoard* chessBoard = static_cast<ChessBoard*>(chessState.getBoard());
-
-        // Generate the deltas for each direction
-        std::vector<Move::position> upRightDeltas{};
-        std::vector<Move::position> downRightDeltas{};
-        std::vector<Move::position> upLeftDeltas{};
-        std::vector<Move::position> downLeftDeltas{};
-        for(int i = 1; i <= std::max(chessBoard->maxX(), chessBoard->maxY()) - std::min(chessBoard->minX(), chessBoard->minY()); i++) {
-            upRightDeltas.push_back(  std::make_pair(i, i));
-            downRightDeltas.push_back(std::make_pair(i, -i));
-            upLeftDeltas.push_back(   std::make_pair(-i, i));
-            downLeftDeltas.push_back( std::make_pair(-i, -i));
-        }
-
-        // Add related moves for each set of deltas
-        addRelatedPositionsDeltas(upRightDeltas,   moves, chessState);
-        addRelatedPositionsDeltas(downRightDeltas, moves, chessState);
-        addRelatedPositionsDeltas(upLeftDeltas,    moves, chessState);
-        addRelatedPositionsDeltas(downLeftDeltas,  moves, chessState);
+        // Add a ray in each diagonal direction
+        addRay(std::make_pair( 1,  1), moves, chessState);
+        addRay(std::make_pair( 1, -1), moves, chessState);
+        addRay(std::make_pair(-1,  1), moves, chessState);
+        addRay(std::make_pair(-1, -1), moves, chessState);
     }
     // See Bishop.h
     void Bishop::addIlVaticano(std::vector<Move>& moves, ChessGameState& chessState, bool attackOnly)
@@ -27,7 +27,6 @@ namespace chess {
     {
         // Store for later use
         ChessGameState& chessState = static_cast<ChessGameState&>(gameState);
-        ChessBoard* chessBoard = static_cast<ChessBoard*>(chessState.getBoard());
         
         // Generate knight moves
         const std::vector<Move::position> deltas {
@@ -43,20 +42,10 @@ namespace chess {
         std::vector<Move> moves = addUnrelatedPositionsDeltas(deltas, chessState);
 
         // Generate bishop moves
-        std::vector<Move::position> upRightDeltas{};
-        std::vector<Move::position> downRightDeltas{};
-        std::vector<Move::position> upLeftDeltas{};
-        std::vector<Move::position> downLeftDeltas{};
-        for(int i = 1; i <= std::max(chessBoard->maxX(), chessBoard->maxY()) - std::min(chessBoard->minX(), chessBoard->minY()); i++) {
-            upRightDeltas.push_back(  std::make_pair(i, i));
-            downRightDeltas.push_back(std::make_pair(i, -i));
-            upLeftDeltas.push_back(   std::make_pair(-i, i));
-            downLeftDeltas.push_back( std::make_pair(-i, -i));
-        }
-        addRelatedPositionsDeltas(upRightDeltas,   moves, chessState);
-        addRelatedPositionsDeltas(downRightDeltas, moves, chessState);
-        addRelatedPositionsDeltas(upLeftDeltas,    moves, chessState);
-        addRelatedPositionsDeltas(downLeftDeltas,  moves, chessState);
+        addRay(std::make_pair( 1,  1), moves, chessState);
+        addRay(std::make_pair( 1, -1), moves, chessState);
+        addRay(std::make_pair(-1,  1), moves, chessState);
+        addRay(std::make_pair(-1, -1), moves, chessState);
 
         return moves;
     }
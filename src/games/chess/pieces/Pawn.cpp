@@ -46,6 +46,16 @@ namespace chess {
     {
         boostTurn = gameState.getTurn();
     }
+    void Pawn::setBoostTurn(int turn)
+    {
+        boostTurn = turn;
+    }
+
+    // See Pawn.h
+    int Pawn::getBoostTurn()
+    {
+        return boostTurn;
+    }
 
     // See Pawn.h
     int Pawn::getMinPriority(GameState& gameState)
@@ -117,6 +127,12 @@ namespace chess {
     // See Pawn.h
     bool Pawn::justBoosted(GameState& gameState)
     {
+        // Moves that check for En Passant can change on the next turn without
+        // the board changing
+        GameBoard* board = gameState.getBoard();
+        if(board) {
+            board->recordTurnDependency();
+        }
         return boostTurn == gameState.getTurn() - 1;
     }
 
@@ -378,10 +394,30 @@ namespace chess {
         });
     }
 
+    // See Pawn.h
+    bool PawnBoostAction::callAction(Move::position end, GameBoard* board)
+    {
+        ChessGameState& chessState = static_cast<ChessGameState&>(gameState);
+        previousBoostTurn = pawn.getBoostTurn();
+        previousBoostedPawn = chessState.getBoostedPawn();
+        pawn.setBoostTurn(gameState);
+        chessState.setBoostedPawn(&pawn);
+        return true;
+    }
+
+    // See Pawn.h
+    bool PawnBoostAction::reverseAction(GameBoard* board)
+    {
+        pawn.setBoostTurn(previousBoostTurn);
+        static_cast<ChessGameState&>(gameState).setBoostedPawn(previousBoostedPawn);
+        return true;
+    }
+
     // See Pawn.h
     void PawnBoostAction::applySymptomaticEffects(GameBoard* board)
     {
         pawn.setBoostTurn(gameState);
+        static_cast<ChessGameState&>(gameState).setBoostedPawn(&pawn);
     }
 
     // See Pawn.h
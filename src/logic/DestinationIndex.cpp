@@ -0,0 +1,104 @@
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "HashPair.h"
+#include "DestinationIndex.h"
+
+namespace logic {
+    // See DestinationIndex.h
+    DestinationIndex::Slot& DestinationIndex::findSlot(Move::position position)
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t idx = hash_tuple::int_pair_hash{}(position) & mask;
+        while(slots[idx].used && slots[idx].position != position) {
+            idx = (idx + 1) & mask;
+        }
+        return slots[idx];
+    }
+
+    // See DestinationIndex.h
+    const DestinationIndex::Slot* DestinationIndex::findUsedSlot(Move::position position) const
+    {
+        if(slots.empty()) {
+            return nullptr;
+        }
+        std::size_t mask = slots.size() - 1;
+        std::size_t idx = hash_tuple::int_pair_hash{}(position) & mask;
+        while(slots[idx].used) {
+            if(slots[idx].position == position) {
+                return &slots[idx];
+            }
+            idx = (idx + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    // See DestinationIndex.h
+    void DestinationIndex::build(std::vector<Move>& moves)
+    {
+        clear();
+        if(moves.size() > maxIndexedMoves) {
+            return;
+        }
+        isIndexed = true;
+
+        // Keep the table at most half full so probes stay short
+        std::size_t positionCount = 0;
+        for(Move& move : moves) {
+            positionCount += move.getPositions().size();
+        }
+        if(positionCount == 0) {
+            return;
+        }
+        std::size_t capacity = 8;
+        while(capacity < positionCount * 2) {
+            capacity *= 2;
+        }
+        slots.resize(capacity);
+
+        for(std::size_t moveIdx = 0; moveIdx < moves.size(); moveIdx++) {
+            Move& move = moves[moveIdx];
+            for(Move::position position : move.getPositions()) {
+                Slot& slot = findSlot(position);
+                slot.used = true;
+                slot.position = position;
+                slot.moveMask |= std::uint64_t{1} << moveIdx;
+                slot.maxPriority = std::max(slot.maxPriority, move.getPriority());
+            }
+        }
+    }
+
+    // See DestinationIndex.h
+    void DestinationIndex::clear()
+    {
+        slots.clear();
+        isIndexed = false;
+    }
+
+    // See DestinationIndex.h
+    bool DestinationIndex::indexed() const
+    {
+        return isIndexed;
+    }
+
+    // See DestinationIndex.h
+    bool DestinationIndex::contains(Move::position position) const
+    {
+        return findUsedSlot(position) != nullptr;
+    }
+
+    // See DestinationIndex.h
+    std::uint64_t DestinationIndex::getMoveMask(Move::position position) const
+    {
+        const Slot* slot = findUsedSlot(position);
+        return slot ? slot->moveMask : 0;
+    }
+
+    // See DestinationIndex.h
+    int DestinationIndex::getMaxPriority(Move::position position) const
+    {
+        const Slot* slot = findUsedSlot(position);
+        return slot ? slot->maxPriority : 0;
+    }
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <bit>
+
+#include "Evaluator.h"
+#include "Piece.h"
+#include "Move.h"
+
+namespace logic {
+    // See Evaluator.h
+    void Evaluator::update(Piece* piece, Move::position position, double sign)
+    {
+        double value = sign * getPieceValue(piece);
+        double squareValue = sign * getPieceSquareValue(piece, position);
+        for(std::uint32_t mask = piece->getPlayerMask(); mask != 0; mask &= mask - 1) {
+            int player = std::countr_zero(mask);
+            if(player >= static_cast<int>(Player::last)) {
+                break;
+            }
+            material[player] += value;
+            positional[player] += squareValue;
+            totalMaterial += value;
+            totalPositional += squareValue;
+        }
+    }
+
+    // See Evaluator.h
+    void Evaluator::pieceAdded(Piece* piece, Move::position position)
+    {
+        update(piece, position, 1.0);
+    }
+
+    // See Evaluator.h
+    void Evaluator::pieceRemoved(Piece* piece, Move::position position)
+    {
+        update(piece, position, -1.0);
+    }
+
+    // See Evaluator.h
+    void Evaluator::pieceMoved(Piece* piece, Move::position prevPosition, Move::position newPosition)
+    {
+        // Material does not change when a piece moves
+        double change = getPieceSquareValue(piece, newPosition) - getPieceSquareValue(piece, prevPosition);
+        for(std::uint32_t mask = piece->getPlayerMask(); mask != 0; mask &= mask - 1) {
+            int player = std::countr_zero(mask);
+            if(player >= static_cast<int>(Player::last)) {
+                break;
+            }
+            positional[player] += change;
+            totalPositional += change;
+        }
+    }
+
+    // See Evaluator.h
+    void Evaluator::clear()
+    {
+        for(int player = 0; player < static_cast<int>(Player::last); player++) {
+            material[player] = 0.0;
+            positional[player] = 0.0;
+        }
+        totalMaterial = 0.0;
+        totalPositional = 0.0;
+    }
+
+    // See Evaluator.h
+    double Evaluator::getMaterial(Player player)
+    {
+        return material[static_cast<int>(player)];
+    }
+
+    // See Evaluator.h
+    double Evaluator::getPositional(Player player)
+    {
+        return positional[static_cast<int>(player)];
+    }
+
+    // See Evaluator.h
+    double Evaluator::evaluate(Player player)
+    {
+        // Every other player's score is the total minus this player's score
+        double score = getMaterial(player) + getPositional(player);
+        return 2 * score - (totalMaterial + totalPositional);
+    }
+}
@@ -1,9 +1,11 @@
 #include <memory>
+#include <algorithm>
 
 #include "GameBoard.h"
 #include "Piece.h"
 #include "Move.h"
 #include "Action.h"
+#include "Stats.h"
 
 namespace logic {
 
@@ -48,7 +50,11 @@ namespace logic {
     // See GameBoard.h
     bool GameBoard::occupiedOnBoard(Move::position position)
     {
-        return onBoard(position) && (board[position] != nullptr);
+        if(!onBoard(position)) {
+            return false;
+        }
+        recordDependency(position);
+        return board.occupied(position);
     }
 
     // See GameBoard.h
@@ -60,7 +66,11 @@ namespace logic {
     // See GameBoard.h
     bool GameBoard::unoccupiedOnBoard(Move::position position)
     {
-        return onBoard(position) && (board[position] == nullptr);
+        if(!onBoard(position)) {
+            return false;
+        }
+        recordDependency(position);
+        return !board.occupied(position);
     }
 
     // See GameBoard.h
@@ -81,8 +91,12 @@ namespace logic {
 
         // Add the piece to the board and return true
         allPieces.push_back(piece);
-        board[piecePosition] = piece;
+        board.set(piecePosition, piece);
         piece->setOnBoard(true);
+        pieceCount++;
+        if(evaluator) {
+            evaluator->pieceAdded(piece, piecePosition);
+        }
         return true;
     }
 
@@ -97,6 +111,16 @@ namespace logic {
         return true;
     }
 
+    // See GameBoard.h
+    int GameBoard::getPieceCount()
+    {
+        return pieceCount;
+    }
+    int GameBoard::getPieceCount(Piece::Player player)
+    {
+        return board.rosterSize(player);
+    }
+
     // See GameBoard.h
     Piece* GameBoard::getPiece(int x, int y)
     {
@@ -110,7 +134,7 @@ namespace logic {
         if(!occupiedOnBoard(position)) {
             return nullptr;
         }
-        return board[position];
+        return board.get(position);
     }
 
     // See GameBoard.h
@@ -130,7 +154,11 @@ namespace logic {
 
         // Remove the piece
         piece->setOnBoard(false);
-        board[position] = nullptr;
+        board.set(position, nullptr);
+        pieceCount--;
+        if(evaluator) {
+            evaluator->pieceRemoved(piece, position);
+        }
         return true;
     }
 
@@ -165,6 +193,7 @@ namespace logic {
         for(auto i = capturedPieces.begin(); i != capturedPieces.end(); i++) {
             if(!piece->getPlayerAccess(i->first)) { // Pieces are added for all players who don't control them
                 i->second->push_back(piece);
+                capturedScores[i->first] += piece->getValue();
             }
         }
         return true;
@@ -184,8 +213,12 @@ namespace logic {
         if(!unoccupiedOnBoard(originalPosition)) {
             return false;
         }
-        board[originalPosition] = piece;
+        board.set(originalPosition, piece);
         piece->setOnBoard(true);
+        pieceCount++;
+        if(evaluator) {
+            evaluator->pieceAdded(piece, originalPosition);
+        }
         return true;
     }
 
@@ -233,15 +266,218 @@ namespace logic {
 
         // Remove the piece from the previous position and reinsert it at the new position
         Piece *piece = getPiece(prevPosition);
-        board[prevPosition] = nullptr;
-        board[newPosition] = piece;
+        board.set(prevPosition, nullptr);
+        board.set(newPosition, piece);
         piece->changePosition(newPosition);
+        if(evaluator) {
+            evaluator->pieceMoved(piece, prevPosition, newPosition);
+        }
+        return true;
+    }
+
+    // See GameBoard.h
+    int GameBoard::findNextOccupied(Move::position start, Move::position direction, int maxSteps)
+    {
+        int steps = board.findNextOccupied(start, direction, maxSteps);
+
+        // The result depends on every position up to and including the blocker
+        if(recordingDependencies()) {
+            recordRayDependency(start, direction, maxSteps);
+            if(steps > 0) {
+                recordDependency(std::make_pair(start.first + steps * direction.first, start.second + steps * direction.second));
+            }
+        }
+        return steps;
+    }
+
+    // See GameBoard.h
+    void GameBoard::setRayHorizon(int newHorizon)
+    {
+        rayHorizon = std::max(newHorizon, 0);
+    }
+
+    // See GameBoard.h
+    std::vector<Move::position> GameBoard::castRay(Move::position start, Move::position direction, int horizon)
+    {
+        if(horizon <= 0) {
+            horizon = getRayHorizon();
+        }
+
+        // Jump straight to the blocker so the ray's length is known up front
+        int blocker = board.findNextOccupied(start, direction, horizon);
+        int length = blocker < 0 ? horizon : blocker;
+
+        // Find where the ray leaves the board first so that only the positions
+        // that are returned get reserved, not the whole horizon
+        int onBoardLength = 0;
+        while(onBoardLength < length && onBoard(std::make_pair(start.first + (onBoardLength + 1) * direction.first,
+            start.second + (onBoardLength + 1) * direction.second))) {
+            onBoardLength++;
+        }
+        std::vector<Move::position> positions{};
+        positions.reserve(onBoardLength);
+        for(int i = 1; i <= onBoardLength; i++) {
+            positions.push_back(std::make_pair(start.first + i * direction.first, start.second + i * direction.second));
+        }
+
+        // A single ray covers the empty positions, and the blocker is recorded
+        // on its own since its piece can change without the ray changing
+        if(recordingDependencies() && onBoardLength > 0) {
+            recordRayDependency(start, direction, onBoardLength);
+            if(onBoardLength == blocker) {
+                recordDependency(positions.back());
+            }
+        }
+        return positions;
+    }
+
+    // See GameBoard.h
+    std::uint64_t GameBoard::getPositionHash()
+    {
+        return board.hash();
+    }
+
+    // See GameBoard.h
+    std::uint64_t GameBoard::getSquareFingerprint(Move::position position)
+    {
+        Piece* piece = board.get(position);
+        if(!piece) {
+            return 0;
+        }
+        std::uint64_t key = SparseBoard::pieceKey(piece, position);
+        return piece->previouslyMoved() ? hash_tuple::mix64(key) : key;
+    }
+
+    // See GameBoard.h
+    std::uint64_t GameBoard::getRosterHash(Piece::Player player)
+    {
+        return board.rosterHash(player);
+    }
+
+    // See GameBoard.h
+    void GameBoard::beginDependencyRecording()
+    {
+        recorders.emplace_back();
+    }
+
+    // See GameBoard.h
+    Dependencies GameBoard::endDependencyRecording()
+    {
+        Dependencies dependencies{};
+        if(recorders.empty()) {
+            return dependencies;
+        }
+        DependencyRecorder recorder = std::move(recorders.back());
+        recorders.pop_back();
+
+        // Everything this generation depended on is also a dependency of the
+        // generation that caused it
+        if(!recorders.empty()) {
+            DependencyRecorder& parent = recorders.back();
+            parent.squares.insert(parent.squares.end(), recorder.squares.begin(), recorder.squares.end());
+            parent.rosters.insert(parent.rosters.end(), recorder.rosters.begin(), recorder.rosters.end());
+            parent.rays.insert(parent.rays.end(), recorder.rays.begin(), recorder.rays.end());
+            parent.turn = parent.turn || recorder.turn;
+        }
+
+        // Remove duplicates and take fingerprints of the current board
+        std::sort(recorder.squares.begin(), recorder.squares.end());
+        recorder.squares.erase(std::unique(recorder.squares.begin(), recorder.squares.end()), recorder.squares.end());
+        dependencies.squares.reserve(recorder.squares.size());
+        for(Move::position position : recorder.squares) {
+            dependencies.squares.emplace_back(position, getSquareFingerprint(position));
+        }
+        std::sort(recorder.rosters.begin(), recorder.rosters.end());
+        recorder.rosters.erase(std::unique(recorder.rosters.begin(), recorder.rosters.end()), recorder.rosters.end());
+        for(int player : recorder.rosters) {
+            dependencies.rosters.emplace_back(player, getRosterHash(static_cast<Piece::Player>(player)));
+        }
+        std::sort(recorder.rays.begin(), recorder.rays.end());
+        recorder.rays.erase(std::unique(recorder.rays.begin(), recorder.rays.end()), recorder.rays.end());
+        dependencies.rays.reserve(recorder.rays.size());
+        for(const RayDependency& ray : recorder.rays) {
+            dependencies.rays.emplace_back(ray, board.findNextOccupied(ray.start, ray.direction, ray.maxSteps));
+        }
+        dependencies.turn = recorder.turn;
+        return dependencies;
+    }
+
+    // See GameBoard.h
+    bool GameBoard::recordingDependencies()
+    {
+        return !recorders.empty();
+    }
+
+    // See GameBoard.h
+    void GameBoard::recordDependency(Move::position position)
+    {
+        if(!recorders.empty()) {
+            recorders.back().squares.push_back(position);
+        }
+    }
+
+    // See GameBoard.h
+    void GameBoard::recordRayDependency(Move::position start, Move::position direction, int maxSteps)
+    {
+        if(!recorders.empty()) {
+            recorders.back().rays.push_back({start, direction, maxSteps});
+        }
+    }
+
+    // See GameBoard.h
+    void GameBoard::recordTurnDependency()
+    {
+        if(!recorders.empty()) {
+            recorders.back().turn = true;
+        }
+    }
+
+    // See GameBoard.h
+    void GameBoard::recordDependencies(const Dependencies& dependencies)
+    {
+        if(recorders.empty()) {
+            return;
+        }
+        DependencyRecorder& recorder = recorders.back();
+        for(const auto& [position, fingerprint] : dependencies.squares) {
+            recorder.squares.push_back(position);
+        }
+        for(const auto& [player, hash] : dependencies.rosters) {
+            recorder.rosters.push_back(player);
+        }
+        for(const auto& [ray, steps] : dependencies.rays) {
+            recorder.rays.push_back(ray);
+        }
+        recorder.turn = recorder.turn || dependencies.turn;
+    }
+
+    // See GameBoard.h
+    bool GameBoard::dependenciesHold(const Dependencies& dependencies)
+    {
+        for(const auto& [player, hash] : dependencies.rosters) {
+            if(getRosterHash(static_cast<Piece::Player>(player)) != hash) {
+                return false;
+            }
+        }
+        for(const auto& [position, fingerprint] : dependencies.squares) {
+            if(getSquareFingerprint(position) != fingerprint) {
+                return false;
+            }
+        }
+        for(const auto& [ray, steps] : dependencies.rays) {
+            if(board.findNextOccupied(ray.start, ray.direction, ray.maxSteps) != steps) {
+                return false;
+            }
+        }
         return true;
     }
 
     // See GameBoard.h
     std::vector<Move::position> GameBoard::getPiecesOfPlayer(Piece::Player player)
     {
+        if(!recorders.empty()) {
+            recorders.back().rosters.push_back(static_cast<int>(player));
+        }
         std::vector<Move::position> piecePositions{};
 
         // Iterate through all of the pieces and add the ones that player can access
@@ -254,6 +490,18 @@ namespace logic {
         return piecePositions;
     }
 
+    // See GameBoard.h
+    std::vector<Move::position> GameBoard::getAllPiecePositions()
+    {
+        std::vector<Move::position> piecePositions{};
+        for(Piece* piece : allPieces) {
+            if(piece->getOnBoard()) {
+                piecePositions.push_back(piece->getPosition());
+            }
+        }
+        return piecePositions;
+    }
+
     // See GameBoard.h
     const std::vector<Piece*>* GameBoard::getPlayerCaptures(Piece::Player player)
     {
@@ -269,23 +517,44 @@ namespace logic {
     // See GameBoard.h
     double GameBoard::getPlayerScore(Piece::Player player)
     {
-        // Get the player's captures and make sure nothing went wrong
-        const std::vector<Piece*>* playerCaptures = getPlayerCaptures(player);
-        if(playerCaptures == nullptr) {
-            return 0;
-        }
+        auto score = capturedScores.find(player);
+        return score == capturedScores.end() ? 0 : score->second;
+    }
+
+    // See GameBoard.h
+    void GameBoard::setEvaluator(Evaluator* newEvaluator)
+    {
+        evaluator.reset(newEvaluator);
+        refreshEvaluator();
+    }
+
+    // See GameBoard.h
+    Evaluator* GameBoard::getEvaluator()
+    {
+        return evaluator.get();
+    }
 
-        // Add all of the scores of the player's captured pieces together
-        double score = 0;
-        for(Piece *piece : (*playerCaptures)) {
-            score += piece->getValue();
+    // See GameBoard.h
+    void GameBoard::refreshEvaluator()
+    {
+        if(!evaluator) {
+            return;
+        }
+        evaluator->clear();
+        for(Piece* piece : allPieces) {
+            if(piece->getOnBoard()) {
+                evaluator->pieceAdded(piece, piece->getPosition());
+            }
         }
-        return score;
     }
 
     //See GameBoard.h
     void GameBoard::addToSimulation(std::shared_ptr<Action> action)
     {
+        std::size_t frameStart = simulationFrames.empty() ? 0 : simulationFrames.back();
+        if(simulation.size() == frameStart) {
+            STATS_RECORD(recordSimulationStarted());
+        }
         simulation.push_back(action);
     }
 
@@ -303,7 +572,11 @@ namespace logic {
     // See GameBoard.h
     bool GameBoard::revertSimulation()
     {
-        while(simulation.size() > 0) {
+        std::size_t frameStart = simulationFrames.empty() ? 0 : simulationFrames.back();
+        if(simulation.size() > frameStart) {
+            STATS_RECORD(recordSimulationReverted());
+        }
+        while(simulation.size() > frameStart) {
             if(!revertSimulatedMove()) {
                 return false;
             }
@@ -311,6 +584,22 @@ namespace logic {
         return true;
     }
 
+    // See GameBoard.h
+    void GameBoard::beginSimulationFrame()
+    {
+        simulationFrames.push_back(simulation.size());
+    }
+
+    // See GameBoard.h
+    bool GameBoard::endSimulationFrame()
+    {
+        if(simulationFrames.empty() || !revertSimulation()) {
+            return false;
+        }
+        simulationFrames.pop_back();
+        return true;
+    }
+
     // See GameBoard.h
     void GameBoard::applySimulation()
     {
@@ -318,6 +607,7 @@ namespace logic {
             action->applySymptomaticEffects(this);
         }
         simulation.clear();
+        simulationFrames.clear();
     }
 
     // See GameBoard.h
@@ -1,4 +1,6 @@
 #include <set>
+#include <algorithm>
+#include <unordered_map>
 #include <memory>
 
 #include "Move.h"
@@ -7,6 +9,7 @@
 #include "GameState.h"
 #include "Action.h"
 #include "MovePieceAction.h"
+#include "Stats.h"
 
 namespace logic {
 
@@ -55,6 +58,12 @@ namespace logic {
         return crntPlayer;
     }
 
+    // See GameState.h
+    int GameState::getPlayerCount()
+    {
+        return allPlayers.size();
+    }
+
     // See GameState.h
     bool GameState::setCrntPlayer(int idxOffset)
     {
@@ -94,6 +103,12 @@ namespace logic {
     // See GameState.h
     int GameState::getPriorityOfPlayer(Player player)
     {
+        // Reuse the priority if it was already found for this game state
+        PriorityCacheEntry* cached = getPriorityCacheEntry(player);
+        if(cached && cached->hasMaxPriority) {
+            return cached->maxPriority;
+        }
+
         // Get the player's pieces
         std::vector<Move::position> playerPiecePositions = gameBoard->getPiecesOfPlayer(player);
         
@@ -118,6 +133,13 @@ namespace logic {
                 maxPriority = crntMax;
             }
         }
+
+        // Look the entry up again since finding the moves may have changed the cache
+        cached = getPriorityCacheEntry(player);
+        if(cached) {
+            cached->maxPriority = maxPriority;
+            cached->hasMaxPriority = true;
+        }
         return maxPriority;
     }
 
@@ -128,14 +150,14 @@ namespace logic {
     }
 
     // See GameState.h
-    std::vector<Move> GameState::getMovesOfPiece(Player player, Move::position start, Move::position end)
+    int GameState::getPriorityBound()
     {
-        Piece* piece = gameBoard->getPiece(start);
-        if(!piece || !piece->getPlayerAccess(player))
-        {
-            return {};
-        }
+        return minPriority;
+    }
 
+    // See GameState.h
+    int GameState::getMovePriorityBound(Player player, Piece* piece)
+    {
         int priority = getPriorityOfPlayer(player);
 
         // If the player's move priority is below the minimum allowed priority,
@@ -148,21 +170,37 @@ namespace logic {
             bound = getMinPriority(player);
         }
         if(priority < bound) {
-            return {};
+            return -1;
         }
 
-        std::vector<Move>& allPieceMoves = piece->getMoves(*this);
-        std::vector<Move> movesToPosition{};
-
-        for(Move move : allPieceMoves) {
-            if(move.getPriority() < priority) {
-                continue;
-            }
-            const std::vector<Move::position>& positions = move.getPositions();
-            if(std::find(positions.begin(), positions.end(), end) != positions.end()) {
-                movesToPosition.push_back(move);
+        // Piece::getMoves() also filters by the current player's priority when
+        // the current player controls the piece
+        if(piece->controlledByPlayer(*this)) {
+            int crntPriority = getPriority();
+            if(crntPriority == 0) { // 0 priority means there are no valid moves
+                return -1;
             }
+            priority = std::max(priority, crntPriority);
         }
+        return priority;
+    }
+
+    // See GameState.h
+    std::vector<Move> GameState::getMovesOfPiece(Player player, Move::position start, Move::position end)
+    {
+        Piece* piece = gameBoard->getPiece(start);
+        if(!piece || !piece->getPlayerAccess(player))
+        {
+            return {};
+        }
+
+        int priority = getMovePriorityBound(player, piece);
+        if(priority < 0) {
+            return {};
+        }
+
+        std::vector<Move> movesToPosition{};
+        piece->getMovesTo(*this, end, priority, movesToPosition);
         return movesToPosition;
     }
     std::vector<Move> GameState::getMovesOfPiece(Player player, int startX, int startY, int endX, int endY)
@@ -195,10 +233,79 @@ namespace logic {
     }
 
 
+    // See GameState.h
+    bool GameState::generatingPseudoLegalMoves()
+    {
+        return pseudoLegalGeneration;
+    }
+    void GameState::setPseudoLegalGeneration(bool pseudoLegal)
+    {
+        pseudoLegalGeneration = pseudoLegal;
+    }
+
+    // See GameState.h
+    void GameState::generateAllLegalMoves(Player player, std::vector<LegalMove>& legalMoves)
+    {
+        legalMoves.clear();
+
+        // If the player's move priority is below the minimum allowed priority,
+        // then the player has no possible moves
+        int priority = getPriorityOfPlayer(player);
+        int bound;
+        if(player == crntPlayer) {
+            bound = minPriority;
+        }
+        else {
+            bound = getMinPriority(player);
+        }
+        if(priority == 0 || priority < bound) {
+            return;
+        }
+
+        // Counts the moves to each end position so far, along with the last 
+        // move that was counted so a move is never counted twice
+        std::unordered_map<Move::position, std::pair<int, int>, hash_tuple::int_pair_hash> endCounts{};
+        for(Move::position start : gameBoard->getPiecesOfPlayer(player)) {
+            Piece* piece = gameBoard->getPiece(start);
+            if(!piece || !piece->getPlayerAccess(player)) {
+                continue;
+            }
+
+            endCounts.clear();
+            std::vector<Move>& pieceMoves = piece->getMoves(*this);
+            for(std::size_t moveIdx = 0; moveIdx < pieceMoves.size(); moveIdx++) {
+                Move& move = pieceMoves[moveIdx];
+                if(move.getPriority() < priority) {
+                    continue;
+                }
+                int lastIdx = static_cast<int>(moveIdx);
+                for(Move::position end : move.getPositions()) {
+                    auto [count, inserted] = endCounts.try_emplace(end, 0, -1);
+                    if(count->second.second == lastIdx) {
+                        continue;
+                    }
+                    legalMoves.push_back({start, end, count->second.first, move.getPriority()});
+                    count->second.first++;
+                    count->second.second = lastIdx;
+                }
+            }
+        }
+    }
+    void GameState::generateAllLegalMoves(std::vector<LegalMove>& legalMoves)
+    {
+        generateAllLegalMoves(crntPlayer, legalMoves);
+    }
+
     // See GameState.h
     bool GameState::canMovePiece(Player player, Move::position start, Move::position end)
     {
-        return getMovesOfPiece(player, start, end).size() > 0;
+        Piece* piece = gameBoard->getPiece(start);
+        if(!piece || !piece->getPlayerAccess(player)) {
+            return false;
+        }
+
+        int priority = getMovePriorityBound(player, piece);
+        return priority >= 0 && piece->canReach(*this, end, priority);
     }
     bool GameState::canMovePiece(Player player, int startX, int startY, int endX, int endY)
     {
@@ -238,8 +345,10 @@ namespace logic {
         }
 
         // Store values for later
-        Move move = movesToEnd[idx];
+        Move& move = movesToEnd[idx];
         GameBoard* board = getBoard();
+        Piece* piece = board->getPiece(start);
+        int opponentPiecesBefore = getOpponentPieceCount();
 
         // Create an action that, when called, will move the piece from start to end
         std::shared_ptr<Action> moveAction(new MovePieceAction(std::make_pair(end.first - start.first, end.second - start.second)));
@@ -263,9 +372,11 @@ namespace logic {
         gameBoard->applySimulation();
 
         // Set the next player
+        updateHalfmoveClock(piece, opponentPiecesBefore);
         setNextPlayer();
         return true;
     }
+
     bool GameState::movePiece(int startX, int startY, int endX, int endY, int idx)
     {
         return movePiece(std::make_pair(startX, startY), std::make_pair(endX, endY), idx);
@@ -279,6 +390,60 @@ namespace logic {
         return movePiece(std::make_pair(startX, startY), end, idx);
     }
 
+    // See GameState.h
+    bool GameState::simulateMove(Move::position start, Move::position end, Move& move)
+    {
+        // Create an action that, when called, will move the piece from start to end
+        // - A new action is used every time since actions remember how to reverse
+        //   their most recent call
+        std::shared_ptr<Action> moveAction(new MovePieceAction(std::make_pair(end.first - start.first, end.second - start.second)));
+        return callActions(move.getPreMoveActions(), end)
+            && callAction(moveAction, start)
+            && callActions(move.getPostMoveActions(), end);
+    }
+
+    // See GameState.h
+    bool GameState::makeSimulatedMove(Move::position start, Move::position end, Move& move)
+    {
+        Piece* piece = gameBoard->getPiece(start);
+        int opponentPiecesBefore = getOpponentPieceCount();
+        gameBoard->beginSimulationFrame();
+        if(!simulateMove(start, end, move)) {
+            gameBoard->endSimulationFrame();
+            return false;
+        }
+        simulatedMoves.push_back({crntPlayer, crntPlayerIdx, curTurn, minPriority, halfmoveClock});
+        updateHalfmoveClock(piece, opponentPiecesBefore);
+        setNextPlayer();
+        return true;
+    }
+
+    // See GameState.h
+    bool GameState::unmakeSimulatedMove()
+    {
+        if(simulatedMoves.empty()) {
+            return false;
+        }
+        gameBoard->endSimulationFrame();
+        forgetPosition();
+
+        // Restore the player and turn directly since the turn never goes backwards otherwise
+        SimulatedMoveState& state = simulatedMoves.back();
+        crntPlayer = state.crntPlayer;
+        crntPlayerIdx = state.crntPlayerIdx;
+        curTurn = state.turn;
+        minPriority = state.minPriority;
+        halfmoveClock = state.halfmoveClock;
+        simulatedMoves.pop_back();
+        return true;
+    }
+
+    // See GameState.h
+    int GameState::getSimulatedMoveCount()
+    {
+        return simulatedMoves.size();
+    }
+
     //See GameState.h
     bool GameState::canMove(Player player)
     {
@@ -384,6 +549,9 @@ namespace logic {
     // See GameState.h
     bool GameState::isAttacked(Player player, Move::position position)
     {
+        // The result changes if the position changes, even when the attacks do not
+        // - Ex: Check depends on where the king is
+        gameBoard->recordDependency(position);
         std::vector<Move::position> attackedSpaces { getAttackedSpaces(player) };
         return std::find(attackedSpaces.begin(), attackedSpaces.end(), position) != attackedSpaces.end();
     }
@@ -406,16 +574,130 @@ namespace logic {
         return curTurn;
     }
 
+    // See GameState.h
+    bool GameState::setTurn(int turn)
+    {
+        if(turn < 1 || allPlayers.size() == 0 || simulatedMoves.size() > 0) {
+            return false;
+        }
+        curTurn = turn;
+        crntPlayerIdx = (turn - 1) % allPlayers.size();
+        crntPlayer = allPlayers[crntPlayerIdx];
+        invalidatePriorities();
+
+        // Earlier positions did not lead to this one
+        positionHistory.clear();
+        positionCounts.clear();
+        recordPosition();
+        return true;
+    }
+
+    // See GameState.h
+    std::uint64_t GameState::getPositionKey()
+    {
+        return gameBoard->getPositionHash() ^ hash_tuple::mix64(static_cast<std::uint64_t>(crntPlayer)) ^ getStateKey();
+    }
+
+    // See GameState.h
+    int GameState::getRepetitionCount()
+    {
+        auto count = positionCounts.find(getPositionKey());
+        return count == positionCounts.end() ? 0 : count->second;
+    }
+
+    // See GameState.h
+    bool GameState::copyPositionHistory(GameState& other)
+    {
+        if(simulatedMoves.size() > 0 || other.simulatedMoves.size() > 0
+            || other.getPositionKey() != getPositionKey()) {
+            return false;
+        }
+        positionHistory = other.positionHistory;
+        positionCounts = other.positionCounts;
+        return true;
+    }
+
+    // See GameState.h
+    int GameState::getHalfmoveClock()
+    {
+        return halfmoveClock;
+    }
+    void GameState::setHalfmoveClock(int clock)
+    {
+        halfmoveClock = std::max(clock, 0);
+    }
+
+    // See GameState.h
+    bool GameState::isDrawByRepetition()
+    {
+        return getRepetitionCount() >= 3;
+    }
+
+    // See GameState.h
+    bool GameState::isDrawByHalfmoveClock()
+    {
+        return halfmoveClock >= halfmoveLimit;
+    }
+
     // See GameState.h
     void GameState::nextTurn() 
     {
         curTurn++;
         updateMinPriority();
+        recordPosition();
+    }
+
+    // See GameState.h
+    void GameState::recordPosition()
+    {
+        std::uint64_t key = getPositionKey();
+        positionHistory.push_back(key);
+        positionCounts[key]++;
+    }
+
+    // See GameState.h
+    int GameState::getOpponentPieceCount()
+    {
+        int count = 0;
+        for(Player player : allPlayers) {
+            if(player != crntPlayer) {
+                count += gameBoard->getPieceCount(player);
+            }
+        }
+        return count;
+    }
+
+    // See GameState.h
+    void GameState::updateHalfmoveClock(Piece* piece, int opponentPiecesBefore)
+    {
+        // Only losing an opponent's piece is a capture, so pieces that fuse
+        // (ex: Knooklear fusion) do not reset the clock
+        bool captured = getOpponentPieceCount() < opponentPiecesBefore;
+        if(captured || (piece && resetsHalfmoveClock(piece))) {
+            halfmoveClock = 0;
+        }
+        else {
+            halfmoveClock++;
+        }
+    }
+
+    // See GameState.h
+    void GameState::forgetPosition()
+    {
+        if(positionHistory.empty()) {
+            return;
+        }
+        auto count = positionCounts.find(positionHistory.back());
+        if(count != positionCounts.end() && --count->second <= 0) {
+            positionCounts.erase(count);
+        }
+        positionHistory.pop_back();
     }
     
     bool GameState::callAction(std::shared_ptr<Action> action, Move::position targetPosition)
     {
         if(action->callAction(targetPosition, gameBoard)) {
+            STATS_RECORD(recordAction(typeid(*action)));
             gameBoard->addToSimulation(action);
             return true;
         }
@@ -436,6 +718,12 @@ namespace logic {
     // See GameState.h
     int GameState::getMinPriority(Player player) 
     {
+        // Reuse the minimum priority if it was already found for this game state
+        PriorityCacheEntry* cached = getPriorityCacheEntry(player);
+        if(cached && cached->hasMinPriority) {
+            return cached->minPriority;
+        }
+
         // Get the current player's pieces
         std::vector<Move::position> playerPiecePositions = gameBoard->getPiecesOfPlayer(player);
 
@@ -444,6 +732,12 @@ namespace logic {
         for(Move::position piecePosition : playerPiecePositions) {
             result = std::max(result, gameBoard->getPiece(piecePosition)->getMinPriority(*this));
         }
+
+        cached = getPriorityCacheEntry(player);
+        if(cached) {
+            cached->minPriority = result;
+            cached->hasMinPriority = true;
+        }
         return result;
     }
 
@@ -452,4 +746,27 @@ namespace logic {
     {
         minPriority = getMinPriority(crntPlayer);
     }
+
+    // See GameState.h
+    void GameState::invalidatePriorities()
+    {
+        priorityCache.clear();
+        updateMinPriority();
+    }
+
+    // See GameState.h
+    GameState::PriorityCacheEntry* GameState::getPriorityCacheEntry(Player player)
+    {
+        if(gameBoard->recordingDependencies()) {
+            return nullptr;
+        }
+
+        // Clear the entry if it was found for a different game state
+        PriorityCacheEntry& entry = priorityCache[player];
+        std::uint64_t positionHash = gameBoard->getPositionHash() ^ getStateKey();
+        if(entry.positionHash != positionHash || entry.turn != curTurn || entry.crntPlayer != crntPlayer) {
+            entry = {positionHash, curTurn, crntPlayer};
+        }
+        return &entry;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+namespace logic {
+    // See MappedFile.h
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+#ifdef _WIN32
+    // See MappedFile.h
+    bool MappedFile::open(const std::string& path, Access access)
+    {
+        close();
+        DWORD flags = access == Access::random ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+        HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+        if(fileHandle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        if(!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            return false;
+        }
+        file = fileHandle;
+        opened = true;
+
+        // Windows cannot map empty files
+        if(fileSize.QuadPart == 0) {
+            return true;
+        }
+        mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(!mapping) {
+            close();
+            return false;
+        }
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if(!data) {
+            close();
+            return false;
+        }
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    // See MappedFile.h
+    void MappedFile::close()
+    {
+        if(data) {
+            UnmapViewOfFile(data);
+        }
+        if(mapping) {
+            CloseHandle(mapping);
+        }
+        if(file) {
+            CloseHandle(file);
+        }
+        data = nullptr;
+        size = 0;
+        mapping = nullptr;
+        file = nullptr;
+        opened = false;
+    }
+#else
+    // See MappedFile.h
+    bool MappedFile::open(const std::string& path, Access access)
+    {
+        close();
+        int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+        if(fileDescriptor < 0) {
+            return false;
+        }
+        struct stat status{};
+        if(fstat(fileDescriptor, &status) != 0) {
+            ::close(fileDescriptor);
+            return false;
+        }
+        descriptor = fileDescriptor;
+        opened = true;
+
+        // mmap() cannot map empty files
+        if(status.st_size == 0) {
+            return true;
+        }
+        void* mapped = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(mapped == MAP_FAILED) {
+            close();
+            return false;
+        }
+        data = static_cast<const unsigned char*>(mapped);
+        size = static_cast<std::size_t>(status.st_size);
+
+        madvise(mapped, size, access == Access::random ? MADV_RANDOM : MADV_SEQUENTIAL);
+        return true;
+    }
+
+    // See MappedFile.h
+    void MappedFile::close()
+    {
+        if(data) {
+            munmap(const_cast<unsigned char*>(data), size);
+        }
+        if(descriptor >= 0) {
+            ::close(descriptor);
+        }
+        data = nullptr;
+        size = 0;
+        descriptor = -1;
+        opened = false;
+    }
+#endif
+
+    // See MappedFile.h
+    bool MappedFile::isOpen()
+    {
+        return opened;
+    }
+
+    // See MappedFile.h
+    const unsigned char* MappedFile::getData()
+    {
+        return data;
+    }
+    std::size_t MappedFile::getSize()
+    {
+        return size;
+    }
+}
@@ -0,0 +1,227 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "PersistentBoard.h"
+#include "GameBoard.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+    // See PersistentBoard.h
+    PersistentBoard::PersistentBoard(NodePtr root, std::size_t pieceCount) : root{std::move(root)}, pieceCount{pieceCount}
+    {
+
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard::PersistentBoard()
+    {
+
+    }
+
+    // See PersistentBoard.h
+    std::uint64_t PersistentBoard::getPriority(Move::position position)
+    {
+        // splitmix64 of both coordinates
+        std::uint64_t hash = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(position.first)) << 32)
+            | static_cast<std::uint32_t>(position.second);
+        hash += 0x9E3779B97F4A7C15ull;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        return hash ^ (hash >> 31);
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard::NodePtr PersistentBoard::copyNode(const NodePtr& node, NodePtr left, NodePtr right)
+    {
+        return std::make_shared<const Node>(Node{node->piece, node->priority, std::move(left), std::move(right)});
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard::NodePtr PersistentBoard::insert(const NodePtr& node, const PieceInfo& piece, std::uint64_t priority)
+    {
+        if(!node) {
+            return std::make_shared<const Node>(Node{piece, priority, nullptr, nullptr});
+        }
+        if(piece.position == node->piece.position) {
+            return std::make_shared<const Node>(Node{piece, node->priority, node->left, node->right});
+        }
+
+        // Rotate the new node up while its priority is higher than its parent's
+        if(piece.position < node->piece.position) {
+            NodePtr left = insert(node->left, piece, priority);
+            if(left->priority > node->priority) {
+                return copyNode(left, left->left, copyNode(node, left->right, node->right));
+            }
+            return copyNode(node, std::move(left), node->right);
+        }
+        NodePtr right = insert(node->right, piece, priority);
+        if(right->priority > node->priority) {
+            return copyNode(right, copyNode(node, node->left, right->left), right->right);
+        }
+        return copyNode(node, node->left, std::move(right));
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard::NodePtr PersistentBoard::erase(const NodePtr& node, Move::position position)
+    {
+        if(position == node->piece.position) {
+            return merge(node->left, node->right);
+        }
+        if(position < node->piece.position) {
+            return copyNode(node, erase(node->left, position), node->right);
+        }
+        return copyNode(node, node->left, erase(node->right, position));
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard::NodePtr PersistentBoard::merge(const NodePtr& left, const NodePtr& right)
+    {
+        if(!left) {
+            return right;
+        }
+        if(!right) {
+            return left;
+        }
+        if(left->priority > right->priority) {
+            return copyNode(left, left->left, merge(left->right, right));
+        }
+        return copyNode(right, merge(left, right->left), right->right);
+    }
+
+    // See PersistentBoard.h
+    void PersistentBoard::collect(const NodePtr& node, std::vector<PieceInfo>& pieces)
+    {
+        if(!node) {
+            return;
+        }
+        collect(node->left, pieces);
+        pieces.push_back(node->piece);
+        collect(node->right, pieces);
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard PersistentBoard::fromBoard(GameBoard& board)
+    {
+        PersistentBoard persistentBoard{};
+        for(Move::position position : board.getAllPiecePositions()) {
+            Piece* piece = board.getPiece(position);
+            if(piece) {
+                persistentBoard = persistentBoard.setPiece({position, piece->getID(), piece->getPlayerMask(), piece->previouslyMoved()});
+            }
+        }
+        return persistentBoard;
+    }
+
+    // See PersistentBoard.h
+    bool PersistentBoard::toBoard(GameBoard& board, const PieceFactory& factory) const
+    {
+        for(const PieceInfo& info : getPieces()) {
+            std::unique_ptr<Piece> piece{factory(info.id, info.position)};
+            if(!piece) {
+                return false;
+            }
+            for(int player = 0; player < static_cast<int>(Piece::Player::last); player++) {
+                if(info.playerMask & (std::uint32_t{1} << player)) {
+                    piece->addPlayer(static_cast<Piece::Player>(player));
+                }
+            }
+            if(info.moved) {
+                piece->validateMove();
+            }
+            if(!board.addPiece(piece.get())) {
+                return false;
+            }
+            piece.release();
+        }
+        return true;
+    }
+
+    // See PersistentBoard.h
+    const PersistentBoard::PieceInfo* PersistentBoard::getPiece(Move::position position) const
+    {
+        const Node* node = root.get();
+        while(node) {
+            if(position == node->piece.position) {
+                return &node->piece;
+            }
+            node = position < node->piece.position ? node->left.get() : node->right.get();
+        }
+        return nullptr;
+    }
+
+    // See PersistentBoard.h
+    std::vector<PersistentBoard::PieceInfo> PersistentBoard::getPieces() const
+    {
+        std::vector<PieceInfo> pieces{};
+        pieces.reserve(pieceCount);
+        collect(root, pieces);
+        return pieces;
+    }
+
+    // See PersistentBoard.h
+    std::size_t PersistentBoard::getPieceCount() const
+    {
+        return pieceCount;
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard PersistentBoard::setPiece(const PieceInfo& piece) const
+    {
+        std::size_t count = getPiece(piece.position) ? pieceCount : pieceCount + 1;
+        return PersistentBoard{insert(root, piece, getPriority(piece.position)), count};
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard PersistentBoard::removePiece(Move::position position) const
+    {
+        if(!getPiece(position)) {
+            return *this;
+        }
+        return PersistentBoard{erase(root, position), pieceCount - 1};
+    }
+
+    // See PersistentBoard.h
+    PersistentBoard PersistentBoard::movePiece(Move::position start, Move::position end) const
+    {
+        const PieceInfo* piece = getPiece(start);
+        if(!piece || start == end) {
+            return *this;
+        }
+        PieceInfo moved = *piece;
+        moved.position = end;
+        moved.moved = true;
+        return removePiece(start).setPiece(moved);
+    }
+
+    // See PersistentBoard.h
+    bool PersistentBoard::operator==(const PersistentBoard& other) const
+    {
+        return root == other.root || (pieceCount == other.pieceCount && getPieces() == other.getPieces());
+    }
+
+    // See PersistentBoard.h
+    std::size_t PersistentBoard::countNodes(const std::vector<PersistentBoard>& boards)
+    {
+        // Shared subtrees are only walked once
+        std::unordered_set<const Node*> seen{};
+        std::vector<const Node*> stack{};
+        for(const PersistentBoard& board : boards) {
+            stack.push_back(board.root.get());
+            while(!stack.empty()) {
+                const Node* node = stack.back();
+                stack.pop_back();
+                if(!node || !seen.insert(node).second) {
+                    continue;
+                }
+                stack.push_back(node->left.get());
+                stack.push_back(node->right.get());
+            }
+        }
+        return seen.size();
+    }
+}
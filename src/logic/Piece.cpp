@@ -1,28 +1,20 @@
 #include <iostream>
+#include <algorithm>
 #include <utility>
 #include <set>
+#include <cstdint>
+#include <bit>
 
+#include "HashPair.h"
 #include "Piece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Stats.h"
 
 namespace logic {
     
     using Player = Piece::Player;
 
-    // Let the compiler know that these functions exist
-    class GameBoard {
-        public:
-            bool inSimulation();
-    };
-
-    class GameState {
-        public: 
-            int getPriority();
-            int getTurn();
-            Player getCrntPlayer();
-            int getPriorityOfPlayer(Player player);
-            GameBoard* getBoard();
-    };
-
     // See Piece.h
     Piece::Piece(Move::position startPos) : piecePosition{ startPos } 
     { 
@@ -55,10 +47,17 @@ namespace logic {
         return players;
     }
 
+    // See Piece.h
+    std::uint32_t Piece::getPlayerMask()
+    {
+        return playerMask;
+    }
+
     // See Piece.h
     void Piece::addPlayer(Player newPlayer)
     {
         players[newPlayer] = true;
+        playerMask |= std::uint32_t{1} << static_cast<int>(newPlayer);
     }
 
     // See Piece.h
@@ -73,6 +72,7 @@ namespace logic {
     void Piece::removePlayer(Player player)
     {
         players[player] = false;
+        playerMask &= ~(std::uint32_t{1} << static_cast<int>(player));
     }
 
     // See Piece.h
@@ -120,109 +120,257 @@ namespace logic {
     }
 
     // See Piece.h
-    std::vector<Move>& Piece::getMoves(GameState& gameState, bool ignorePriority) 
+    std::size_t Piece::MoveCacheKeyHash::operator()(const MoveCacheKey& key) const
     {
-        // Store values for later
-        int curTurn = gameState.getTurn();
-        std::vector<Move>* cache;
-        GameBoard* board = gameState.getBoard();
+        std::uint64_t state = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.turn)) << 8)
+            | static_cast<std::uint64_t>(key.player);
+        return static_cast<std::size_t>(key.positionHash ^ hash_tuple::mix64(state));
+    }
 
-        // Get the simulated cache if you are in a simulation
-        if(board && board->inSimulation()) {
-            cache = &simulatedMoveCache;
+    // See Piece.h
+    bool Piece::cacheEntryValid(MoveCacheEntry& entry, GameState& gameState, MoveCacheKey& key)
+    {
+        if(!entry.valid || entry.key.player != key.player) {
+            return false;
+        }
+
+        // Without a board, nothing is recorded, so only reuse moves on the same turn
+        GameBoard* board = gameState.getBoard();
+        if((!board || entry.dependencies.turn) && entry.key.turn != key.turn) {
+            return false;
+        }
+        return !board || board->dependenciesHold(entry.dependencies);
+    }
 
-            // Always updated the simulated cache
-            *cache = generateMoves(gameState);
+    // See Piece.h
+    Piece::MoveCacheEntry& Piece::getCachedMoves(GameState& gameState, MoveList list)
+    {
+        // Identify the current game state
+        GameBoard* board = gameState.getBoard();
+        MoveCacheKey key{board ? board->getPositionHash() ^ gameState.getStateKey() : 0, gameState.getTurn(), gameState.getCrntPlayer()};
+        bool attacking = list == MoveList::attackingMoves;
+        bool pseudoLegal = list == MoveList::pseudoLegalMoves;
+        Stats::Cache statsCache = attacking ? Stats::Cache::attackMoves 
+            : pseudoLegal ? Stats::Cache::pseudoLegalMoves : Stats::Cache::moves;
+
+        // Reuse the regular cache if nothing it depends on has changed
+        // - Whatever the cached moves depended on is also a dependency of any
+        //   move generation that is using them
+        MoveCacheEntry& cache = attacking ? attackMoveCache 
+            : pseudoLegal ? pseudoLegalMoveCache : moveCache;
+        if(cacheEntryValid(cache, gameState, key)) {
+            STATS_RECORD(recordCacheHit(statsCache));
+            if(board) {
+                board->recordDependencies(cache.dependencies);
+            }
+            return cache;
         }
-        else { // Get the regular cache otherwise
-            cache = &moveCache;
 
-            // Update the cache if it has not been updated this turn
-            if(moveCacheUpdateTurn != curTurn) {
-                *cache = generateMoves(gameState);
-                moveCacheUpdateTurn = curTurn;
+        // Otherwise, reuse the moves if this simulated position was seen before
+        bool simulating = board && board->inSimulation();
+        auto& simulatedCache = attacking ? simulatedAttackMoveCache 
+            : pseudoLegal ? simulatedPseudoLegalMoveCache : simulatedMoveCache;
+        if(simulating) {
+            auto found = simulatedCache.find(key);
+            if(found != simulatedCache.end()) {
+                STATS_RECORD(recordCacheHit(statsCache));
+                board->recordDependencies(found->second.dependencies);
+                return found->second;
+            }
+        }
+        STATS_RECORD(recordCacheMiss(statsCache));
+
+        // Generate the moves while recording what they depend on
+        // - Generate the moves before touching the caches since generating
+        //   moves can simulate and query this piece again
+        MoveCacheEntry entry{};
+        entry.key = key;
+        entry.valid = true;
+        if(board) {
+            board->beginDependencyRecording();
+            board->recordDependency(getPosition());
+            if(movesDependOnTurn()) {
+                board->recordTurnDependency();
             }
         }
+        // Only the generation itself is pseudo-legal, generations it starts 
+        // (ex: for attacked spaces) are not
+        bool wasPseudoLegal = gameState.generatingPseudoLegalMoves();
+        gameState.setPseudoLegalGeneration(pseudoLegal);
+        if(attacking) {
+            STATS_RECORD(recordGenerateAttackingMoves(getID()));
+            entry.moves = generateAttackingMoves(gameState);
+        }
+        else {
+            STATS_RECORD(recordGenerateMoves(getID()));
+            entry.moves = generateMoves(gameState);
+        }
+        gameState.setPseudoLegalGeneration(wasPseudoLegal);
+        if(board) {
+            entry.dependencies = board->endDependencyRecording();
+        }
+        if(!entry.moves.empty()) {
+            entry.minPriority = entry.moves.front().getPriority();
+            for(Move& move : entry.moves) {
+                entry.minPriority = std::min(entry.minPriority, move.getPriority());
+                entry.maxPriority = std::max(entry.maxPriority, move.getPriority());
+            }
+        }
+
+        // Store the moves in the regular cache if this is not a simulation
+        if(!simulating) {
+            cache = std::move(entry);
+            return cache;
+        }
+
+        // Make room in the simulated cache by dropping positions from previous 
+        // turns, which can never be used again
+        if(simulatedCache.size() >= simulatedCacheCapacity) {
+            std::erase_if(simulatedCache, [&key](const auto& cached) {
+                return cached.first.turn != key.turn;
+            });
+        }
+
+        // Store the moves in the overflow cache if the cache is still full
+        if(simulatedCache.size() >= simulatedCacheCapacity) {
+            MoveCacheEntry& overflow = attacking ? overflowAttackMoveCache 
+                : pseudoLegal ? overflowPseudoLegalMoveCache : overflowMoveCache;
+            overflow = std::move(entry);
+            return overflow;
+        }
+        return simulatedCache.insert_or_assign(key, std::move(entry)).first->second;
+    }
 
+    // See Piece.h
+    void Piece::clearMoveCache()
+    {
+        moveCache = {};
+        attackMoveCache = {};
+        simulatedMoveCache.clear();
+        simulatedAttackMoveCache.clear();
+        pseudoLegalMoveCache = {};
+        simulatedPseudoLegalMoveCache.clear();
+        overflowMoveCache = {};
+        overflowAttackMoveCache = {};
+        overflowPseudoLegalMoveCache = {};
+    }
+
+    // See Piece.h
+    std::vector<Move>& Piece::getMoves(GameState& gameState, bool ignorePriority) 
+    {
         // Do not check priority if the current player does not control the piece
         // or if ignorePriority is enabled
         if(!controlledByPlayer(gameState) || ignorePriority) {
-            return *cache;
+            return getCachedMoves(gameState, MoveList::moves).moves;
         }
 
-        // Filter out moves that don't have high enough priorities
-        std::vector<Move> validMoves{};
-        
+        // Find the priority before looking up the cache since finding the 
+        // priority queries the moves of every piece
         int priority = gameState.getPriority();
-        if(priority == 0) { // 0 priority means there are no valid moves
-            *cache = validMoves;
-            return *cache;
+        MoveCacheEntry& cache = getCachedMoves(gameState, MoveList::moves);
+
+        // Every move has a high enough priority, so nothing needs filtering
+        if(priority != 0 && cache.minPriority >= priority) {
+            return cache.moves;
         }
-        for(Move move : *cache) {
-            if(move.getPriority() < priority) {
-                continue;
+
+        // Filter out moves that don't have high enough priorities
+        if(cache.filteredPriority != priority) {
+            cache.filteredMoves.clear();
+            cache.filteredPriority = priority;
+            if(priority != 0) { // 0 priority means there are no valid moves
+                for(Move& move : cache.moves) {
+                    if(move.getPriority() >= priority) {
+                        cache.filteredMoves.push_back(move);
+                    }
+                }
             }
-            validMoves.push_back(move);
         }
-        *cache = validMoves;
-        return *cache;
+        return cache.filteredMoves;
     }
 
     // See Piece.h
-    std::vector<Move>& Piece::getAttackingMoves(GameState& gameState, bool ignorePriority) 
+    std::vector<Move>& Piece::getAttackingMoves(GameState& gameState)
     {
-        // Store values for later
-        int curTurn = gameState.getTurn();
-        std::vector<Move>* cache;
-        GameBoard* board = gameState.getBoard();
+        return getCachedMoves(gameState, MoveList::attackingMoves).moves;
+    }
 
-        // Get the simulated cache if you are in a simulation
-        if(board && board->inSimulation()) {
-            cache = &simulatedAttackMoveCache;
+    // See Piece.h
+    std::vector<Move>& Piece::getPseudoLegalMoves(GameState& gameState)
+    {
+        return getCachedMoves(gameState, MoveList::pseudoLegalMoves).moves;
+    }
 
-            // Always updated the simulated cache
-            *cache = generateAttackingMoves(gameState);
+    // See Piece.h
+    int Piece::getMaxPriorityOfMoves(GameState& gameState)
+    {
+        return getCachedMoves(gameState, MoveList::moves).maxPriority;
+    }
+
+    // See Piece.h
+    DestinationIndex& Piece::getDestinations(MoveCacheEntry& entry)
+    {
+        if(!entry.destinationsBuilt) {
+            entry.destinations.build(entry.moves);
+            entry.destinationsBuilt = true;
         }
-        else { // Get the regular cache otherwise
-            cache = &attackMoveCache;
+        return entry.destinations;
+    }
 
-            // Update the cache if it has not been updated this turn
-            if(attackMoveCacheUpdateTurn != curTurn) {
-                *cache = generateAttackingMoves(gameState);
-                attackMoveCacheUpdateTurn = curTurn;
-            }
+    // See Piece.h
+    bool Piece::canReach(GameState& gameState, Move::position end, int minPriority)
+    {
+        MoveCacheEntry& cache = getCachedMoves(gameState, MoveList::moves);
+        DestinationIndex& destinations = getDestinations(cache);
+        if(destinations.indexed()) {
+            return destinations.contains(end) && destinations.getMaxPriority(end) >= minPriority;
         }
 
-        return *cache;
+        // Too many moves to index, so search them all
+        for(Move& move : cache.moves) {
+            if(move.getPriority() >= minPriority && move.containsPosition(end)) {
+                return true;
+            }
+        }
+        return false;
     }
 
     // See Piece.h
-    int Piece::getMaxPriorityOfMoves(GameState& gameState)
+    void Piece::getMovesTo(GameState& gameState, Move::position end, int minPriority, std::vector<Move>& movesTo)
     {
-        // Get all of the piece's moves
-        std::vector<Move> moves = getMoves(gameState, true);
+        MoveCacheEntry& cache = getCachedMoves(gameState, MoveList::moves);
+        DestinationIndex& destinations = getDestinations(cache);
+        if(destinations.indexed()) {
+            if(destinations.getMaxPriority(end) < minPriority) {
+                return;
+            }
+            for(std::uint64_t moveMask = destinations.getMoveMask(end); moveMask != 0; moveMask &= moveMask - 1) {
+                Move& move = cache.moves[std::countr_zero(moveMask)];
+                if(move.getPriority() >= minPriority) {
+                    movesTo.push_back(move);
+                }
+            }
+            return;
+        }
 
-        // Iterate through the moves to find the max priority
-        int maxPriority = 0;
-        for(Move move : moves) {
-            int curPriority = move.getPriority();
-            if(curPriority > maxPriority) {
-                maxPriority = curPriority;
+        // Too many moves to index, so search them all
+        for(Move& move : cache.moves) {
+            if(move.getPriority() >= minPriority && move.containsPosition(end)) {
+                movesTo.push_back(move);
             }
         }
-        return maxPriority;
     }
 
     // See Piece.h
     std::vector<Move::position> Piece::getAttackedSpaces(GameState& gameState)
     {
-        std::vector<Move> attackMoves = getAttackingMoves(gameState);
+        std::vector<Move>& attackMoves = getAttackingMoves(gameState);
         if(attackMoves.size() == 0) {
             return {};
         }
 
         std::set<Move::position> attackPositionsSet{};
-        for(Move attackMove : attackMoves) {
+        for(Move& attackMove : attackMoves) {
             const std::vector<Move::position>& curAttackPositions = attackMove.getPositions();
             for(Move::position position : curAttackPositions) {
                 attackPositionsSet.insert(position);
@@ -0,0 +1,215 @@
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "Search.h"
+#include "StagedMoveGenerator.h"
+#include "GameBoard.h"
+#include "Evaluator.h"
+#include "GameState.h"
+
+namespace logic {
+    using Player = Piece::Player;
+    using Stage = StagedMoveGenerator::Stage;
+
+    // See Search.h
+    Search::Search(GameState& gameState, Evaluation evaluate) :
+        gameState{ gameState }, evaluate{ evaluate } {}
+
+    // See Search.h
+    double Search::boardEvaluation(GameState& gameState)
+    {
+        Evaluator* evaluator = gameState.getBoard()->getEvaluator();
+        if(!evaluator) {
+            return materialEvaluation(gameState);
+        }
+        return evaluator->evaluate(gameState.getCrntPlayer());
+    }
+
+    // See Search.h
+    double Search::materialEvaluation(GameState& gameState)
+    {
+        GameBoard* board = gameState.getBoard();
+        double score = 0.0;
+        for(int i = 0; i < gameState.getPlayerCount(); i++) {
+            double material = 0.0;
+            for(Move::position position : board->getPiecesOfPlayer(gameState.getPlayer(i))) {
+                material += board->getPiece(position)->getValue();
+            }
+            score += i == 0 ? material : -material;
+        }
+        return score;
+    }
+
+    // See Search.h
+    Search::Result Search::findBestMove(int depth)
+    {
+        Result result{};
+        double alpha = -std::numeric_limits<double>::infinity();
+        double beta = std::numeric_limits<double>::infinity();
+
+        // Search the moves that movePiece() accepts so the result can be played
+        std::vector<GameState::LegalMove> legalMoves{};
+        gameState.generateAllLegalMoves(legalMoves);
+        for(GameState::LegalMove& legalMove : legalMoves) {
+            std::vector<Move> moves = gameState.getMovesOfPiece(legalMove.start, legalMove.end);
+            if(static_cast<std::size_t>(legalMove.idx) >= moves.size()
+                || !gameState.makeSimulatedMove(legalMove.start, legalMove.end, moves[legalMove.idx])) {
+                continue;
+            }
+            double score = -alphaBeta(std::max(depth, 1) - 1, -beta, -alpha);
+            gameState.unmakeSimulatedMove();
+
+            if(!result.found || score > result.score) {
+                result = {legalMove, score, true};
+                alpha = std::max(alpha, score);
+            }
+        }
+        return result;
+    }
+
+    // See Search.h
+    double Search::alphaBeta(int depth, double alpha, double beta)
+    {
+        if(isDraw()) {
+            return 0.0;
+        }
+        if(depth <= 0) {
+            return quiescence(alpha, beta);
+        }
+        nodes++;
+
+        StagedMoveGenerator generator{gameState};
+        StagedMoveGenerator::StagedMove stagedMove{};
+        double best = -std::numeric_limits<double>::infinity();
+        bool moved = false;
+        while(generator.next(stagedMove)) {
+            if(!gameState.makeSimulatedMove(stagedMove.start, stagedMove.end, *stagedMove.move)) {
+                continue;
+            }
+            moved = true;
+            double score = -alphaBeta(depth - 1, -beta, -alpha);
+            gameState.unmakeSimulatedMove();
+
+            best = std::max(best, score);
+            alpha = std::max(alpha, score);
+            if(alpha >= beta) {
+                break; // The opponent will never allow this position
+            }
+        }
+
+        if(!moved) {
+            return scoreWithoutMoves();
+        }
+        return best;
+    }
+
+    // See Search.h
+    double Search::quiescence(double alpha, double beta, int ply)
+    {
+        quiescenceNodes++;
+        if(isDraw()) {
+            return 0.0;
+        }
+
+        // Forced moves must be made, so the player can only stand pat without them
+        StagedMoveGenerator generator{gameState, true};
+        StagedMoveGenerator::StagedMove stagedMove{};
+        bool hasMove = generator.next(stagedMove);
+        double best = -std::numeric_limits<double>::infinity();
+
+        // Without tactical moves, the player may not have any moves at all
+        if(!hasMove && !gameState.canMove()) {
+            return scoreWithoutMoves();
+        }
+        if(!hasMove || stagedMove.stage != Stage::forced || ply >= maxQuiescencePly) {
+            best = evaluate(gameState);
+            if(best >= beta || ply >= maxQuiescencePly) {
+                return best;
+            }
+            alpha = std::max(alpha, best);
+        }
+
+        for(; hasMove; hasMove = generator.next(stagedMove)) {
+            if(!gameState.makeSimulatedMove(stagedMove.start, stagedMove.end, *stagedMove.move)) {
+                continue;
+            }
+            double score = -quiescence(-beta, -alpha, ply + 1);
+            gameState.unmakeSimulatedMove();
+
+            best = std::max(best, score);
+            alpha = std::max(alpha, score);
+            if(alpha >= beta) {
+                break;
+            }
+        }
+
+        // Every forced move failed to apply
+        if(best == -std::numeric_limits<double>::infinity()) {
+            return evaluate(gameState);
+        }
+        return best;
+    }
+
+    // See Search.h
+    std::uint64_t Search::perft(int depth)
+    {
+        if(depth <= 0) {
+            return 1;
+        }
+
+        // The generator only hands out legal moves, so the last move does not
+        // need to be made
+        StagedMoveGenerator generator{gameState};
+        StagedMoveGenerator::StagedMove stagedMove{};
+        std::uint64_t count = 0;
+        while(generator.next(stagedMove)) {
+            if(depth == 1) {
+                count++;
+                continue;
+            }
+            if(!gameState.makeSimulatedMove(stagedMove.start, stagedMove.end, *stagedMove.move)) {
+                continue;
+            }
+            count += perft(depth - 1);
+            gameState.unmakeSimulatedMove();
+        }
+        return count;
+    }
+
+    // See Search.h
+    bool Search::isDraw()
+    {
+        // The root position is searched even if it is drawn
+        return gameState.getSimulatedMoveCount() > 0
+            && (gameState.isDrawByRepetition() || gameState.isDrawByHalfmoveClock());
+    }
+
+    // See Search.h
+    double Search::scoreWithoutMoves()
+    {
+        if(!gameState.losesWithoutMoves()) {
+            return 0.0;
+        }
+        return -(mateScore - gameState.getSimulatedMoveCount());
+    }
+
+    // See Search.h
+    std::uint64_t Search::getNodeCount()
+    {
+        return nodes;
+    }
+
+    // See Search.h
+    std::uint64_t Search::getQuiescenceNodeCount()
+    {
+        return quiescenceNodes;
+    }
+
+    // See Search.h
+    void Search::resetNodeCounts()
+    {
+        nodes = 0;
+        quiescenceNodes = 0;
+    }
+}
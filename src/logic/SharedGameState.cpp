@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "SharedGameState.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+    using Player = Piece::Player;
+
+    // See SharedGameState.h
+    GameSnapshot::GameSnapshot(GameState& gameState) :
+        turn{gameState.getTurn()}, crntPlayer{gameState.getCrntPlayer()}, positionKey{gameState.getPositionKey()}
+    {
+        gameState.generateAllLegalMoves(legalMoves);
+        std::sort(legalMoves.begin(), legalMoves.end(), [](const GameState::LegalMove& a, const GameState::LegalMove& b) {
+            return std::tie(a.start, a.end, a.idx) < std::tie(b.start, b.end, b.idx);
+        });
+
+        // Pieces controlled by several players are only copied once
+        GameBoard* board = gameState.getBoard();
+        for(int i = 0; i < gameState.getPlayerCount(); i++) {
+            Player player = gameState.getPlayer(i);
+            for(Move::position position : board->getPiecesOfPlayer(player)) {
+                Piece* piece = board->getPiece(position);
+                if(piece) {
+                    pieces.push_back({position, piece->getID(), piece->getPlayerMask(), piece->previouslyMoved()});
+                }
+            }
+            std::vector<Move::position> attacked = gameState.getSpacesAttackedByPlayer(player);
+            std::sort(attacked.begin(), attacked.end());
+            attacked.erase(std::unique(attacked.begin(), attacked.end()), attacked.end());
+            attackedSpaces.emplace_back(player, std::move(attacked));
+        }
+        std::sort(pieces.begin(), pieces.end(), [](const PieceInfo& a, const PieceInfo& b) { return a.position < b.position; });
+        pieces.erase(std::unique(pieces.begin(), pieces.end(), [](const PieceInfo& a, const PieceInfo& b) {
+            return a.position == b.position;
+        }), pieces.end());
+    }
+
+    // See SharedGameState.h
+    int GameSnapshot::getTurn() const
+    {
+        return turn;
+    }
+
+    // See SharedGameState.h
+    Player GameSnapshot::getCrntPlayer() const
+    {
+        return crntPlayer;
+    }
+
+    // See SharedGameState.h
+    std::uint64_t GameSnapshot::getPositionKey() const
+    {
+        return positionKey;
+    }
+
+    // See SharedGameState.h
+    const std::vector<GameState::LegalMove>& GameSnapshot::getLegalMoves() const
+    {
+        return legalMoves;
+    }
+
+    // See SharedGameState.h
+    bool GameSnapshot::isLegal(Move::position start, Move::position end, int idx) const
+    {
+        auto found = std::lower_bound(legalMoves.begin(), legalMoves.end(), std::tie(start, end, idx),
+            [](const GameState::LegalMove& move, const std::tuple<Move::position&, Move::position&, int&>& target) {
+                return std::tie(move.start, move.end, move.idx) < target;
+            });
+        return found != legalMoves.end() && found->start == start && found->end == end && found->idx == idx;
+    }
+
+    // See SharedGameState.h
+    const std::vector<GameSnapshot::PieceInfo>& GameSnapshot::getPieces() const
+    {
+        return pieces;
+    }
+
+    // See SharedGameState.h
+    const GameSnapshot::PieceInfo* GameSnapshot::getPiece(Move::position position) const
+    {
+        auto found = std::lower_bound(pieces.begin(), pieces.end(), position, [](const PieceInfo& piece, const Move::position& target) {
+            return piece.position < target;
+        });
+        return found != pieces.end() && found->position == position ? &*found : nullptr;
+    }
+
+    // See SharedGameState.h
+    const std::vector<Move::position>& GameSnapshot::getSpacesAttackedByPlayer(Player player) const
+    {
+        static const std::vector<Move::position> none{};
+        for(const auto& [attacker, spaces] : attackedSpaces) {
+            if(attacker == player) {
+                return spaces;
+            }
+        }
+        return none;
+    }
+
+    // See SharedGameState.h
+    bool GameSnapshot::isAttacked(Player player, Move::position position) const
+    {
+        for(const auto& [attacker, spaces] : attackedSpaces) {
+            if(attacker != player && std::binary_search(spaces.begin(), spaces.end(), position)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // See SharedGameState.h
+    SharedGameState::SharedGameState(GameState& gameState) : gameState{gameState}
+    {
+        publish();
+    }
+
+    // See SharedGameState.h
+    std::shared_ptr<const GameSnapshot> SharedGameState::getSnapshot() const
+    {
+        return snapshot.load();
+    }
+
+    // See SharedGameState.h
+    bool SharedGameState::movePiece(Move::position start, Move::position end, int idx)
+    {
+        std::lock_guard<std::mutex> lock{writeMutex};
+        if(!gameState.movePiece(start, end, idx)) {
+            return false;
+        }
+        snapshot.store(std::make_shared<const GameSnapshot>(gameState));
+        return true;
+    }
+
+    // See SharedGameState.h
+    void SharedGameState::publish()
+    {
+        std::lock_guard<std::mutex> lock{writeMutex};
+        snapshot.store(std::make_shared<const GameSnapshot>(gameState));
+    }
+}
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "SparseBoard.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace logic {
+
+    // See SparseBoard.h
+    Move::position SparseBoard::tileOf(Move::position position)
+    {
+        // Arithmetic shifts round towards negative infinity, so negative
+        // coordinates land in the correct tile
+        return std::make_pair(position.first >> tileBits, position.second >> tileBits);
+    }
+
+    // See SparseBoard.h
+    int SparseBoard::localIndex(Move::position position)
+    {
+        return (position.first & (tileSize - 1)) | ((position.second & (tileSize - 1)) << tileBits);
+    }
+
+    // See SparseBoard.h
+    void SparseBoard::LineIndex::insert(std::int64_t key, int coord)
+    {
+        std::vector<int>& line = lines[key];
+        line.insert(std::lower_bound(line.begin(), line.end(), coord), coord);
+    }
+
+    // See SparseBoard.h
+    void SparseBoard::LineIndex::erase(std::int64_t key, int coord)
+    {
+        auto found = lines.find(key);
+        if(found == lines.end()) {
+            return;
+        }
+        std::vector<int>& line = found->second;
+        auto position = std::lower_bound(line.begin(), line.end(), coord);
+        if(position != line.end() && *position == coord) {
+            line.erase(position);
+        }
+    }
+
+    // See SparseBoard.h
+    long long SparseBoard::LineIndex::distanceToNext(std::int64_t key, int coord, int sign) const
+    {
+        auto found = lines.find(key);
+        if(found == lines.end()) {
+            return -1;
+        }
+        const std::vector<int>& line = found->second;
+        if(sign > 0) {
+            auto next = std::upper_bound(line.begin(), line.end(), coord);
+            return next == line.end() ? -1 : static_cast<long long>(*next) - coord;
+        }
+        auto next = std::lower_bound(line.begin(), line.end(), coord);
+        return next == line.begin() ? -1 : static_cast<long long>(coord) - *(next - 1);
+    }
+
+    // See SparseBoard.h
+    const SparseBoard::Tile* SparseBoard::findTile(Move::position position) const
+    {
+        auto tile = tiles.find(tileOf(position));
+        if(tile == tiles.end()) {
+            return nullptr;
+        }
+        return tile->second.get();
+    }
+
+    // See SparseBoard.h
+    Piece* SparseBoard::get(Move::position position) const
+    {
+        const Tile* tile = findTile(position);
+        if(!tile) {
+            return nullptr;
+        }
+        return tile->squares[localIndex(position)];
+    }
+
+    // See SparseBoard.h
+    bool SparseBoard::occupied(Move::position position) const
+    {
+        const Tile* tile = findTile(position);
+        return tile && (tile->occupancy >> localIndex(position)) & 1;
+    }
+
+    // See SparseBoard.h
+    void SparseBoard::set(Move::position position, Piece* piece)
+    {
+        // Only allocate a tile when something is actually being placed in it
+        auto found = tiles.find(tileOf(position));
+        if(found == tiles.end()) {
+            if(!piece) {
+                return;
+            }
+            found = tiles.emplace(tileOf(position), std::make_unique<Tile>()).first;
+        }
+        Tile& tile = *found->second;
+
+        // Update the square, the occupancy mask, and the piece count
+        int idx = localIndex(position);
+        std::uint64_t bit = std::uint64_t{1} << idx;
+        bool wasOccupied = tile.occupancy & bit;
+        if(tile.squares[idx]) {
+            updateHashes(tile.squares[idx], position);
+            updateRosterSizes(tile.squares[idx], -1);
+        }
+        if(piece) {
+            updateHashes(piece, position);
+            updateRosterSizes(piece, 1);
+        }
+        tile.squares[idx] = piece;
+        if(piece) {
+            tile.occupancy |= bit;
+            pieceCount += wasOccupied ? 0 : 1;
+        }
+        else {
+            tile.occupancy &= ~bit;
+            pieceCount -= wasOccupied ? 1 : 0;
+        }
+
+        // Keep the line indices in sync when the position changes between empty and occupied
+        if(wasOccupied == (piece != nullptr)) {
+            return;
+        }
+        std::int64_t x = position.first;
+        std::int64_t y = position.second;
+        if(piece) {
+            rows.insert(y, position.first);
+            columns.insert(x, position.second);
+            diagonals.insert(x - y, position.first);
+            antiDiagonals.insert(x + y, position.first);
+        }
+        else {
+            rows.erase(y, position.first);
+            columns.erase(x, position.second);
+            diagonals.erase(x - y, position.first);
+            antiDiagonals.erase(x + y, position.first);
+        }
+    }
+
+    // See SparseBoard.h
+    int SparseBoard::size() const
+    {
+        return pieceCount;
+    }
+
+    // See SparseBoard.h
+    int SparseBoard::tileCount() const
+    {
+        return static_cast<int>(tiles.size());
+    }
+
+    // See SparseBoard.h
+    std::uint64_t SparseBoard::hash() const
+    {
+        return positionHash;
+    }
+
+    // See SparseBoard.h
+    std::uint64_t SparseBoard::rosterHash(Piece::Player player) const
+    {
+        return rosterHashes[static_cast<int>(player)];
+    }
+
+    // See SparseBoard.h
+    int SparseBoard::rosterSize(Piece::Player player) const
+    {
+        return rosterSizes[static_cast<int>(player)];
+    }
+
+    // See SparseBoard.h
+    void SparseBoard::updateRosterSizes(Piece* piece, int change)
+    {
+        std::uint32_t mask = piece->getPlayerMask();
+        for(std::size_t player = 0; player < rosterSizes.size(); player++) {
+            if((mask >> player) & 1) {
+                rosterSizes[player] += change;
+            }
+        }
+    }
+
+    // See SparseBoard.h
+    void SparseBoard::updateHashes(Piece* piece, Move::position position)
+    {
+        std::uint64_t key = pieceKey(piece, position);
+        positionHash ^= key;
+        std::uint32_t mask = piece->getPlayerMask();
+        for(std::size_t player = 0; player < rosterHashes.size(); player++) {
+            if((mask >> player) & 1) {
+                rosterHashes[player] ^= key;
+            }
+        }
+    }
+
+    // See SparseBoard.h
+    std::uint64_t SparseBoard::pieceKey(Piece* piece, Move::position position)
+    {
+        return hash_tuple::zobrist_key(piece->getID(), piece->getPlayerMask(), position.first, position.second);
+    }
+
+    // See SparseBoard.h
+    int SparseBoard::findNextOccupied(Move::position start, Move::position direction, int maxSteps) const
+    {
+        if(direction.first == 0 && direction.second == 0) {
+            return -1;
+        }
+
+        // Straight unit rays jump directly to the first blocker using the line indices
+        if(std::abs(direction.first) <= 1 && std::abs(direction.second) <= 1) {
+            std::int64_t x = start.first;
+            std::int64_t y = start.second;
+            long long distance;
+            if(direction.second == 0) {
+                distance = rows.distanceToNext(y, start.first, direction.first);
+            }
+            else if(direction.first == 0) {
+                distance = columns.distanceToNext(x, start.second, direction.second);
+            }
+            else if(direction.first == direction.second) {
+                distance = diagonals.distanceToNext(x - y, start.first, direction.first);
+            }
+            else {
+                distance = antiDiagonals.distanceToNext(x + y, start.first, direction.first);
+            }
+            return (distance < 0 || distance > maxSteps) ? -1 : static_cast<int>(distance);
+        }
+
+        // Use 64 bit coordinates so long rays cannot overflow
+        long long x = start.first;
+        long long y = start.second;
+        long long steps = 0;
+        while(steps < maxSteps && pieceCount > 0) {
+            x += direction.first;
+            y += direction.second;
+            steps++;
+            if(x < INT32_MIN || x > INT32_MAX || y < INT32_MIN || y > INT32_MAX) {
+                return -1;
+            }
+            Move::position position = std::make_pair(static_cast<int>(x), static_cast<int>(y));
+            const Tile* tile = findTile(position);
+
+            // Check the position directly if its tile has pieces
+            if(tile && tile->occupancy != 0) {
+                if((tile->occupancy >> localIndex(position)) & 1) {
+                    return static_cast<int>(steps);
+                }
+                continue;
+            }
+
+            // Otherwise, skip every remaining step that stays inside of this tile
+            long long skip = maxSteps;
+            if(direction.first != 0) {
+                long long local = x & (tileSize - 1);
+                long long remaining = direction.first > 0 ? (tileSize - 1 - local) / direction.first : local / -direction.first;
+                skip = std::min(skip, remaining);
+            }
+            if(direction.second != 0) {
+                long long local = y & (tileSize - 1);
+                long long remaining = direction.second > 0 ? (tileSize - 1 - local) / direction.second : local / -direction.second;
+                skip = std::min(skip, remaining);
+            }
+            skip = std::min(skip, maxSteps - steps);
+            x += skip * direction.first;
+            y += skip * direction.second;
+            steps += skip;
+        }
+        return -1;
+    }
+}
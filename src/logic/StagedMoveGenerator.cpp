@@ -0,0 +1,199 @@
+#include <vector>
+#include <memory>
+#include <typeinfo>
+
+#include "StagedMoveGenerator.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Action.h"
+#include "AddPieceAction.h"
+
+namespace logic {
+    using Player = Piece::Player;
+
+    // See StagedMoveGenerator.h
+    StagedMoveGenerator::StagedMoveGenerator(GameState& gameState, bool tacticalOnly) : 
+        gameState{ gameState }, tacticalOnly{ tacticalOnly }
+    {
+        piecePositions = gameState.getBoard()->getPiecesOfPlayer(gameState.getCrntPlayer());
+        minPriority = gameState.getPriorityBound();
+    }
+
+    // See StagedMoveGenerator.h
+    bool StagedMoveGenerator::addsPiece(Move& move)
+    {
+        for(std::shared_ptr<Action>& action : move.getPostMoveActions()) {
+            if(typeid(*action) == typeid(AddPieceAction)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // See StagedMoveGenerator.h
+    StagedMoveGenerator::Stage StagedMoveGenerator::getStageOf(Piece* attacker, Move& pseudoLegalMove, Move::position position)
+    {
+        int priority = pseudoLegalMove.getPriority();
+        if(priority < minPriority) {
+            return Stage::done;
+        }
+        if(priority > Move::lowestPriority) {
+            return Stage::forced;
+        }
+        Piece* victim = gameState.getBoard()->getPiece(position);
+        if(victim && victim != attacker && !victim->getPlayerAccess(gameState.getCrntPlayer())) {
+            return Stage::captures;
+        }
+        return addsPiece(pseudoLegalMove) ? Stage::promotions : Stage::quiets;
+    }
+
+    // See StagedMoveGenerator.h
+    void StagedMoveGenerator::collectCandidates()
+    {
+        candidates.clear();
+        nextCandidate = 0;
+        collected = true;
+
+        GameBoard* board = gameState.getBoard();
+        Player player = gameState.getCrntPlayer();
+        for(Move::position start : piecePositions) {
+            Piece* attacker = board->getPiece(start);
+            if(!attacker) {
+                continue;
+            }
+            std::vector<Move>& pseudoLegalMoves = attacker->getPseudoLegalMoves(gameState);
+            for(std::size_t idx = 0; idx < pseudoLegalMoves.size(); idx++) {
+                Move& pseudoLegalMove = pseudoLegalMoves[idx];
+                for(Move::position position : pseudoLegalMove.getPositions()) {
+                    if(getStageOf(attacker, pseudoLegalMove, position) != stage) {
+                        continue;
+                    }
+                    Candidate candidate{start, position, idx, pseudoLegalMove.getPriority()};
+                    Piece* victim = board->getPiece(position);
+                    if(victim && victim != attacker && !victim->getPlayerAccess(player)) {
+                        candidate.victimValue = victim->getValue();
+                        candidate.attackerValue = attacker->getValue();
+                    }
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+    }
+
+    // See StagedMoveGenerator.h
+    bool StagedMoveGenerator::better(const Candidate& a, const Candidate& b)
+    {
+        if(a.priority != b.priority) {
+            return a.priority > b.priority;
+        }
+        if(a.victimValue != b.victimValue) {
+            return a.victimValue > b.victimValue;
+        }
+        return a.attackerValue < b.attackerValue;
+    }
+
+    // See StagedMoveGenerator.h
+    Move* StagedMoveGenerator::takeCandidate(Candidate& candidate)
+    {
+        GameBoard* board = gameState.getBoard();
+        if(stage == Stage::forced || stage == Stage::captures) {
+            if(!collected) {
+                collectCandidates();
+            }
+            while(nextCandidate < candidates.size()) {
+                std::size_t best = nextCandidate;
+                for(std::size_t i = nextCandidate + 1; i < candidates.size(); i++) {
+                    if(better(candidates[i], candidates[best])) {
+                        best = i;
+                    }
+                }
+                std::swap(candidates[nextCandidate], candidates[best]);
+                candidate = candidates[nextCandidate++];
+
+                // The piece's moves may have been regenerated since they were
+                // collected, but the same position always has the same moves
+                Piece* piece = board->getPiece(candidate.start);
+                if(piece) {
+                    std::vector<Move>& pseudoLegalMoves = piece->getPseudoLegalMoves(gameState);
+                    if(candidate.moveIdx < pseudoLegalMoves.size()) {
+                        return &pseudoLegalMoves[candidate.moveIdx];
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        // Promotions and quiet moves are read from each piece as they are needed
+        for(; pieceIdx < piecePositions.size(); pieceIdx++, moveIdx = 0) {
+            Move::position start = piecePositions[pieceIdx];
+            Piece* piece = board->getPiece(start);
+            if(!piece) {
+                continue;
+            }
+            std::vector<Move>& pseudoLegalMoves = piece->getPseudoLegalMoves(gameState);
+            for(; moveIdx < pseudoLegalMoves.size(); moveIdx++, positionIdx = 0) {
+                Move& pseudoLegalMove = pseudoLegalMoves[moveIdx];
+                const std::vector<Move::position>& positions = pseudoLegalMove.getPositions();
+                while(positionIdx < positions.size()) {
+                    Move::position end = positions[positionIdx++];
+                    if(getStageOf(piece, pseudoLegalMove, end) == stage) {
+                        candidate = {start, end, moveIdx, pseudoLegalMove.getPriority()};
+                        return &pseudoLegalMove;
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // See StagedMoveGenerator.h
+    bool StagedMoveGenerator::next(StagedMove& nextMove)
+    {
+        while(stage != Stage::done) {
+            Candidate candidate{};
+            Move* pseudoLegalMove = takeCandidate(candidate);
+
+            // Move on once the stage runs out of candidates
+            if(!pseudoLegalMove) {
+                // A legal forced move blocks every move with less priority
+                if(stage == Stage::forced && allowedPriority != -1) {
+                    stage = Stage::done;
+                    break;
+                }
+                stage = static_cast<Stage>(static_cast<int>(stage) + 1);
+                collected = false;
+                pieceIdx = 0;
+                moveIdx = 0;
+                positionIdx = 0;
+                if(tacticalOnly && stage == Stage::quiets) {
+                    stage = Stage::done;
+                }
+                continue;
+            }
+
+            // Forced moves are handed out from highest to lowest priority, so
+            // the first lower priority means every legal forced move was found
+            if(allowedPriority != -1 && candidate.priority < allowedPriority) {
+                stage = Stage::done;
+                break;
+            }
+
+            move = *pseudoLegalMove;
+            if(!gameState.isLegal(candidate.start, candidate.end, move)) {
+                continue;
+            }
+            if(allowedPriority == -1) {
+                allowedPriority = candidate.priority;
+            }
+            nextMove = {candidate.start, candidate.end, &move, candidate.priority, stage};
+            return true;
+        }
+        return false;
+    }
+
+    // See StagedMoveGenerator.h
+    StagedMoveGenerator::Stage StagedMoveGenerator::getStage()
+    {
+        return stage;
+    }
+}
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#include "Stats.h"
+
+namespace logic {
+    namespace {
+        using Counter = std::atomic<std::uint64_t>;
+
+        /*
+        * Every counter recorded by Stats
+        */
+        struct Counters
+        {
+            std::array<Counter, Stats::maxTrackedID> generateMoves{};
+            std::array<Counter, Stats::maxTrackedID> generateAttackingMoves{};
+            std::array<Counter, static_cast<int>(Stats::Cache::last)> cacheHits{};
+            std::array<Counter, static_cast<int>(Stats::Cache::last)> cacheMisses{};
+            Counter simulationsStarted{0};
+            Counter simulationsReverted{0};
+            std::array<Counter, static_cast<int>(Stats::Timer::last)> timerCalls{};
+            std::array<Counter, static_cast<int>(Stats::Timer::last)> timerNanoseconds{};
+
+            /*
+            * Action types are not known ahead of time, so they are counted in a
+            * map guarded by a mutex
+            */
+            std::mutex actionsMutex{};
+            std::unordered_map<std::type_index, std::uint64_t> actions{};
+        };
+
+        Counters& counters()
+        {
+            static Counters instance{};
+            return instance;
+        }
+
+        /*
+        * Returns the counter slot used for a piece ID
+        */
+        int idSlot(int id)
+        {
+            return std::clamp(id, 0, Stats::maxTrackedID - 1);
+        }
+
+        /*
+        * Returns the readable name of a type
+        */
+        std::string typeName(const std::type_index& type)
+        {
+            #ifdef __GNUG__
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+            if(status == 0 && demangled) {
+                std::string name{demangled};
+                std::free(demangled);
+                return name;
+            }
+            #endif
+            return type.name();
+        }
+
+        /*
+        * Writes the non-zero entries of a per-ID counter array as a JSON object
+        */
+        void writeIDCounters(std::ostream& os, const std::array<Counter, Stats::maxTrackedID>& ids)
+        {
+            os << "{";
+            bool first = true;
+            for(int id = 0; id < Stats::maxTrackedID; id++) {
+                std::uint64_t count = ids[id].load(std::memory_order_relaxed);
+                if(count == 0) {
+                    continue;
+                }
+                os << (first ? "" : ",") << "\"" << id << "\":" << count;
+                first = false;
+            }
+            os << "}";
+        }
+    }
+
+    // See Stats.h
+    Stats::ScopedTimer::ScopedTimer(Timer timer) : timer{timer}, running{Stats::isEnabled()}
+    {
+        if(running) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    // See Stats.h
+    Stats::ScopedTimer::~ScopedTimer()
+    {
+        if(running) {
+            recordTime(timer, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+    }
+
+    // See Stats.h
+    void Stats::setEnabled(bool enabled)
+    {
+        Stats::enabled.store(enabled && compiledIn(), std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    bool Stats::compiledIn()
+    {
+        #ifdef ENABLE_STATS
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
+    // See Stats.h
+    void Stats::reset()
+    {
+        Counters& stats = counters();
+        for(int id = 0; id < maxTrackedID; id++) {
+            stats.generateMoves[id] = 0;
+            stats.generateAttackingMoves[id] = 0;
+        }
+        for(int cache = 0; cache < static_cast<int>(Cache::last); cache++) {
+            stats.cacheHits[cache] = 0;
+            stats.cacheMisses[cache] = 0;
+        }
+        for(int timer = 0; timer < static_cast<int>(Timer::last); timer++) {
+            stats.timerCalls[timer] = 0;
+            stats.timerNanoseconds[timer] = 0;
+        }
+        stats.simulationsStarted = 0;
+        stats.simulationsReverted = 0;
+        std::lock_guard<std::mutex> lock{stats.actionsMutex};
+        stats.actions.clear();
+    }
+
+    // See Stats.h
+    void Stats::recordGenerateMoves(int id)
+    {
+        counters().generateMoves[idSlot(id)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordGenerateAttackingMoves(int id)
+    {
+        counters().generateAttackingMoves[idSlot(id)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordCacheHit(Cache cache)
+    {
+        counters().cacheHits[static_cast<int>(cache)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordCacheMiss(Cache cache)
+    {
+        counters().cacheMisses[static_cast<int>(cache)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordSimulationStarted()
+    {
+        counters().simulationsStarted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordSimulationReverted()
+    {
+        counters().simulationsReverted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::recordAction(const std::type_info& type)
+    {
+        Counters& stats = counters();
+        std::lock_guard<std::mutex> lock{stats.actionsMutex};
+        stats.actions[std::type_index{type}]++;
+    }
+
+    // See Stats.h
+    void Stats::recordTime(Timer timer, std::chrono::nanoseconds duration)
+    {
+        Counters& stats = counters();
+        stats.timerCalls[static_cast<int>(timer)].fetch_add(1, std::memory_order_relaxed);
+        stats.timerNanoseconds[static_cast<int>(timer)].fetch_add(duration.count(), std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getGenerateMoves(int id)
+    {
+        return counters().generateMoves[idSlot(id)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getGenerateAttackingMoves(int id)
+    {
+        return counters().generateAttackingMoves[idSlot(id)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getCacheHits(Cache cache)
+    {
+        return counters().cacheHits[static_cast<int>(cache)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getCacheMisses(Cache cache)
+    {
+        return counters().cacheMisses[static_cast<int>(cache)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getSimulationsStarted()
+    {
+        return counters().simulationsStarted.load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getSimulationsReverted()
+    {
+        return counters().simulationsReverted.load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getActions(const std::type_info& type)
+    {
+        Counters& stats = counters();
+        std::lock_guard<std::mutex> lock{stats.actionsMutex};
+        auto found = stats.actions.find(std::type_index{type});
+        return found == stats.actions.end() ? 0 : found->second;
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getTimerCalls(Timer timer)
+    {
+        return counters().timerCalls[static_cast<int>(timer)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    std::uint64_t Stats::getTimerNanoseconds(Timer timer)
+    {
+        return counters().timerNanoseconds[static_cast<int>(timer)].load(std::memory_order_relaxed);
+    }
+
+    // See Stats.h
+    void Stats::writeJSON(std::ostream& os)
+    {
+        Counters& stats = counters();
+        os << "{\"compiledIn\":" << (compiledIn() ? "true" : "false");
+        os << ",\"enabled\":" << (isEnabled() ? "true" : "false");
+
+        os << ",\"generateMoves\":";
+        writeIDCounters(os, stats.generateMoves);
+        os << ",\"generateAttackingMoves\":";
+        writeIDCounters(os, stats.generateAttackingMoves);
+
+        os << ",\"moveCache\":{\"hits\":" << getCacheHits(Cache::moves)
+           << ",\"misses\":" << getCacheMisses(Cache::moves) << "}";
+        os << ",\"attackMoveCache\":{\"hits\":" << getCacheHits(Cache::attackMoves)
+           << ",\"misses\":" << getCacheMisses(Cache::attackMoves) << "}";
+        os << ",\"pseudoLegalMoveCache\":{\"hits\":" << getCacheHits(Cache::pseudoLegalMoves)
+           << ",\"misses\":" << getCacheMisses(Cache::pseudoLegalMoves) << "}";
+
+        os << ",\"simulations\":{\"started\":" << getSimulationsStarted()
+           << ",\"reverted\":" << getSimulationsReverted() << "}";
+
+        // Sort actions by name so the output is stable
+        std::map<std::string, std::uint64_t> actions{};
+        {
+            std::lock_guard<std::mutex> lock{stats.actionsMutex};
+            for(const auto& [type, count] : stats.actions) {
+                actions[typeName(type)] += count;
+            }
+        }
+        os << ",\"actions\":{";
+        bool first = true;
+        for(const auto& [name, count] : actions) {
+            os << (first ? "" : ",") << "\"" << name << "\":" << count;
+            first = false;
+        }
+        os << "}";
+
+        os << ",\"addToMove\":{\"calls\":" << getTimerCalls(Timer::addToMove)
+           << ",\"nanoseconds\":" << getTimerNanoseconds(Timer::addToMove) << "}";
+        os << "}";
+    }
+}
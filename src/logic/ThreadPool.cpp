@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "ThreadPool.h"
+
+namespace logic {
+    // See ThreadPool.h
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if(threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threadCount);
+        for(std::size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    // See ThreadPool.h
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        taskAdded.notify_all();
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // See ThreadPool.h
+    std::size_t ThreadPool::getThreadCount()
+    {
+        return workers.size();
+    }
+
+    // See ThreadPool.h
+    void ThreadPool::work()
+    {
+        while(true) {
+            std::function<void()> task{};
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                taskAdded.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+                // Only stop once every task has been taken
+                if(tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+}
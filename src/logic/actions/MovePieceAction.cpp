@@ -12,10 +12,18 @@ namespace logic {
         }
         appliedEnd = end;
         movedPiece = board->getPiece(std::make_pair(end.first + startPos.first, end.second + startPos.second));
-        return board->movePiece(
+        if(!board->movePiece(
             std::make_pair(end.first + startPos.first, end.second + startPos.second),
             std::make_pair(end.first + endPos.first, end.second + endPos.second)
-        );
+        )) {
+            return false;
+        }
+
+        // Simulated moves also count as moves, so a piece that moves away and
+        // back during a search knows it has moved (ex: a king can no longer castle)
+        wasMoved = movedPiece->previouslyMoved();
+        movedPiece->validateMove();
+        return true;
     }
 
     // See MovePieceAction.h
@@ -24,10 +32,16 @@ namespace logic {
         if(!board) {
             return false;
         }
-        return board->movePiece(
+        if(!board->movePiece(
             std::make_pair(appliedEnd.first + endPos.first, appliedEnd.second + endPos.second),
             std::make_pair(appliedEnd.first + startPos.first, appliedEnd.second + startPos.second)
-        );
+        )) {
+            return false;
+        }
+        if(movedPiece && !wasMoved) {
+            movedPiece->unValidateMove();
+        }
+        return true;
     }
 
     // See MovePieceAction.h
@@ -2,6 +2,8 @@
 #define TESTPIECES_H
 
 #include "ChessPiece.h"
+#include "GameBoard.h"
+#include "GameState.h"
 
 namespace testing {
     // A class for testing max piece priority
@@ -177,6 +179,45 @@ namespace testing {
             }
     };
 
+    // A piece that counts how many times its moves are generated
+    // - Its moves depend on whether the position diagonally up and to the right is occupied
+    class CountingPiece : public logic::Piece
+    {
+        public:
+            using logic::Piece::Piece;
+            int generated{0};
+            int attackGenerated{0};
+            int minPriorityChecked{0};
+            bool dependsOnTurn{false};
+
+            bool movesDependOnTurn() override
+            {
+                return dependsOnTurn;
+            }
+
+            int getMinPriority(logic::GameState& gameState) override
+            {
+                minPriorityChecked++;
+                return 0;
+            }
+
+        private:
+            std::vector<logic::Move> generateMoves(logic::GameState& gameState) override
+            {
+                generated++;
+                logic::Move::position diagonal = std::make_pair(getPosition().first + 1, getPosition().second + 1);
+                if(gameState.getBoard() && gameState.getBoard()->occupiedOnBoard(diagonal)) {
+                    return {};
+                }
+                return {{{diagonal}}};
+            }
+            std::vector<logic::Move> generateAttackingMoves(logic::GameState& gameState) override
+            {
+                attackGenerated++;
+                return {{{std::make_pair(1, 1)}}};
+            } 
+    };
+
     class TestKing : public chess::ChessPiece
     {
         public:
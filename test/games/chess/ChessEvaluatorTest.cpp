@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "doctest.h"
+#include "ChessEvaluator.h"
+#include "ChessGameState.h"
+#include "ChessBoard.h"
+#include "Evaluator.h"
+#include "Search.h"
+#include "Move.h"
+#include "Piece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Knight.h"
+#include "Pawn.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+
+TEST_CASE("Chess Evaluator: Piece-square values")
+{
+    ChessEvaluator evaluator{};
+    Pawn whitePawn{Player::white, std::make_pair(1, 2)};
+    Pawn blackPawn{Player::black, std::make_pair(1, 7)};
+    Knight knight{Player::white, std::make_pair(1, 1)};
+
+    // Pawns gain value as they advance
+    CHECK(evaluator.getPieceSquareValue(&whitePawn, std::make_pair(1, 2)) == 0);
+    CHECK(evaluator.getPieceSquareValue(&whitePawn, std::make_pair(1, 7)) == doctest::Approx(0.25));
+    CHECK(evaluator.getPieceSquareValue(&blackPawn, std::make_pair(1, 7)) == 0);
+    CHECK(evaluator.getPieceSquareValue(&blackPawn, std::make_pair(1, 2)) == doctest::Approx(0.25));
+
+    // Knights gain value near the center
+    CHECK(evaluator.getPieceSquareValue(&knight, std::make_pair(1, 1)) == 0);
+    CHECK(evaluator.getPieceSquareValue(&knight, std::make_pair(4, 5)) == doctest::Approx(0.3));
+}
+
+TEST_CASE("Chess Evaluator: Chess boards are evaluated")
+{
+    // The starting position is even
+    ChessGameState chessState{};
+    Evaluator* evaluator = chessState.getBoard()->getEvaluator();
+    REQUIRE(evaluator != nullptr);
+    CHECK(evaluator->evaluate(Player::white) == doctest::Approx(0.0));
+    CHECK(evaluator->getMaterial(Player::white) == doctest::Approx(evaluator->getMaterial(Player::black)));
+
+    // Advancing a pawn and developing a knight helps white
+    REQUIRE(chessState.movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+    CHECK(evaluator->evaluate(Player::white) == doctest::Approx(0.1));
+    REQUIRE(chessState.movePiece(std::make_pair(1, 7), std::make_pair(1, 6)));
+    REQUIRE(chessState.movePiece(std::make_pair(7, 1), std::make_pair(6, 3)));
+    CHECK(evaluator->evaluate(Player::white) == doctest::Approx(0.1 + 0.2 - 0.05));
+}
+
+TEST_CASE("Chess Evaluator: Incremental scores match scores from scratch")
+{
+    // Play a game with a fixed pseudo-random sequence of legal moves, searching
+    // before each move so every move is also simulated and reverted
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    std::vector<GameState::LegalMove> legalMoves{};
+    unsigned int seed = 97531;
+    for(int ply = 0; ply < 20; ply++) {
+        Search search{chessState};
+        search.findBestMove(1);
+
+        // Score the board from scratch with a new evaluator
+        Evaluator* evaluator = board->getEvaluator();
+        double white = evaluator->evaluate(Player::white);
+        double whiteMaterial = evaluator->getMaterial(Player::white);
+        double blackMaterial = evaluator->getMaterial(Player::black);
+        board->setEvaluator(new ChessEvaluator());
+        evaluator = board->getEvaluator();
+        CHECK(evaluator->evaluate(Player::white) == doctest::Approx(white));
+        CHECK(evaluator->getMaterial(Player::white) == doctest::Approx(whiteMaterial));
+        CHECK(evaluator->getMaterial(Player::black) == doctest::Approx(blackMaterial));
+
+        chessState.generateAllLegalMoves(legalMoves);
+        if(legalMoves.empty()) {
+            break;
+        }
+        seed = seed * 1103515245 + 12345;
+        GameState::LegalMove move = legalMoves[(seed >> 16) % legalMoves.size()];
+        REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    }
+}
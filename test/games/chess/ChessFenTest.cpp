@@ -0,0 +1,185 @@
+#include <vector>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+#include "doctest.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "Move.h"
+#include "Piece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Pawn.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+
+/*
+* Returns the sorted legal moves of the current player
+*/
+static std::vector<std::pair<Move::position, Move::position>> getLegalMoves(GameState& gameState)
+{
+    std::vector<GameState::LegalMove> legalMoves{};
+    gameState.generateAllLegalMoves(legalMoves);
+    std::vector<std::pair<Move::position, Move::position>> moves{};
+    for(GameState::LegalMove& legalMove : legalMoves) {
+        moves.push_back(std::make_pair(legalMove.start, legalMove.end));
+    }
+    std::sort(moves.begin(), moves.end());
+    return moves;
+}
+
+TEST_CASE("Chess FEN: Load the starting position")
+{
+    // The loaded position has the same moves as a new game
+    std::unique_ptr<ChessGameState> loaded{ChessFen::load(ChessFen::startPosition)};
+    REQUIRE(loaded != nullptr);
+    ChessGameState chessState{};
+    CHECK(loaded->getBoard()->getPositionHash() == chessState.getBoard()->getPositionHash());
+    CHECK(loaded->getCrntPlayer() == Player::white);
+    CHECK(loaded->getTurn() == chessState.getTurn());
+    CHECK(getLegalMoves(*loaded) == getLegalMoves(chessState));
+
+    // Both positions are written the same way
+    CHECK(ChessFen::toString(*loaded) == ChessFen::startPosition);
+    CHECK(ChessFen::toString(chessState) == ChessFen::startPosition);
+}
+
+TEST_CASE("Chess FEN: Positions from a game are written and loaded")
+{
+    // Play a few moves, including a castle
+    ChessGameState chessState{};
+    std::vector<std::pair<Move::position, Move::position>> moves{
+        {std::make_pair(5, 2), std::make_pair(5, 4)},
+        {std::make_pair(5, 7), std::make_pair(5, 5)},
+        {std::make_pair(7, 1), std::make_pair(6, 3)},
+        {std::make_pair(2, 8), std::make_pair(3, 6)},
+        {std::make_pair(6, 1), std::make_pair(3, 4)},
+        {std::make_pair(7, 8), std::make_pair(6, 6)},
+        {std::make_pair(5, 1), std::make_pair(7, 1)}
+    };
+    for(auto& [start, end] : moves) {
+        REQUIRE(chessState.movePiece(start, end));
+    }
+    std::string fen = ChessFen::toString(chessState);
+    CHECK(fen == "r1bqkb1r/pppp1ppp/2n*2n*2/4p3/2B*1P3/5N*2/PPPP1PPP/RNBQ1R*K*1 b kq - 5 4");
+
+    // The loaded position is the same and has the same moves
+    std::unique_ptr<ChessGameState> loaded{ChessFen::load(fen)};
+    REQUIRE(loaded != nullptr);
+    CHECK(loaded->getBoard()->getPositionHash() == chessState.getBoard()->getPositionHash());
+    CHECK(loaded->getCrntPlayer() == Player::black);
+    CHECK(loaded->getTurn() == chessState.getTurn());
+    CHECK(loaded->getHalfmoveClock() == 5);
+    CHECK(getLegalMoves(*loaded) == getLegalMoves(chessState));
+    CHECK(ChessFen::toString(*loaded) == fen);
+}
+
+TEST_CASE("Chess FEN: Anarchy extensions")
+{
+    // A knook, a moved king, and a knight both players control
+    std::string_view fen = "4k3/8/8/3N[wb]4/8/8/8/O2K*4 w - - 12 30";
+    std::unique_ptr<ChessGameState> loaded{ChessFen::load(fen)};
+    REQUIRE(loaded != nullptr);
+    GameBoard* board = loaded->getBoard();
+    Piece* knook = board->getPiece(std::make_pair(1, 1));
+    REQUIRE(knook != nullptr);
+    CHECK(knook->getID() == KNOOK_ID);
+    CHECK(knook->getPlayerAccess(Player::white));
+    Piece* king = board->getPiece(std::make_pair(4, 1));
+    REQUIRE(king != nullptr);
+    CHECK(king->previouslyMoved());
+
+    // Without castling rights, kings on their starting squares have moved
+    CHECK(board->getPiece(std::make_pair(5, 8))->previouslyMoved());
+    Piece* knight = board->getPiece(std::make_pair(4, 5));
+    REQUIRE(knight != nullptr);
+    CHECK(knight->getPlayerAccess(Player::white));
+    CHECK(knight->getPlayerAccess(Player::black));
+    CHECK(loaded->getTurn() == 59);
+    CHECK(loaded->getHalfmoveClock() == 12);
+    CHECK(ChessFen::toString(*loaded) == fen);
+
+    // The board lists the shared knight for both players
+    for(Player player : {Player::white, Player::black}) {
+        std::vector<Move::position> pieces = board->getPiecesOfPlayer(player);
+        CHECK(std::find(pieces.begin(), pieces.end(), std::make_pair(4, 5)) != pieces.end());
+    }
+}
+
+TEST_CASE("Chess FEN: En Passant square")
+{
+    // White just boosted next to a black pawn, so black must En Passant
+    std::string_view fen = "4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1";
+    std::unique_ptr<ChessGameState> loaded{ChessFen::load(fen)};
+    REQUIRE(loaded != nullptr);
+    Pawn* pawn = static_cast<Pawn*>(loaded->getBoard()->getPiece(std::make_pair(5, 4)));
+    CHECK(pawn->getBoostTurn() == loaded->getTurn() - 1);
+    CHECK(loaded->getPriority() == 10);
+    CHECK(ChessFen::toString(*loaded) == fen);
+
+    // Without the En Passant square, black can move normally
+    std::unique_ptr<ChessGameState> noEnPassant{ChessFen::load("4k3/8/8/8/3pP3/8/8/4K3 b - - 0 1")};
+    REQUIRE(noEnPassant != nullptr);
+    CHECK(noEnPassant->getPriority() == 1);
+}
+
+TEST_CASE("Chess FEN: Copies keep the positions before them")
+{
+    // Move the knights out and back, so the starting position is repeated
+    ChessGameState chessState{};
+    std::vector<std::pair<Move::position, Move::position>> moves{
+        {std::make_pair(7, 1), std::make_pair(6, 3)},
+        {std::make_pair(7, 8), std::make_pair(6, 6)},
+        {std::make_pair(6, 3), std::make_pair(7, 1)},
+        {std::make_pair(6, 6), std::make_pair(7, 8)}
+    };
+    for(auto& [start, end] : moves) {
+        REQUIRE(chessState.movePiece(start, end));
+    }
+    std::unique_ptr<ChessGameState> copied{ChessFen::copy(chessState)};
+    REQUIRE(copied != nullptr);
+    CHECK(ChessFen::toString(*copied) == ChessFen::toString(chessState));
+    CHECK(copied->getRepetitionCount() == 2);
+
+    // The third time is a draw in the copy too
+    for(auto& [start, end] : moves) {
+        REQUIRE(copied->movePiece(start, end));
+    }
+    CHECK(copied->isDrawByRepetition());
+    CHECK(chessState.isDrawByRepetition() == false);
+
+    // Game states in the middle of a simulated move are not copied
+    std::vector<Move> knightMoves = chessState.getMovesOfPiece(std::make_pair(7, 1), std::make_pair(6, 3));
+    REQUIRE(chessState.makeSimulatedMove(std::make_pair(7, 1), std::make_pair(6, 3), knightMoves[0]));
+    CHECK(ChessFen::copy(chessState) == nullptr);
+    chessState.unmakeSimulatedMove();
+
+    // Only game states in the same position share a history
+    ChessGameState other{};
+    REQUIRE(other.movePiece(std::make_pair(2, 1), std::make_pair(3, 3)));
+    CHECK(copied->copyPositionHistory(other) == false);
+    CHECK(copied->isDrawByRepetition());
+}
+
+TEST_CASE("Chess FEN: Invalid positions are rejected")
+{
+    CHECK(ChessFen::load("") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkx - 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - x 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 extra") == nullptr);
+    CHECK(ChessFen::load("rnbq1bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQ - 0 1") == nullptr);
+    CHECK(ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN[x] w KQkq - 0 1") == nullptr);
+
+    // The move numbers may be left out
+    std::unique_ptr<ChessGameState> loaded{ChessFen::load("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -")};
+    REQUIRE(loaded != nullptr);
+    CHECK(loaded->getTurn() == 1);
+}
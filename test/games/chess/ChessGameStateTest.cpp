@@ -1,13 +1,23 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <tuple>
+#include <random>
+#include <memory>
 
 #include "doctest.h"
 #include "ChessGameState.h"
+#include "ChessFen.h"
 #include "Move.h"
 #include "Piece.h"
 #include "GameBoard.h"
 #include "GameState.h"
+#include "Action.h"
+#include "MovePieceAction.h"
+#include "King.h"
+#include "Rook.h"
+#include "Bishop.h"
+#include "Knight.h"
 
 using namespace logic;
 using namespace chess;
@@ -113,3 +123,437 @@ TEST_CASE("Chess Game State: Initialize Object With Imported Board")
     // Make sure checkmate is properly detected
     CHECK(chessState->isInCheckmate(Player::white));
 }
+
+TEST_CASE("Chess Game State: Cached moves match freshly generated moves")
+{
+    // Play the same game in two game states, clearing every move cache in the
+    // second game before each position is checked
+    ChessGameState cachedState{};
+    ChessGameState freshState{};
+    GameBoard* cachedBoard = cachedState.getBoard();
+    GameBoard* freshBoard = freshState.getBoard();
+
+    // Summarizes a list of moves by their positions and priorities
+    auto summarize = [](std::vector<Move>& moves) {
+        std::vector<std::pair<std::vector<Move::position>, int>> summary{};
+        for(Move& move : moves) {
+            summary.emplace_back(move.getPositions(), move.getPriority());
+        }
+        return summary;
+    };
+
+    // Pick moves with a fixed pseudo-random sequence so the game is always the same
+    unsigned int seed = 20240611;
+    for(int ply = 0; ply < 40; ply++) {
+        for(Player player : {Player::white, Player::black}) {
+            for(Move::position position : freshBoard->getPiecesOfPlayer(player)) {
+                freshBoard->getPiece(position)->clearMoveCache();
+            }
+        }
+
+        // Every piece's moves and attacks must be the same in both games
+        std::vector<std::tuple<Move::position, Move::position, int>> legalMoves{};
+        for(Player player : {Player::white, Player::black}) {
+            for(Move::position position : cachedBoard->getPiecesOfPlayer(player)) {
+                Piece* cachedPiece = cachedBoard->getPiece(position);
+                Piece* freshPiece = freshBoard->getPiece(position);
+                REQUIRE(freshPiece != nullptr);
+                CHECK(summarize(cachedPiece->getMoves(cachedState, true)) == summarize(freshPiece->getMoves(freshState, true)));
+                CHECK(summarize(cachedPiece->getAttackingMoves(cachedState)) == summarize(freshPiece->getAttackingMoves(freshState)));
+            }
+        }
+
+        // Find every legal move in the cached game
+        for(Move::position start : cachedState.getPiecesOfCrntPlayer()) {
+            std::vector<Move::position> ends{};
+            for(Move& move : cachedBoard->getPiece(start)->getMoves(cachedState)) {
+                for(Move::position end : move.getPositions()) {
+                    ends.push_back(end);
+                }
+            }
+            std::sort(ends.begin(), ends.end());
+            ends.erase(std::unique(ends.begin(), ends.end()), ends.end());
+            for(Move::position end : ends) {
+                int variants = static_cast<int>(cachedState.getMovesOfPiece(start, end).size());
+                for(int idx = 0; idx < variants; idx++) {
+                    legalMoves.emplace_back(start, end, idx);
+                }
+            }
+        }
+        if(legalMoves.empty()) {
+            break;
+        }
+
+        // Make the same move in both games
+        seed = seed * 1103515245 + 12345;
+        auto [start, end, idx] = legalMoves[(seed >> 16) % legalMoves.size()];
+        REQUIRE(cachedState.movePiece(start, end, idx));
+        REQUIRE(freshState.movePiece(start, end, idx));
+        CHECK(cachedBoard->getPositionHash() == freshBoard->getPositionHash());
+    }
+}
+
+TEST_CASE("Chess Game State: Generate all legal moves")
+{
+    // Play a game with a fixed pseudo-random sequence of legal moves
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    std::vector<GameState::LegalMove> legalMoves{};
+    unsigned int seed = 1234567;
+    for(int ply = 0; ply < 30; ply++) {
+        chessState.generateAllLegalMoves(legalMoves);
+
+        // Every legal move must be found by checking every square of every piece
+        // - Each move to an end position is listed once for each of its variants
+        std::vector<GameState::LegalMove> expected{};
+        for(Move::position start : chessState.getPiecesOfCrntPlayer()) {
+            for(int i = 1; i <= 8; i++) {
+                for(int j = 1; j <= 8; j++) {
+                    Move::position end = std::make_pair(i, j);
+                    if(!chessState.canMovePiece(start, end)) {
+                        continue;
+                    }
+                    std::vector<Move> variants = chessState.getMovesOfPiece(start, end);
+                    for(int idx = 0; idx < variants.size(); idx++) {
+                        expected.push_back({start, end, idx, variants[idx].getPriority()});
+                    }
+                }
+            }
+        }
+        auto byPosition = [](const GameState::LegalMove& a, const GameState::LegalMove& b) {
+            return std::tie(a.start, a.end, a.idx) < std::tie(b.start, b.end, b.idx);
+        };
+        std::vector<GameState::LegalMove> found = legalMoves;
+        std::sort(found.begin(), found.end(), byPosition);
+        std::sort(expected.begin(), expected.end(), byPosition);
+        CHECK(found == expected);
+        if(legalMoves.empty()) {
+            break;
+        }
+
+        // Make one of the moves
+        seed = seed * 1103515245 + 12345;
+        GameState::LegalMove move = legalMoves[(seed >> 16) % legalMoves.size()];
+        REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    }
+}
+
+TEST_CASE("Chess Game State: Sliding pieces can block check from a distance")
+{
+    // Put white in check with a rook and give white a bishop that can block it
+    ChessBoard* board = new ChessBoard(false);
+    board->addPieces({
+        new King(Player::white, std::make_pair(5, 1)),
+        new King(Player::black, std::make_pair(1, 8)),
+        new Rook(Player::black, std::make_pair(5, 8)),
+        new Bishop(Player::white, std::make_pair(1, 3))
+    });
+    ChessGameState chessState{board};
+    REQUIRE(chessState.isInCheck());
+
+    // Only the square that blocks the check can be moved to
+    CHECK(chessState.canMovePiece(std::make_pair(1, 3), std::make_pair(5, 7)));
+    CHECK(chessState.canMovePiece(std::make_pair(1, 3), std::make_pair(2, 4)) == false);
+    CHECK(chessState.canMovePiece(std::make_pair(1, 3), std::make_pair(4, 6)) == false);
+}
+
+TEST_CASE("Chess Game State: Pseudo-legal moves checked with isLegal match legal moves")
+{
+    // Play a game with a fixed pseudo-random sequence of legal moves
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    std::vector<GameState::LegalMove> legalMoves{};
+    unsigned int seed = 7654321;
+    for(int ply = 0; ply < 30; ply++) {
+        // Every pseudo-legal position that isLegal accepts must be a legal
+        // position with the same priority, and vice versa
+        for(Move::position start : chessState.getPiecesOfCrntPlayer()) {
+            Piece* piece = board->getPiece(start);
+            std::vector<std::pair<Move::position, int>> legal{};
+            for(Move& move : piece->getMoves(chessState, true)) {
+                for(Move::position end : move.getPositions()) {
+                    legal.emplace_back(end, move.getPriority());
+                }
+            }
+            std::vector<std::pair<Move::position, int>> checked{};
+            for(Move& move : piece->getPseudoLegalMoves(chessState)) {
+                for(Move::position end : move.getPositions()) {
+                    if(chessState.isLegal(start, end, move)) {
+                        checked.emplace_back(end, move.getPriority());
+                    }
+                }
+            }
+            std::sort(legal.begin(), legal.end());
+            std::sort(checked.begin(), checked.end());
+            CHECK(checked == legal);
+        }
+        CHECK(board->inSimulation() == false);
+
+        chessState.generateAllLegalMoves(legalMoves);
+        if(legalMoves.empty()) {
+            break;
+        }
+
+        // Checking a move while another move is simulated keeps the other move
+        GameState::LegalMove move = legalMoves[0];
+        std::shared_ptr<Action> outerMove = std::make_shared<MovePieceAction>(std::make_pair(move.end.first - move.start.first, move.end.second - move.start.second));
+        std::uint64_t hash = board->getPositionHash();
+        REQUIRE(chessState.callAction(outerMove, move.start));
+        std::uint64_t simulatedHash = board->getPositionHash();
+        for(Move::position start : chessState.getPiecesOfCrntPlayer()) {
+            Piece* piece = board->getPiece(start);
+            for(Move& pseudoMove : piece->getPseudoLegalMoves(chessState)) {
+                for(Move::position end : pseudoMove.getPositions()) {
+                    chessState.isLegal(start, end, pseudoMove);
+                }
+            }
+        }
+        CHECK(board->getPositionHash() == simulatedHash);
+        REQUIRE(board->revertSimulation());
+        CHECK(board->getPositionHash() == hash);
+
+        // Make one of the moves
+        seed = seed * 1103515245 + 12345;
+        move = legalMoves[(seed >> 16) % legalMoves.size()];
+        REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    }
+}
+
+TEST_CASE("Chess Game State: Simulated moves can be unmade")
+{
+    // Move white's pawn next to where black's pawn can boost
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    REQUIRE(chessState.movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+    REQUIRE(chessState.movePiece(std::make_pair(1, 7), std::make_pair(1, 6)));
+    REQUIRE(chessState.movePiece(std::make_pair(5, 4), std::make_pair(5, 5)));
+    std::uint64_t positionHash = board->getPositionHash();
+    int turn = chessState.getTurn();
+
+    // Boost black's pawn in a simulation and make sure white must En Passant
+    std::vector<Move> boosts = chessState.getMovesOfPiece(std::make_pair(4, 7), std::make_pair(4, 5));
+    REQUIRE(boosts.size() == 1);
+    REQUIRE(chessState.makeSimulatedMove(std::make_pair(4, 7), std::make_pair(4, 5), boosts[0]));
+    CHECK(chessState.getCrntPlayer() == Player::white);
+    CHECK(chessState.getTurn() == turn + 1);
+    CHECK(chessState.getSimulatedMoveCount() == 1);
+    CHECK(chessState.getPriority() == 10);
+    CHECK(chessState.canMovePiece(std::make_pair(5, 5), std::make_pair(4, 6)));
+    CHECK(chessState.canMovePiece(std::make_pair(1, 2), std::make_pair(1, 3)) == false);
+
+    // Unmake the boost and make sure everything is restored
+    CHECK(chessState.unmakeSimulatedMove());
+    CHECK(chessState.unmakeSimulatedMove() == false);
+    CHECK(chessState.getCrntPlayer() == Player::black);
+    CHECK(chessState.getTurn() == turn);
+    CHECK(board->getPositionHash() == positionHash);
+    CHECK(board->getPiece(std::make_pair(4, 7)) != nullptr);
+    CHECK(chessState.getPriority() == 1);
+
+    // Actually boosting still allows En Passant
+    REQUIRE(chessState.movePiece(std::make_pair(4, 7), std::make_pair(4, 5)));
+    CHECK(chessState.getPriority() == 10);
+    CHECK(chessState.movePiece(std::make_pair(5, 5), std::make_pair(4, 6)));
+    CHECK(board->unoccupiedOnBoard(4, 5));
+}
+
+TEST_CASE("Chess Game State: Threefold repetition")
+{
+    // Shuffle both players' knights out and back
+    ChessGameState chessState{};
+    std::vector<std::pair<Move::position, Move::position>> shuffle{
+        {std::make_pair(7, 1), std::make_pair(6, 3)},
+        {std::make_pair(7, 8), std::make_pair(6, 6)},
+        {std::make_pair(6, 3), std::make_pair(7, 1)},
+        {std::make_pair(6, 6), std::make_pair(7, 8)}
+    };
+    CHECK(chessState.getRepetitionCount() == 1);
+    for(auto& [start, end] : shuffle) {
+        REQUIRE(chessState.movePiece(start, end));
+    }
+    CHECK(chessState.getRepetitionCount() == 2);
+    CHECK(chessState.getResult() == ChessGameState::Result::ongoing);
+
+    // The third time the starting position appears, the game is drawn
+    for(auto& [start, end] : shuffle) {
+        REQUIRE(chessState.getResult() == ChessGameState::Result::ongoing);
+        REQUIRE(chessState.movePiece(start, end));
+    }
+    CHECK(chessState.getRepetitionCount() == 3);
+    CHECK(chessState.isDrawByRepetition());
+    CHECK(chessState.getResult() == ChessGameState::Result::repetition);
+}
+
+TEST_CASE("Chess Game State: Halfmove clock")
+{
+    // Knight moves increment the clock and pawn moves reset it
+    ChessGameState chessState{};
+    CHECK(chessState.getHalfmoveClock() == 0);
+    REQUIRE(chessState.movePiece(std::make_pair(2, 1), std::make_pair(3, 3)));
+    CHECK(chessState.getHalfmoveClock() == 1);
+    REQUIRE(chessState.movePiece(std::make_pair(4, 7), std::make_pair(4, 5)));
+    CHECK(chessState.getHalfmoveClock() == 0);
+    REQUIRE(chessState.movePiece(std::make_pair(7, 1), std::make_pair(6, 3)));
+    REQUIRE(chessState.movePiece(std::make_pair(7, 8), std::make_pair(6, 6)));
+    CHECK(chessState.getHalfmoveClock() == 2);
+
+    // Captures reset the clock
+    REQUIRE(chessState.movePiece(std::make_pair(3, 3), std::make_pair(4, 5)));
+    CHECK(chessState.getHalfmoveClock() == 0);
+
+    // Knooklear fusion takes a piece off the board, but it is not a capture
+    std::unique_ptr<ChessGameState> fusion{ChessFen::load("4k3/8/8/8/8/8/2N5/R3K3 w - - 7 10")};
+    REQUIRE(fusion != nullptr);
+    REQUIRE(fusion->movePiece(std::make_pair(3, 2), std::make_pair(1, 1)));
+    REQUIRE(fusion->getBoard()->getPiece(std::make_pair(1, 1)) != nullptr);
+    CHECK(fusion->getBoard()->getPiece(std::make_pair(1, 1))->getID() == KNOOK_ID);
+    CHECK(fusion->getBoard()->getPieceCount() == 3);
+    CHECK(fusion->getHalfmoveClock() == 8);
+
+    // The game is drawn once the clock reaches the limit
+    chessState.setHalfmoveClock(GameState::halfmoveLimit - 1);
+    CHECK(chessState.getResult() == ChessGameState::Result::ongoing);
+    REQUIRE(chessState.movePiece(std::make_pair(2, 8), std::make_pair(3, 6)));
+    CHECK(chessState.isDrawByHalfmoveClock());
+    CHECK(chessState.getResult() == ChessGameState::Result::fiftyMoves);
+}
+
+TEST_CASE("Chess Game State: Simulated moves track repetitions")
+{
+    // Shuffle the knights until the next shuffle repeats the start a third time
+    ChessGameState chessState{};
+    std::vector<std::pair<Move::position, Move::position>> shuffle{
+        {std::make_pair(7, 1), std::make_pair(6, 3)},
+        {std::make_pair(7, 8), std::make_pair(6, 6)},
+        {std::make_pair(6, 3), std::make_pair(7, 1)},
+        {std::make_pair(6, 6), std::make_pair(7, 8)}
+    };
+    for(int i = 0; i < 6; i++) {
+        REQUIRE(chessState.movePiece(shuffle[i % 4].first, shuffle[i % 4].second));
+    }
+    CHECK(chessState.getRepetitionCount() == 2);
+    CHECK(chessState.getHalfmoveClock() == 6);
+
+    // Simulate the knights moving back
+    for(int i = 2; i < 4; i++) {
+        std::vector<Move> moves = chessState.getMovesOfPiece(shuffle[i].first, shuffle[i].second);
+        REQUIRE(moves.size() == 1);
+        REQUIRE(chessState.makeSimulatedMove(shuffle[i].first, shuffle[i].second, moves[0]));
+    }
+    CHECK(chessState.getHalfmoveClock() == 8);
+    CHECK(chessState.getResult() == ChessGameState::Result::repetition);
+
+    // Unmaking the moves forgets the positions
+    REQUIRE(chessState.unmakeSimulatedMove());
+    REQUIRE(chessState.unmakeSimulatedMove());
+    CHECK(chessState.getRepetitionCount() == 2);
+    CHECK(chessState.getHalfmoveClock() == 6);
+    CHECK(chessState.getResult() == ChessGameState::Result::ongoing);
+}
+
+TEST_CASE("Chess Game State: Self-play always ends")
+{
+    // Play random moves with only kings and knights until the game ends
+    auto playout = [](unsigned int seed) {
+        ChessBoard* board = new ChessBoard(false);
+        board->addPieces({
+            new King(Player::white, std::make_pair(5, 1)),
+            new King(Player::black, std::make_pair(5, 8)),
+            new Knight(Player::white, std::make_pair(2, 1)),
+            new Knight(Player::black, std::make_pair(2, 8))
+        });
+        ChessGameState chessState{board};
+        std::mt19937 random{seed};
+        std::vector<GameState::LegalMove> legalMoves{};
+        int plies = 0;
+        while(chessState.getResult() == ChessGameState::Result::ongoing) {
+            chessState.generateAllLegalMoves(legalMoves);
+            GameState::LegalMove& move = legalMoves[random() % legalMoves.size()];
+            REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+            plies++;
+        }
+        return std::make_tuple(plies, chessState.getResult(), board->getPositionHash());
+    };
+
+    // The same seed plays the same game
+    auto [plies, result, positionHash] = playout(7);
+    CHECK(plies <= 3 * GameState::halfmoveLimit);
+    CHECK(result != ChessGameState::Result::ongoing);
+    CHECK(playout(7) == std::make_tuple(plies, result, positionHash));
+}
+
+TEST_CASE("Chess Game State: En Passant and castling rights are part of the position")
+{
+    using Moves = std::vector<std::pair<Move::position, Move::position>>;
+    auto simulate = [](ChessGameState& chessState, const Moves& moves) {
+        for(const std::pair<Move::position, Move::position>& move : moves) {
+            std::vector<Move> movesToEnd = chessState.getMovesOfPiece(move.first, move.second);
+            REQUIRE(movesToEnd.size() > 0);
+            REQUIRE(chessState.makeSimulatedMove(move.first, move.second, movesToEnd[0]));
+        }
+    };
+    auto unmake = [](ChessGameState& chessState) {
+        while(chessState.unmakeSimulatedMove()) {}
+    };
+
+    // Both orders reach the same board on the same turn, but only a boost 
+    // allows En Passant
+    Moves boost{
+        {std::make_pair(5, 1), std::make_pair(4, 1)}, {std::make_pair(5, 8), std::make_pair(4, 8)},
+        {std::make_pair(4, 1), std::make_pair(4, 2)}, {std::make_pair(4, 8), std::make_pair(5, 8)},
+        {std::make_pair(4, 2), std::make_pair(5, 1)}, {std::make_pair(5, 8), std::make_pair(4, 8)},
+        {std::make_pair(5, 2), std::make_pair(5, 4)}
+    };
+    Moves steps{
+        {std::make_pair(5, 2), std::make_pair(5, 3)}, {std::make_pair(5, 8), std::make_pair(4, 8)},
+        {std::make_pair(5, 1), std::make_pair(4, 1)}, {std::make_pair(4, 8), std::make_pair(5, 8)},
+        {std::make_pair(4, 1), std::make_pair(5, 1)}, {std::make_pair(5, 8), std::make_pair(4, 8)},
+        {std::make_pair(5, 3), std::make_pair(5, 4)}
+    };
+    for(bool boostFirst : {true, false}) {
+        std::unique_ptr<ChessGameState> chessState{ChessFen::load("4k3/8/8/8/3p4/8/4P3/4K3 w - - 0 1")};
+        REQUIRE(chessState != nullptr);
+        std::uint64_t keys[2]{};
+        for(int i = 0; i < 2; i++) {
+            bool boosted = (i == 0) == boostFirst;
+            simulate(*chessState, boosted ? boost : steps);
+            keys[i] = chessState->getPositionKey();
+            CHECK(chessState->canMovePiece(std::make_pair(4, 4), std::make_pair(5, 3)) == boosted);
+            std::vector<GameState::LegalMove> legalMoves{};
+            chessState->generateAllLegalMoves(legalMoves);
+            if(boosted) {
+                CHECK(legalMoves.size() == 1);
+            }
+            else {
+                CHECK(legalMoves.size() > 1);
+            }
+            unmake(*chessState);
+        }
+        CHECK(keys[0] != keys[1]);
+    }
+
+    // Moving the king or a rook away and back loses castling rights
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1")};
+    std::uint64_t start = chessState->getPositionKey();
+    Moves kingMoves{
+        {std::make_pair(5, 1), std::make_pair(6, 1)}, {std::make_pair(1, 8), std::make_pair(2, 8)},
+        {std::make_pair(6, 1), std::make_pair(5, 1)}, {std::make_pair(2, 8), std::make_pair(1, 8)}
+    };
+    Moves rookMoves{
+        {std::make_pair(8, 1), std::make_pair(7, 1)}, {std::make_pair(1, 8), std::make_pair(2, 8)},
+        {std::make_pair(7, 1), std::make_pair(8, 1)}, {std::make_pair(2, 8), std::make_pair(1, 8)}
+    };
+    simulate(*chessState, kingMoves);
+    std::uint64_t afterKing = chessState->getPositionKey();
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(3, 1)) == false);
+    unmake(*chessState);
+    simulate(*chessState, rookMoves);
+    std::uint64_t afterRook = chessState->getPositionKey();
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(3, 1)));
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(7, 1)) == false);
+    unmake(*chessState);
+    CHECK(chessState->getPositionKey() == start);
+    CHECK(afterKing != afterRook);
+    CHECK(afterKing != start);
+    CHECK(afterRook != start);
+}
@@ -0,0 +1,87 @@
+#include <sstream>
+#include <string>
+
+#include "doctest.h"
+#include "EpdRunner.h"
+
+using namespace chess;
+
+TEST_CASE("EPD Runner: Perft counts are checked")
+{
+    // The starting position has 20 moves and 400 sequences of 2 moves, and
+    // black must En Passant before white has 3 king moves
+    EpdRunner::Options options{EpdRunner::Task::perft, 2, 2, 1};
+    std::istringstream input{
+        "# Perft suite\n"
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - D1 20; D2 400; id \"start\";\n"
+        "\n"
+        "4k3/8/8/8/3pP3/8/8/4K3 b - e3 D2 3;\n"
+        "4k3/8/8/8/8/8/8/4K3 w - - D2 1;\n"
+    };
+    std::ostringstream output{};
+    EpdRunner::Summary summary = EpdRunner{options}.run(input, output);
+    CHECK(summary.positions == 3);
+    CHECK(summary.failed == 1);
+    CHECK(output.str() ==
+        "2: perft 2 400 ok id \"start\"\n"
+        "4: perft 2 3 ok\n"
+        "5: perft 2 25 FAIL expected 1\n");
+}
+
+TEST_CASE("EPD Runner: Results stay in order")
+{
+    // Count the moves of many positions with more threads than pending results
+    std::string input{};
+    std::string expected{};
+    for(int i = 1; i <= 20; i++) {
+        if(i % 2 == 0) {
+            input += "4k3/8/8/8/8/8/8/4K3 w - -\n";
+            expected += std::to_string(i) + ": moves 5\n";
+        }
+        else {
+            input += "4k3/8/8/8/8/8/8/4K3 b - - hmvc 3; fmvn 10;\n";
+            expected += std::to_string(i) + ": moves 5\n";
+        }
+    }
+    input += "not a position\n";
+    expected += "21: error invalid position\n";
+
+    EpdRunner::Options options{EpdRunner::Task::count, 1, 4, 3};
+    std::istringstream inputStream{input};
+    std::ostringstream output{};
+    EpdRunner::Summary summary = EpdRunner{options}.run(inputStream, output);
+    CHECK(summary.positions == 21);
+    CHECK(summary.failed == 1);
+    CHECK(output.str() == expected);
+}
+
+TEST_CASE("EPD Runner: Move numbers keep En Passant and castling")
+{
+    // The move numbers must not lose the pawn that can be taken En Passant
+    EpdRunner::Options options{EpdRunner::Task::count, 1};
+    EpdRunner::LineResult result = EpdRunner::runLine("4k3/8/8/8/3pP3/8/8/4K3 b - e3 hmvc 0; fmvn 30;", options);
+    CHECK(result.text == "moves 1");
+
+    // White can still castle deep into the tree
+    options = {EpdRunner::Task::perft, 5};
+    result = EpdRunner::runLine("4k3/8/8/8/8/p6p/P6P/R3K2R w KQ - hmvc 4; fmvn 12; D4 5063; D5 97294;", options);
+    CHECK(result.failed == false);
+    CHECK(result.text == "perft 5 97294 ok");
+}
+
+TEST_CASE("EPD Runner: Search a position")
+{
+    // The white rook takes the undefended black queen
+    EpdRunner::Options options{EpdRunner::Task::search, 1};
+    EpdRunner::LineResult result = EpdRunner::runLine("7k/8/8/q7/8/8/8/R6K w - - id \"free queen\";", options);
+    CHECK(result.failed == false);
+    CHECK(result.text.rfind("bestmove a1a5 ", 0) == 0);
+    CHECK(result.text.find("id \"free queen\"") != std::string::npos);
+
+    // Checkmate is worth more than a free knight
+    result = EpdRunner::runLine("6k1/5ppp/8/8/8/8/8/Rn4K1 w - -", options);
+    CHECK(result.text.rfind("bestmove a1a8 ", 0) == 0);
+
+    CHECK(EpdRunner::isSkipped("  # comment"));
+    CHECK(EpdRunner::isSkipped("   "));
+}
@@ -0,0 +1,136 @@
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <filesystem>
+
+#include "doctest.h"
+#include "GameRecord.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameBoard.h"
+#include "Move.h"
+
+using namespace logic;
+using namespace chess;
+
+TEST_CASE("Game Record: Encode moves")
+{
+    // Every square and index survives encoding
+    for(int x = 1; x <= 8; x++) {
+        for(int y = 1; y <= 8; y++) {
+            std::uint16_t encoded = 0;
+            REQUIRE(GameRecord::encodeMove(std::make_pair(x, y), std::make_pair(9 - x, 9 - y), (x + y) % 16, encoded));
+            Move::position start{};
+            Move::position end{};
+            int idx = 0;
+            GameRecord::decodeMove(encoded, start, end, idx);
+            CHECK(start == std::make_pair(x, y));
+            CHECK(end == std::make_pair(9 - x, 9 - y));
+            CHECK(idx == (x + y) % 16);
+        }
+    }
+
+    // Moves off the board or with large indices cannot be stored
+    std::uint16_t encoded = 0;
+    CHECK(GameRecord::encodeMove(std::make_pair(0, 1), std::make_pair(1, 1), 0, encoded) == false);
+    CHECK(GameRecord::encodeMove(std::make_pair(1, 1), std::make_pair(1, 9), 0, encoded) == false);
+    CHECK(GameRecord::encodeMove(std::make_pair(1, 1), std::make_pair(1, 2), GameRecord::maxMoveIdx + 1, encoded) == false);
+}
+
+TEST_CASE("Game Record: Write, read, and replay games")
+{
+    // Record a short game and a game from a loaded position
+    GameRecord opening{};
+    REQUIRE(opening.addMove(std::make_pair(5, 2), std::make_pair(5, 4), 0));
+    REQUIRE(opening.addMove(std::make_pair(5, 7), std::make_pair(5, 5), 0));
+    REQUIRE(opening.addMove(std::make_pair(7, 1), std::make_pair(6, 3), 0));
+    GameRecord enPassant{};
+    enPassant.startFen = "4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1";
+    REQUIRE(enPassant.addMove(std::make_pair(4, 4), std::make_pair(5, 3), 0));
+    enPassant.result = ChessGameState::Result::stalemate;
+
+    std::ostringstream output{};
+    GameRecordWriter writer{output};
+    REQUIRE(writer.write(opening));
+    REQUIRE(writer.write(enPassant));
+    std::string bytes = output.str();
+    CHECK(bytes.size() == 8 + (8 + 6) + (8 + 34 + 2));
+
+    // Read the games back without copying them
+    GameRecordReader reader{};
+    REQUIRE(reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    GameRecordReader::Game game{};
+    REQUIRE(reader.next(game));
+    CHECK(game.plyCount == 3);
+    CHECK(game.startFen.empty());
+    CHECK(game.result == ChessGameState::Result::ongoing);
+    std::unique_ptr<ChessGameState> replayed{GameRecordReader::replay(game)};
+    REQUIRE(replayed != nullptr);
+    CHECK(ChessFen::toString(*replayed) == "rnbqkbnr/pppp1ppp/8/4p3/4P3/5N*2/PPPP1PPP/RNBQKB1R b KQkq - 1 2");
+
+    REQUIRE(reader.next(game));
+    CHECK(game.plyCount == 1);
+    CHECK(game.startFen == enPassant.startFen);
+    CHECK(game.result == ChessGameState::Result::stalemate);
+    replayed.reset(GameRecordReader::replay(game));
+    REQUIRE(replayed != nullptr);
+    CHECK(replayed->getBoard()->getPiece(std::make_pair(5, 4)) == nullptr);
+    CHECK(reader.next(game) == false);
+
+    // Games that are cut off are not read
+    REQUIRE(reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size() - 1));
+    CHECK(reader.next(game));
+    CHECK(reader.next(game) == false);
+
+    // Games with an unknown result are rejected
+    std::string corrupt = bytes;
+    corrupt[8 + 4] = static_cast<char>(static_cast<int>(ChessGameState::Result::fiftyMoves) + 1);
+    REQUIRE(reader.setData(reinterpret_cast<const unsigned char*>(corrupt.data()), corrupt.size()));
+    CHECK(reader.next(game) == false);
+
+    // Data without the header is rejected
+    CHECK(reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()) + 1, bytes.size() - 1) == false);
+    CHECK(reader.next(game) == false);
+}
+
+TEST_CASE("Game Record: Illegal moves stop a replay")
+{
+    GameRecord record{};
+    REQUIRE(record.addMove(std::make_pair(5, 2), std::make_pair(5, 6), 0));
+    std::ostringstream output{};
+    GameRecordWriter writer{output};
+    REQUIRE(writer.write(record));
+    std::string bytes = output.str();
+
+    GameRecordReader reader{};
+    REQUIRE(reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    GameRecordReader::Game game{};
+    REQUIRE(reader.next(game));
+    CHECK(GameRecordReader::replay(game) == nullptr);
+}
+
+TEST_CASE("Game Record: Read a mapped file")
+{
+    // Write a game to a file
+    std::string path = (std::filesystem::temp_directory_path() / "anarchy-chess-game-record-test").string();
+    {
+        std::ofstream file{path, std::ios::binary};
+        GameRecordWriter writer{file};
+        GameRecord record{};
+        REQUIRE(record.addMove(std::make_pair(2, 1), std::make_pair(3, 3), 0));
+        REQUIRE(writer.write(record));
+    }
+
+    // Map the file and replay the game
+    GameRecordReader reader{};
+    REQUIRE(reader.open(path));
+    GameRecordReader::Game game{};
+    REQUIRE(reader.next(game));
+    std::unique_ptr<ChessGameState> replayed{GameRecordReader::replay(game)};
+    REQUIRE(replayed != nullptr);
+    CHECK(replayed->getBoard()->getPiece(std::make_pair(3, 3)) != nullptr);
+    CHECK(reader.next(game) == false);
+    std::filesystem::remove(path);
+    CHECK(reader.open(path) == false);
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "doctest.h"
+#include "GameServer.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+
+using namespace logic;
+using namespace chess;
+
+TEST_CASE("Game Server: Play a game through requests")
+{
+    GameServer server{{}};
+    CHECK(server.handle("new") == "ok 1");
+    CHECK(server.handle("new k7/8/1K6/8/8/8/8/6Q1 w - - 0 1") == "ok 2");
+    CHECK(server.handle("new not a position") == "error invalid position");
+
+    // The starting position has 20 moves
+    std::string moves = server.handle("moves 1");
+    REQUIRE(moves.rfind("ok ", 0) == 0);
+    std::istringstream words{moves.substr(3)};
+    std::vector<std::string> list{std::istream_iterator<std::string>{words}, std::istream_iterator<std::string>{}};
+    CHECK(list.size() == 20);
+    CHECK(std::find(list.begin(), list.end(), "Nf3") != list.end());
+
+    // Fool's mate
+    CHECK(server.handle("play 1 f3") == "ok f3");
+    CHECK(server.handle("play 1 f3") == "error illegal move");
+    CHECK(server.handle("status 1") == "ok ongoing black 1 rnbqkbnr/pppppppp/8/8/8/5P2/PPPPP1PP/RNBQKBNR b KQkq - 0 1");
+    CHECK(server.handle("play 1 e5") == "ok e5");
+    CHECK(server.handle("play 1   g4 ") == "ok g4");
+    CHECK(server.handle("play 1 Qh4#") == "ok Qh4");
+    CHECK(server.handle("status 1").rfind("ok checkmate white 4 ", 0) == 0);
+    CHECK(server.handle("moves 1") == "ok");
+
+    // Games are told apart by their id
+    CHECK(server.handle("play 2 Qg8") == "ok Qg8");
+    CHECK(server.handle("status 2").rfind("ok checkmate black 1 ", 0) == 0);
+    CHECK(server.handle("info") == "ok sessions 2 active 2 evictions 0 restores 0");
+
+    CHECK(server.handle("close 1") == "ok");
+    CHECK(server.handle("close 1") == "error unknown game");
+    CHECK(server.handle("status 1") == "error unknown game");
+    CHECK(server.handle("status x") == "error unknown game");
+    CHECK(server.handle("resign 2") == "error unknown command");
+}
+
+TEST_CASE("Game Server: Evict idle games")
+{
+    SessionManager sessions{{4}};
+    std::vector<std::uint64_t> ids(10);
+    std::string played{};
+    for(std::uint64_t& id : ids) {
+        REQUIRE(sessions.create("", id));
+        REQUIRE(sessions.play(id, "e4", played));
+    }
+    SessionManager::Counts counts = sessions.getCounts();
+    CHECK(counts.sessions == 10);
+    CHECK(counts.active <= 4);
+    CHECK(counts.evictions >= 6);
+
+    // Evicted games are replayed from their record when used again
+    REQUIRE(sessions.play(ids[0], "e5", played));
+    SessionManager::Status status{};
+    REQUIRE(sessions.getStatus(ids[0], status));
+    CHECK(status.plies == 2);
+    CHECK(status.player == Player::white);
+    CHECK(status.fen == "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2");
+    CHECK(sessions.getCounts().restores == 1);
+    CHECK(sessions.getCounts().active <= 4);
+
+    GameRecord record{};
+    REQUIRE(sessions.getRecord(ids[0], record));
+    CHECK(record.moves.size() == 2);
+    CHECK(sessions.getRecord(100, record) == false);
+}
+
+TEST_CASE("Game Server: Run requests in parallel")
+{
+    GameServer::Options options{};
+    options.threadCount = 4;
+    options.maxPending = 3;
+    options.sessions.maxActiveSessions = 2;
+    GameServer server{options};
+
+    // Requests for the same game keep their order while other games run
+    std::istringstream input{
+        "new\nnew\nnew\n"
+        "play 1 e4\nplay 2 d4\nplay 3 c4\nplay 1 e5\n\nplay 2 d5\nplay 3 c5\nplay 1 Nf3\n"
+        "status 1\nclose 2\nmoves 2\nquit\ninfo\n"};
+    std::ostringstream output{};
+    GameServer::Summary summary = server.run(input, output);
+    CHECK(summary.requests == 13);
+    CHECK(summary.failed == 1);
+    CHECK(output.str() ==
+        "ok 1\nok 2\nok 3\n"
+        "ok e4\nok d4\nok c4\nok e5\nok d5\nok c5\nok Nf3\n"
+        "ok ongoing black 3 rnbqkbnr/pppp1ppp/8/4p3/4P3/5N*2/PPPP1PPP/RNBQKB1R b KQkq - 1 2\n"
+        "ok\nerror unknown game\n");
+}
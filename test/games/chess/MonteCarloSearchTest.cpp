@@ -0,0 +1,133 @@
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+#include "MonteCarloSearch.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameState.h"
+
+using namespace logic;
+using namespace chess;
+
+TEST_CASE("Monte Carlo Search: Find checkmate in 1")
+{
+    // Qg8 and Qa7 are both checkmate
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1")};
+    REQUIRE(chessState != nullptr);
+    MonteCarloSearch::Options options{};
+    options.threadCount = 1;
+    options.maxRolloutPly = 10;
+    options.seed = 47;
+    MonteCarloSearch search{*chessState, options};
+    MonteCarloSearch::Result result = search.search(300);
+    REQUIRE(result.found);
+    CHECK(result.score > 0.9);
+    REQUIRE(chessState->movePiece(result.move.start, result.move.end, result.move.idx));
+    CHECK(chessState->getResult() == ChessGameState::Result::checkmate);
+
+    // Every rollout was counted once the virtual losses were taken back
+    const MonteCarloSearch::Stats& stats = search.getStats();
+    CHECK(stats.rollouts == 300);
+    CHECK(stats.reusedNodes == 0);
+    CHECK(stats.nodes == search.getNodeCount());
+    CHECK(stats.getRolloutsPerSecond() > 0.0);
+}
+
+TEST_CASE("Monte Carlo Search: Parallel rollouts with virtual loss")
+{
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1")};
+    MonteCarloSearch::Options options{};
+    options.threadCount = 4;
+    options.maxRolloutPly = 10;
+    options.virtualLoss = 3;
+    MonteCarloSearch search{*chessState, options};
+    MonteCarloSearch::Result result = search.search(400);
+    REQUIRE(result.found);
+    REQUIRE(chessState->movePiece(result.move.start, result.move.end, result.move.idx));
+    CHECK(chessState->getResult() == ChessGameState::Result::checkmate);
+}
+
+TEST_CASE("Monte Carlo Search: Reuse the tree between moves")
+{
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("8/8/8/3k4/8/8/8/K6Q w - - 0 1")};
+    MonteCarloSearch::Options options{};
+    options.threadCount = 2;
+    options.maxRolloutPly = 4;
+    MonteCarloSearch search{*chessState, options};
+    REQUIRE(search.search(60).found);
+    std::size_t nodes = search.getNodeCount();
+    CHECK(nodes > 20);
+    CHECK(search.getStats().reusedNodes == 0);
+
+    // After playing the move found, its subtree is kept
+    MonteCarloSearch::Result result = search.search(20);
+    REQUIRE(result.found);
+    nodes = search.getNodeCount();
+    REQUIRE(chessState->movePiece(result.move.start, result.move.end, result.move.idx));
+    search.search(20);
+    CHECK(search.getStats().reusedNodes > 0);
+    CHECK(search.getStats().reusedNodes < nodes);
+
+    // Positions that are not in the tree start a new tree
+    std::unique_ptr<ChessGameState> other{ChessFen::load("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1")};
+    MonteCarloSearch otherSearch{*other, options};
+    REQUIRE(otherSearch.search(10).found);
+    REQUIRE(other->movePiece(std::make_pair(7, 1), std::make_pair(7, 2)));
+    REQUIRE(other->movePiece(std::make_pair(1, 8), std::make_pair(1, 7)) == false);
+    REQUIRE(other->movePiece(std::make_pair(1, 8), std::make_pair(2, 8)));
+    REQUIRE(otherSearch.search(10).found);
+    CHECK(otherSearch.getStats().reusedNodes == 0);
+}
+
+TEST_CASE("Monte Carlo Search: Rollouts know the positions before the search")
+{
+    // Move the knights out and back, so the starting position is repeated
+    ChessGameState chessState{};
+    REQUIRE(chessState.movePiece(std::make_pair(7, 1), std::make_pair(6, 3)));
+    REQUIRE(chessState.movePiece(std::make_pair(7, 8), std::make_pair(6, 6)));
+    REQUIRE(chessState.movePiece(std::make_pair(6, 3), std::make_pair(7, 1)));
+    REQUIRE(chessState.movePiece(std::make_pair(6, 6), std::make_pair(7, 8)));
+
+    // The only rollout starts at the root
+    int repetitions = 0;
+    MonteCarloSearch::Options options{};
+    options.threadCount = 1;
+    options.maxRolloutPly = 1;
+    options.rolloutPolicy = [&repetitions](ChessGameState& state, const std::vector<GameState::LegalMove>&, std::mt19937_64&) {
+        repetitions = state.getRepetitionCount();
+        return std::size_t{0};
+    };
+    MonteCarloSearch search{chessState, options};
+    REQUIRE(search.search(1).found);
+    CHECK(repetitions == 2);
+}
+
+TEST_CASE("Monte Carlo Search: Options")
+{
+    // Rollouts use the rollout policy
+    std::atomic<int> calls{0};
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1")};
+    MonteCarloSearch::Options options{};
+    options.threadCount = 1;
+    options.maxRolloutPly = 5;
+    options.rolloutPolicy = [&calls](ChessGameState&, const std::vector<GameState::LegalMove>&, std::mt19937_64&) {
+        calls++;
+        return std::size_t{0};
+    };
+
+    // The tree never grows past the pool, but rollouts keep running
+    options.maxNodes = 40;
+    MonteCarloSearch search{*chessState, options};
+    REQUIRE(search.search(50).found);
+    CHECK(calls > 0);
+    CHECK(search.getNodeCount() <= 40);
+    CHECK(search.getStats().rollouts == 50);
+
+    // Nothing is found without moves
+    std::unique_ptr<ChessGameState> stalemate{ChessFen::load("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1")};
+    MonteCarloSearch stalemateSearch{*stalemate, options};
+    CHECK(stalemateSearch.search(10).found == false);
+}
@@ -0,0 +1,202 @@
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+#include "OpeningBook.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "Move.h"
+
+using namespace logic;
+using namespace chess;
+
+/*
+* Builds a book out of the inputted games
+*/
+static std::string buildBook(const std::vector<GameRecord>& records, std::uint32_t maxPly)
+{
+    std::ostringstream games{};
+    GameRecordWriter writer{games};
+    for(const GameRecord& record : records) {
+        writer.write(record);
+    }
+    std::string bytes = games.str();
+    GameRecordReader reader{};
+    reader.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+
+    OpeningBookBuilder builder{};
+    GameRecordReader::Game game{};
+    while(reader.next(game)) {
+        builder.addGame(game, maxPly);
+    }
+    std::ostringstream book{};
+    builder.write(book);
+    return book.str();
+}
+
+/*
+* Returns the encoded move between the inputted squares
+*/
+static std::uint16_t encode(Move::position start, Move::position end)
+{
+    std::uint16_t encoded = 0;
+    GameRecord::encodeMove(start, end, 0, encoded);
+    return encoded;
+}
+
+TEST_CASE("Opening Book: Build a book from games")
+{
+    // e4 e5 is played twice and d4 once
+    GameRecord kingsPawn{};
+    kingsPawn.addMove(std::make_pair(5, 2), std::make_pair(5, 4), 0);
+    kingsPawn.addMove(std::make_pair(5, 7), std::make_pair(5, 5), 0);
+    kingsPawn.addMove(std::make_pair(7, 1), std::make_pair(6, 3), 0);
+    GameRecord queensPawn{};
+    queensPawn.addMove(std::make_pair(4, 2), std::make_pair(4, 4), 0);
+    std::string bytes = buildBook({kingsPawn, kingsPawn, queensPawn}, 2);
+
+    OpeningBook book{};
+    REQUIRE(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    CHECK(book.getEntryCount() == 3);
+    CHECK(bytes.size() == OpeningBook::headerSize + 3 * OpeningBook::entrySize);
+
+    // The starting position has both moves, sorted by move
+    ChessGameState chessState{};
+    OpeningBook::Entry found[4];
+    REQUIRE(book.findMoves(chessState, found, 4) == 2);
+    CHECK(found[0].move == encode(std::make_pair(4, 2), std::make_pair(4, 4)));
+    CHECK(found[0].weight == 1);
+    CHECK(found[1].move == encode(std::make_pair(5, 2), std::make_pair(5, 4)));
+    CHECK(found[1].weight == 2);
+    CHECK(book.findMoves(chessState, found, 1) == 2);
+
+    // Moves are picked in proportion to their weight
+    std::vector<GameState::LegalMove> legalMoves{};
+    GameState::LegalMove move{};
+    REQUIRE(book.pickMove(chessState, 0, legalMoves, move));
+    CHECK(move.start == std::make_pair(4, 2));
+    REQUIRE(book.pickMove(chessState, 1, legalMoves, move));
+    CHECK(move.start == std::make_pair(5, 2));
+    REQUIRE(book.pickMove(chessState, 5, legalMoves, move));
+    CHECK(move.start == std::make_pair(5, 2));
+
+    // Only the first 2 plies were added
+    REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    REQUIRE(book.pickMove(chessState, 0, legalMoves, move));
+    CHECK(move.start == std::make_pair(5, 7));
+    REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    CHECK(book.findMoves(chessState, found, 4) == 0);
+    CHECK(book.pickMove(chessState, 0, legalMoves, move) == false);
+}
+
+TEST_CASE("Opening Book: Weights")
+{
+    // Only the winner's moves of a checkmate are kept
+    GameRecord foolsMate{};
+    foolsMate.addMove(std::make_pair(6, 2), std::make_pair(6, 3), 0);
+    foolsMate.addMove(std::make_pair(5, 7), std::make_pair(5, 5), 0);
+    foolsMate.addMove(std::make_pair(7, 2), std::make_pair(7, 4), 0);
+    foolsMate.addMove(std::make_pair(4, 8), std::make_pair(8, 4), 0);
+    foolsMate.result = ChessGameState::Result::checkmate;
+    std::string bytes = buildBook({foolsMate}, 4);
+    OpeningBook book{};
+    REQUIRE(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    REQUIRE(book.getEntryCount() == 2);
+    CHECK(book.getEntry(0).weight == 2);
+    CHECK(book.getEntry(1).weight == 2);
+
+    // Weights of the same move are merged and stop at the largest weight
+    OpeningBookBuilder builder{};
+    builder.add(1, 7, UINT16_MAX);
+    builder.add(1, 7, 1);
+    builder.add(1, 3, 0);
+    CHECK(builder.getAddedCount() == 3);
+    std::ostringstream output{};
+    REQUIRE(builder.write(output));
+    bytes = output.str();
+    REQUIRE(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    REQUIRE(book.getEntryCount() == 1);
+    CHECK(book.getEntry(0).key == 1);
+    CHECK(book.getEntry(0).move == 7);
+    CHECK(book.getEntry(0).weight == UINT16_MAX);
+
+    // Moves that are not legal are never picked, including legal moves with
+    // an index past the moves to their end
+    ChessGameState chessState{};
+    OpeningBookBuilder illegal{};
+    illegal.add(chessState.getPositionKey(), encode(std::make_pair(5, 2), std::make_pair(5, 6)), 10);
+    std::uint16_t pastLastIdx = 0;
+    REQUIRE(GameRecord::encodeMove(std::make_pair(5, 2), std::make_pair(5, 4), 3, pastLastIdx));
+    illegal.add(chessState.getPositionKey(), pastLastIdx, 10);
+    output.str("");
+    REQUIRE(illegal.write(output));
+    bytes = output.str();
+    REQUIRE(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    std::vector<GameState::LegalMove> legalMoves{};
+    GameState::LegalMove move{};
+    CHECK(book.pickMove(chessState, 0, legalMoves, move) == false);
+}
+
+TEST_CASE("Opening Book: Find every position in a large book")
+{
+    // Add random positions with 1 or 2 moves each
+    std::mt19937_64 random{45};
+    std::vector<std::uint64_t> keys{};
+    OpeningBookBuilder builder{};
+    for(int i = 0; i < 5000; i++) {
+        keys.push_back(random());
+        builder.add(keys.back(), 1, 1);
+        if(i % 2 == 0) {
+            builder.add(keys.back(), 2, 1);
+        }
+    }
+    builder.add(0, 1, 1);
+    builder.add(UINT64_MAX, 1, 1);
+    std::ostringstream output{};
+    REQUIRE(builder.write(output));
+    std::string bytes = output.str();
+    OpeningBook book{};
+    REQUIRE(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    CHECK(book.getEntryCount() == 7502);
+
+    OpeningBook::Entry found[2];
+    for(std::size_t i = 0; i < keys.size(); i++) {
+        REQUIRE(book.findMoves(keys[i], found, 2) == (i % 2 == 0 ? 2 : 1));
+        CHECK(found[0].key == keys[i]);
+    }
+    CHECK(book.findMoves(0, found, 2) == 1);
+    CHECK(book.findMoves(UINT64_MAX, found, 2) == 1);
+    CHECK(book.findMoves(keys[0] + 1, found, 2) == 0);
+    CHECK(book.findMoves(keys[0] - 1, found, 2) == 0);
+
+    // Data that is not a book is rejected
+    CHECK(book.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size() - 1) == false);
+    CHECK(book.getEntryCount() == 0);
+    CHECK(book.findMoves(keys[0], found, 2) == 0);
+}
+
+TEST_CASE("Opening Book: Read a mapped file")
+{
+    std::string path = (std::filesystem::temp_directory_path() / "anarchy-chess-opening-book-test").string();
+    {
+        GameRecord record{};
+        record.addMove(std::make_pair(2, 1), std::make_pair(3, 3), 0);
+        std::string bytes = buildBook({record}, 10);
+        std::ofstream file{path, std::ios::binary};
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    OpeningBook book{};
+    REQUIRE(book.open(path));
+    ChessGameState chessState{};
+    std::vector<GameState::LegalMove> legalMoves{};
+    GameState::LegalMove move{};
+    REQUIRE(book.pickMove(chessState, 12345, legalMoves, move));
+    CHECK(move.start == std::make_pair(2, 1));
+    CHECK(move.end == std::make_pair(3, 3));
+    std::filesystem::remove(path);
+}
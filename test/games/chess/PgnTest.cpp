@@ -0,0 +1,121 @@
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "doctest.h"
+#include "Pgn.h"
+#include "ChessGameState.h"
+#include "GameRecord.h"
+
+using namespace logic;
+using namespace chess;
+
+TEST_CASE("PGN: Read tags, moves, and results")
+{
+    std::istringstream input{
+        "% An escape line\n"
+        "[Event \"Casual \\\"blitz\\\"\"]\n"
+        "[White \"Alice\"]\n"
+        "\n"
+        "1. e4 {A comment (with parentheses)} e5 2.Nf3 $1 (2. f4 exf4 (2... d5) 3. Nf3) Nc6 ; A line comment\n"
+        "3... a6?! 1-0\n"
+        "\n"
+        "[Black \"Bob\"]\n"
+        "1. d4 d5 *\n"
+        "1. c4\n"
+        "[Result \"*\"]\n"
+        "1. Nf3\n"
+    };
+    PgnReader reader{input};
+    PgnGame game{};
+
+    REQUIRE(reader.next(game));
+    CHECK(game.getTag("Event") == "Casual \"blitz\"");
+    CHECK(game.getTag("White") == "Alice");
+    CHECK(game.getTag("Black").empty());
+    CHECK(game.moves == std::vector<std::string>{"e4", "e5", "Nf3", "Nc6", "a6?!"});
+    CHECK(game.result == "1-0");
+
+    REQUIRE(reader.next(game));
+    CHECK(game.getTag("Black") == "Bob");
+    CHECK(game.moves == std::vector<std::string>{"d4", "d5"});
+    CHECK(game.result == "*");
+
+    // Games without results end at the next tag pair or the end of the stream
+    REQUIRE(reader.next(game));
+    CHECK(game.tags.empty());
+    CHECK(game.moves == std::vector<std::string>{"c4"});
+    CHECK(game.result.empty());
+    REQUIRE(reader.next(game));
+    CHECK(game.getTag("Result") == "*");
+    CHECK(game.moves == std::vector<std::string>{"Nf3"});
+    CHECK(reader.next(game) == false);
+}
+
+TEST_CASE("PGN: Validate games by replaying them")
+{
+    // A game that ends in checkmate
+    PgnGame game{};
+    game.moves = {"e4", "e5", "Bc4", "Nc6", "Qh5", "Nf6", "Qxf7#"};
+    PgnImporter::ImportedGame imported = PgnImporter::validate(game);
+    CHECK(imported.valid);
+    CHECK(imported.error.empty());
+    CHECK(imported.record.moves.size() == 7);
+    CHECK(imported.record.result == ChessGameState::Result::checkmate);
+
+    // A game with an illegal move keeps the moves before it
+    game.moves = {"e4", "e5", "Ke3"};
+    imported = PgnImporter::validate(game);
+    CHECK(imported.valid == false);
+    CHECK(imported.failedPly == 2);
+    CHECK(imported.record.moves.size() == 2);
+
+    // Forced moves must be played
+    game.tags = {{"FEN", "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"}};
+    game.moves = {"Kd1"};
+    imported = PgnImporter::validate(game);
+    CHECK(imported.valid == false);
+    game.moves = {"exd6", "Kd7"};
+    imported = PgnImporter::validate(game);
+    CHECK(imported.valid);
+    CHECK(imported.record.startFen == "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1");
+
+    // Invalid starting positions
+    game.tags = {{"FEN", "not a position"}};
+    imported = PgnImporter::validate(game);
+    CHECK(imported.valid == false);
+    CHECK(imported.failedPly == -1);
+}
+
+TEST_CASE("PGN: Import games in parallel and in order")
+{
+    // Game i plays i knight moves back and forth, and every third game ends
+    // with an illegal move
+    std::string pgn{};
+    const char* knightMoves[] = {"Nf3", "Nf6", "Ng1", "Ng8"};
+    for(int i = 0; i < 20; i++) {
+        pgn += "[Round \"" + std::to_string(i) + "\"]\n";
+        for(int ply = 0; ply < i; ply++) {
+            pgn += std::string{knightMoves[ply % 4]} + " ";
+        }
+        pgn += i % 3 == 2 ? "Qh5 *\n\n" : "*\n\n";
+    }
+
+    std::istringstream input{pgn};
+    PgnImporter importer{{2, 3}};
+    std::vector<std::size_t> indices{};
+    PgnImporter::Summary summary = importer.run(input, [&](const PgnImporter::ImportedGame& imported) {
+        CHECK(imported.game.getTag("Round") == std::to_string(imported.index));
+        CHECK(imported.valid == (imported.index % 3 != 2));
+        if(imported.valid) {
+            CHECK(imported.record.moves.size() == imported.index);
+        }
+        indices.push_back(imported.index);
+    });
+    CHECK(summary.games == 20);
+    CHECK(summary.invalid == 6);
+    REQUIRE(indices.size() == 20);
+    for(std::size_t i = 0; i < indices.size(); i++) {
+        CHECK(indices[i] == i);
+    }
+}
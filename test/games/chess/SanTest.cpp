@@ -0,0 +1,157 @@
+#include <string>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+#include "San.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "Move.h"
+
+using namespace logic;
+using namespace chess;
+
+/*
+* Parses the inputted SAN, returning a move with start (0, 0) if it fails
+*/
+static GameState::LegalMove parseMove(ChessGameState& chessState, std::string_view san)
+{
+    GameState::LegalMove move{};
+    if(!San::parse(chessState, san, move)) {
+        return {};
+    }
+    return move;
+}
+
+/*
+* Writes the inputted move, returning an empty string if it fails
+*/
+static std::string writeMove(ChessGameState& chessState, const GameState::LegalMove& move)
+{
+    std::string san{};
+    San::write(chessState, move.start, move.end, move.idx, san);
+    return san;
+}
+
+TEST_CASE("SAN: Standard moves")
+{
+    ChessGameState chessState{};
+
+    // Pawn and piece moves
+    GameState::LegalMove move = parseMove(chessState, "e4");
+    CHECK(move.start == std::make_pair(5, 2));
+    CHECK(move.end == std::make_pair(5, 4));
+    CHECK(writeMove(chessState, move) == "e4");
+    move = parseMove(chessState, "Nf3");
+    CHECK(move.start == std::make_pair(7, 1));
+    CHECK(move.end == std::make_pair(6, 3));
+    CHECK(writeMove(chessState, move) == "Nf3");
+
+    // Check markers, annotations, and long forms are accepted
+    CHECK(parseMove(chessState, "Nf3+!?") == move);
+    CHECK(parseMove(chessState, "Ng1-f3") == move);
+
+    // Moves that cannot be made or are not SAN fail
+    CHECK(parseMove(chessState, "e5").start == std::make_pair(0, 0));
+    CHECK(parseMove(chessState, "Nd2").start == std::make_pair(0, 0));
+    CHECK(parseMove(chessState, "Kz9").start == std::make_pair(0, 0));
+    CHECK(parseMove(chessState, "").start == std::make_pair(0, 0));
+}
+
+TEST_CASE("SAN: Disambiguation and castling")
+{
+    // Both rooks can reach d1
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("4k3/8/8/8/8/8/4K3/R6R w - - 0 1")};
+    REQUIRE(chessState != nullptr);
+    CHECK(parseMove(*chessState, "Rd1").start == std::make_pair(0, 0));
+    GameState::LegalMove move = parseMove(*chessState, "Rad1");
+    CHECK(move.start == std::make_pair(1, 1));
+    CHECK(writeMove(*chessState, move) == "Rad1");
+
+    // Castling on both sides
+    chessState.reset(ChessFen::load("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1"));
+    REQUIRE(chessState != nullptr);
+    move = parseMove(*chessState, "O-O");
+    CHECK(move.start == std::make_pair(5, 1));
+    CHECK(move.end == std::make_pair(7, 1));
+    CHECK(writeMove(*chessState, move) == "O-O");
+    move = parseMove(*chessState, "0-0-0");
+    CHECK(move.end == std::make_pair(3, 1));
+    CHECK(writeMove(*chessState, move) == "O-O-O");
+}
+
+TEST_CASE("SAN: Promotion and knight boosting")
+{
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("8/4P3/3p4/8/8/8/8/k6K w - - 0 1")};
+    REQUIRE(chessState != nullptr);
+
+    // Promotions are told apart by the piece they leave behind
+    for(const char* san : {"e8=Q", "e8=R", "e8=B", "e8=N", "e8=O"}) {
+        GameState::LegalMove move = parseMove(*chessState, san);
+        CHECK(move.end == std::make_pair(5, 8));
+        CHECK(writeMove(*chessState, move) == san);
+    }
+    CHECK(parseMove(*chessState, "e8=K").start == std::make_pair(0, 0));
+
+    // Knight boosts name the square the knight jumps to
+    GameState::LegalMove move = parseMove(*chessState, "e8=Nf6");
+    CHECK(move.start == std::make_pair(5, 7));
+    CHECK(move.end == std::make_pair(6, 6));
+    CHECK(writeMove(*chessState, move) == "e8=Nf6");
+    move = parseMove(*chessState, "e8=Nxd6");
+    CHECK(move.end == std::make_pair(4, 6));
+    CHECK(writeMove(*chessState, move) == "e8=Nxd6");
+    CHECK(parseMove(*chessState, "e8=Ne6").start == std::make_pair(0, 0));
+}
+
+TEST_CASE("SAN: Anarchy moves")
+{
+    // En Passant is a pawn capture
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1")};
+    REQUIRE(chessState != nullptr);
+    GameState::LegalMove move = parseMove(*chessState, "exd6");
+    CHECK(move.start == std::make_pair(5, 5));
+    CHECK(move.end == std::make_pair(4, 6));
+    CHECK(writeMove(*chessState, move) == "exd6");
+
+    // Knooklear fusion is a knight moving onto its rook
+    chessState.reset(ChessFen::load("4k3/8/8/8/8/1N6/8/R3K3 w - - 0 1"));
+    REQUIRE(chessState != nullptr);
+    move = parseMove(*chessState, "Na1=O");
+    CHECK(move.start == std::make_pair(2, 3));
+    CHECK(move.end == std::make_pair(1, 1));
+    CHECK(writeMove(*chessState, move) == "Na1=O");
+    CHECK(parseMove(*chessState, "Ra1=O").start == std::make_pair(0, 0));
+
+    // Il Vaticano is a bishop moving to the other bishop
+    chessState.reset(ChessFen::load("4k3/8/8/8/2BppB2/8/8/4K3 w - - 0 1"));
+    REQUIRE(chessState != nullptr);
+    move = parseMove(*chessState, "Bxf4");
+    CHECK(move.start == std::make_pair(3, 4));
+    CHECK(move.end == std::make_pair(6, 4));
+    CHECK(move.priority == 3);
+    CHECK(writeMove(*chessState, move) == "Bxf4");
+}
+
+TEST_CASE("SAN: Every legal move survives writing and reading")
+{
+    for(unsigned int seed = 1; seed <= 2; seed++) {
+        ChessGameState chessState{};
+        std::mt19937 random{seed};
+        std::vector<GameState::LegalMove> legalMoves{};
+        for(int ply = 0; ply < 40 && chessState.getResult() == ChessGameState::Result::ongoing; ply++) {
+            chessState.generateAllLegalMoves(legalMoves);
+            for(const GameState::LegalMove& move : legalMoves) {
+                std::string san = writeMove(chessState, move);
+                CAPTURE(san);
+                CHECK(parseMove(chessState, san) == move);
+            }
+            GameState::LegalMove& move = legalMoves[random() % legalMoves.size()];
+            REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+        }
+    }
+}
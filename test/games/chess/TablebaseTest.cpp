@@ -0,0 +1,227 @@
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+#include "Tablebase.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "GameState.h"
+#include "Move.h"
+
+using namespace logic;
+using namespace chess;
+
+/*
+* Builds the table of the inputted material into memory
+*/
+static std::string buildTable(std::string_view material, std::size_t threadCount)
+{
+    TablebaseGenerator generator{{threadCount}};
+    const std::vector<std::uint8_t>* values = generator.generate(material);
+    REQUIRE(values != nullptr);
+    std::ostringstream output{};
+    REQUIRE(TablebaseGenerator::write(output, TablebaseGenerator::getCanonicalMaterial(material), *values));
+    return output.str();
+}
+
+/*
+* Returns the FEN of the table position at the inputted index
+*/
+static std::string toFen(Tablebase& tablebase, std::uint64_t index)
+{
+    const std::string& material = tablebase.getMaterial();
+    std::string letters{};
+    bool white = true;
+    for(char letter : material) {
+        if(letter == 'v') {
+            white = false;
+            continue;
+        }
+        letters.push_back(white ? letter : static_cast<char>(letter - 'A' + 'a'));
+    }
+    char board[64]{};
+    for(std::size_t i = letters.size(); i-- > 0;) {
+        board[index % 64] = letters[i];
+        index /= 64;
+    }
+    std::string fen{};
+    for(int y = 7; y >= 0; y--) {
+        int empty = 0;
+        for(int x = 0; x < 8; x++) {
+            char piece = board[y * 8 + x];
+            if(!piece) {
+                empty++;
+                continue;
+            }
+            if(empty > 0) {
+                fen += std::to_string(empty);
+                empty = 0;
+            }
+            fen.push_back(piece);
+        }
+        if(empty > 0) {
+            fen += std::to_string(empty);
+        }
+        fen += y > 0 ? "/" : "";
+    }
+    return fen + (index == 0 ? " w - - 0 1" : " b - - 0 1");
+}
+
+/*
+* Checks that random positions of a table agree with the engine's moves: a
+* position wins as fast as possible if a move leads to a loss, loses as
+* slowly as possible if every move leads to a win, and draws otherwise
+*/
+static void checkAgainstEngine(Tablebase& tablebase, unsigned int seed, int positions)
+{
+    std::mt19937_64 random{seed};
+    int checked = 0;
+    while(checked < positions) {
+        std::uint64_t index = random() % tablebase.getEntryCount();
+        Tablebase::Probe expected{};
+        if(!Tablebase::decodeValue(tablebase.getValue(index), expected)) {
+            continue;
+        }
+        std::string fen = toFen(tablebase, index);
+        CAPTURE(fen);
+        std::unique_ptr<ChessGameState> chessState{ChessFen::load(fen)};
+        REQUIRE(chessState != nullptr);
+        Tablebase::Probe probe{};
+        REQUIRE(tablebase.probe(*chessState, probe));
+        CHECK(probe.wdl == expected.wdl);
+        CHECK(probe.distance == expected.distance);
+
+        // Find the result from the positions each move leads to
+        std::vector<GameState::LegalMove> legalMoves{};
+        chessState->generateAllLegalMoves(legalMoves);
+        Tablebase::Probe fromMoves{Tablebase::Wdl::loss, 0};
+        if(legalMoves.empty()) {
+            fromMoves.wdl = chessState->getResult() == ChessGameState::Result::checkmate ? Tablebase::Wdl::loss : Tablebase::Wdl::draw;
+        }
+        for(const GameState::LegalMove& legalMove : legalMoves) {
+            Move move = chessState->getMovesOfPiece(legalMove.start, legalMove.end)[legalMove.idx];
+            REQUIRE(chessState->makeSimulatedMove(legalMove.start, legalMove.end, move));
+            // Captures leave the table, and with 3 pieces they always draw
+            Tablebase::Probe child{Tablebase::Wdl::draw, 0};
+            tablebase.probe(*chessState, child);
+            chessState->unmakeSimulatedMove();
+            if(child.wdl == Tablebase::Wdl::loss) {
+                if(fromMoves.wdl != Tablebase::Wdl::win || child.distance + 1 < fromMoves.distance) {
+                    fromMoves = {Tablebase::Wdl::win, child.distance + 1};
+                }
+            }
+            else if(child.wdl == Tablebase::Wdl::draw && fromMoves.wdl == Tablebase::Wdl::loss) {
+                fromMoves = {Tablebase::Wdl::draw, 0};
+            }
+            else if(child.wdl == Tablebase::Wdl::win && fromMoves.wdl == Tablebase::Wdl::loss) {
+                fromMoves.distance = std::max(fromMoves.distance, child.distance + 1);
+            }
+        }
+        CHECK(fromMoves.wdl == expected.wdl);
+        CHECK(fromMoves.distance == expected.distance);
+        checked++;
+    }
+}
+
+TEST_CASE("Tablebase: Material names")
+{
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KQvK") == "KQvK");
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KvKQ") == "KQvK");
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KRvKQ") == "KQvKR");
+    CHECK(TablebaseGenerator::getCanonicalMaterial("OKvK") == "KOvK");
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KQvQ").empty());
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KPvK").empty());
+    CHECK(TablebaseGenerator::getCanonicalMaterial("KQRvKR").empty());
+}
+
+TEST_CASE("Tablebase: King and queen against king")
+{
+    std::string bytes = buildTable("KQvK", 1);
+    Tablebase tablebase{};
+    REQUIRE(tablebase.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    CHECK(tablebase.getMaterial() == "KQvK");
+    CHECK(tablebase.getEntryCount() == 2 * 64 * 64 * 64);
+    CHECK(bytes.size() < tablebase.getEntryCount() / 2);
+
+    // The longest win is mate in 10 moves, and the queen is never lost
+    // with white to move
+    int longestWin = 0;
+    for(std::uint64_t index = 0; index < tablebase.getEntryCount() / 2; index++) {
+        Tablebase::Probe probe{};
+        if(Tablebase::decodeValue(tablebase.getValue(index), probe)) {
+            CHECK(probe.wdl == Tablebase::Wdl::win);
+            longestWin = std::max(longestWin, probe.distance);
+        }
+    }
+    CHECK(longestWin == 19);
+
+    // Checkmate, stalemate, and a position with black to move and the queen
+    // on the other side
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("k7/1Q6/2K5/8/8/8/8/8 b - - 0 1")};
+    Tablebase::Probe probe{};
+    REQUIRE(tablebase.probe(*chessState, probe));
+    CHECK(probe.wdl == Tablebase::Wdl::loss);
+    CHECK(probe.distance == 0);
+    chessState.reset(ChessFen::load("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1"));
+    REQUIRE(tablebase.probe(*chessState, probe));
+    CHECK(probe.wdl == Tablebase::Wdl::draw);
+    chessState.reset(ChessFen::load("8/8/8/8/8/1k6/2q5/K7 b - - 0 1"));
+    REQUIRE(tablebase.probe(*chessState, probe));
+    CHECK(probe.wdl == Tablebase::Wdl::win);
+    CHECK(probe.distance == 1);
+
+    // Positions with other material are not in the table
+    chessState.reset(ChessFen::load("k7/1R6/2K5/8/8/8/8/8 b - - 0 1"));
+    CHECK(tablebase.probe(*chessState, probe) == false);
+
+    checkAgainstEngine(tablebase, 46, 40);
+}
+
+TEST_CASE("Tablebase: King and knook against king")
+{
+    // Built in parallel, and the knook can also be captured
+    std::string bytes = buildTable("KvKO", 2);
+    Tablebase tablebase{};
+    REQUIRE(tablebase.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+    CHECK(tablebase.getMaterial() == "KOvK");
+    checkAgainstEngine(tablebase, 47, 40);
+
+    // Searches score positions in the table by their result
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("k7/8/1K2O3/8/8/8/8/8 w - - 0 1")};
+    Search::Evaluation evaluate = tablebase.makeEvaluation();
+    CHECK(evaluate(*chessState) == Tablebase::winScore - 1);
+    Search search{*chessState, evaluate};
+    Search::Result best = search.findBestMove(1);
+    REQUIRE(best.found);
+    REQUIRE(chessState->movePiece(best.move.start, best.move.end, best.move.idx));
+    CHECK(chessState->getResult() == ChessGameState::Result::checkmate);
+}
+
+TEST_CASE("Tablebase: Read a mapped file")
+{
+    std::string path = (std::filesystem::temp_directory_path() / "anarchy-chess-tablebase-test").string();
+    {
+        std::string bytes = buildTable("KvK", 1);
+        std::ofstream file{path, std::ios::binary};
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    Tablebase tablebase{};
+    REQUIRE(tablebase.open(path));
+    CHECK(tablebase.getMaterial() == "KvK");
+
+    // Kings next to each other are illegal, and everything else is a draw
+    CHECK(tablebase.getValue(0 * 64 + 1) == Tablebase::illegalValue);
+    CHECK(tablebase.getValue(0 * 64 + 63) == Tablebase::drawValue);
+    CHECK(tablebase.getValue(tablebase.getEntryCount()) == Tablebase::illegalValue);
+
+    // Cut off files are rejected
+    std::ifstream file{path, std::ios::binary};
+    std::string bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    CHECK(tablebase.setData(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size() / 2) == false);
+    std::filesystem::remove(path);
+}
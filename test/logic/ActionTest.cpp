@@ -60,9 +60,11 @@ TEST_CASE("Action: Create and Call All Action Types")
     CHECK(movePiece.callAction(std::make_pair(1, 1), board));
     CHECK(!board->occupiedOnBoard(std::make_pair(1, 1)));
     CHECK(board->occupiedOnBoard(std::make_pair(2, 2)));
+    CHECK(piece3->previouslyMoved());
     CHECK(movePiece.reverseAction(board));
     CHECK(board->occupiedOnBoard(std::make_pair(1, 1)));
     CHECK(!board->occupiedOnBoard(std::make_pair(2, 2)));
+    CHECK(!piece3->previouslyMoved());
 
     // Make sure calling a move action works in the actual game
     CHECK(movePiece.callAction(std::make_pair(1, 1), board));
@@ -70,7 +72,6 @@ TEST_CASE("Action: Create and Call All Action Types")
     REQUIRE(board->occupiedOnBoard(std::make_pair(2, 2)));
 
     // Make sure the move action's symptomatic effects work properly
-    CHECK(!piece3->previouslyMoved());
     movePiece.applySymptomaticEffects(board);
     CHECK(piece3->previouslyMoved());
 
@@ -0,0 +1,63 @@
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "doctest.h"
+#include "DestinationIndex.h"
+#include "Move.h"
+
+using namespace logic;
+
+TEST_CASE("Destination Index: Find the moves that contain a position")
+{
+    // Create moves that share some of their positions
+    std::vector<Move> moves{
+        {{std::make_pair(1, 1), std::make_pair(2, 2)}, 1},
+        {{std::make_pair(2, 2)}, 3},
+        {{std::make_pair(-4000, 7000)}, 2}
+    };
+    DestinationIndex destinations{};
+    destinations.build(moves);
+    REQUIRE(destinations.indexed());
+
+    // Make sure each position maps to the moves that contain it
+    CHECK(destinations.contains(std::make_pair(1, 1)));
+    CHECK(destinations.getMoveMask(std::make_pair(1, 1)) == 0b001);
+    CHECK(destinations.getMoveMask(std::make_pair(2, 2)) == 0b011);
+    CHECK(destinations.getMoveMask(std::make_pair(-4000, 7000)) == 0b100);
+    CHECK(destinations.getMaxPriority(std::make_pair(2, 2)) == 3);
+    CHECK(destinations.getMaxPriority(std::make_pair(-4000, 7000)) == 2);
+
+    // Make sure positions that are not in any move are not found
+    CHECK(destinations.contains(std::make_pair(3, 3)) == false);
+    CHECK(destinations.getMoveMask(std::make_pair(3, 3)) == 0);
+    CHECK(destinations.getMaxPriority(std::make_pair(3, 3)) == 0);
+
+    // Clearing the index removes every position
+    destinations.clear();
+    CHECK(destinations.indexed() == false);
+    CHECK(destinations.contains(std::make_pair(1, 1)) == false);
+}
+
+TEST_CASE("Destination Index: Many positions and moves")
+{
+    // Create one move per position on a large board
+    std::vector<Move> moves{};
+    for(int i = 0; i < DestinationIndex::maxIndexedMoves; i++) {
+        moves.push_back({{std::make_pair(i, 2 * i), std::make_pair(i, -i)}});
+    }
+    DestinationIndex destinations{};
+    destinations.build(moves);
+    REQUIRE(destinations.indexed());
+    for(int i = 0; i < DestinationIndex::maxIndexedMoves; i++) {
+        std::uint64_t expected = std::uint64_t{1} << i;
+        CHECK(destinations.getMoveMask(std::make_pair(i, 2 * i)) == expected);
+        CHECK(destinations.getMoveMask(std::make_pair(i, -i)) == (i == 0 ? 1 : expected));
+    }
+
+    // Lists with too many moves are not indexed
+    moves.push_back({{std::make_pair(100, 100)}});
+    destinations.build(moves);
+    CHECK(destinations.indexed() == false);
+    CHECK(destinations.contains(std::make_pair(100, 100)) == false);
+}
@@ -0,0 +1,92 @@
+#include <vector>
+
+#include "doctest.h"
+#include "Evaluator.h"
+#include "GameBoard.h"
+#include "Move.h"
+#include "Piece.h"
+#include "TestPieces.h"
+
+using namespace testing;
+using namespace logic;
+
+namespace {
+    // Scores each piece by its x coordinate
+    class ColumnEvaluator : public Evaluator
+    {
+        public:
+            double getPieceSquareValue(Piece* piece, Move::position position) override
+            {
+                return position.first;
+            }
+    };
+}
+
+TEST_CASE("Evaluator: Scores are kept up to date as the board changes")
+{
+    // Create a board with a white piece and a black piece
+    GameBoard board{{Player::white, Player::black}};
+    Piece* whitePiece = new Priority1Piece{Player::white, std::make_pair(1, 1)};
+    Piece* blackPiece = new Priority2Piece{Player::black, std::make_pair(3, 3)};
+    CHECK(board.addPiece(whitePiece));
+
+    // Pieces that are already on the board are scored when the evaluator is set
+    ColumnEvaluator* evaluator = new ColumnEvaluator();
+    board.setEvaluator(evaluator);
+    CHECK(board.getEvaluator() == evaluator);
+    CHECK(evaluator->getMaterial(Player::white) == 1);
+    CHECK(evaluator->getPositional(Player::white) == 1);
+
+    // Adding a piece
+    CHECK(board.addPiece(blackPiece));
+    CHECK(evaluator->getMaterial(Player::black) == 2);
+    CHECK(evaluator->getPositional(Player::black) == 3);
+    CHECK(evaluator->evaluate(Player::white) == (1 + 1) - (2 + 3));
+    CHECK(evaluator->evaluate(Player::black) == (2 + 3) - (1 + 1));
+
+    // Moving a piece only changes its piece-square score
+    CHECK(board.movePiece(std::make_pair(1, 1), std::make_pair(5, 1)));
+    CHECK(evaluator->getMaterial(Player::white) == 1);
+    CHECK(evaluator->getPositional(Player::white) == 5);
+
+    // Removing and unremoving a piece
+    CHECK(board.removePiece(std::make_pair(3, 3)));
+    CHECK(evaluator->getMaterial(Player::black) == 0);
+    CHECK(evaluator->getPositional(Player::black) == 0);
+    CHECK(evaluator->evaluate(Player::white) == 1 + 5);
+    CHECK(board.unRemovePiece(blackPiece));
+    CHECK(evaluator->getMaterial(Player::black) == 2);
+    CHECK(evaluator->getPositional(Player::black) == 3);
+
+    // Capturing a piece takes it off the board and adds to the captures
+    CHECK(board.capturePiece(std::make_pair(3, 3)));
+    CHECK(evaluator->getMaterial(Player::black) == 0);
+    CHECK(board.getPlayerScore(Player::white) == 2);
+}
+
+TEST_CASE("Evaluator: Pieces count for every player that controls them")
+{
+    // Create a piece controlled by both players
+    GameBoard board{{Player::white, Player::black, Player::silver}};
+    board.setEvaluator(new Evaluator());
+    Piece* sharedPiece = new Priority2Piece{std::vector<Player>{Player::white, Player::black}, std::make_pair(0, 0)};
+    Piece* silverPiece = new Priority1Piece{Player::silver, std::make_pair(1, 0)};
+    CHECK(board.addPieces({sharedPiece, silverPiece}));
+
+    // Every player is compared to all of the others
+    Evaluator* evaluator = board.getEvaluator();
+    CHECK(evaluator->getMaterial(Player::white) == 2);
+    CHECK(evaluator->getMaterial(Player::black) == 2);
+    CHECK(evaluator->evaluate(Player::white) == 2 - (2 + 1));
+    CHECK(evaluator->evaluate(Player::silver) == 1 - (2 + 2));
+
+    // Changing control is picked up after refreshing
+    sharedPiece->removePlayer(Player::black);
+    board.refreshEvaluator();
+    CHECK(evaluator->getMaterial(Player::black) == 0);
+    CHECK(evaluator->evaluate(Player::white) == 2 - 1);
+
+    // Boards without an evaluator
+    board.setEvaluator(nullptr);
+    CHECK(board.getEvaluator() == nullptr);
+}
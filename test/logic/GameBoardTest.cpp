@@ -5,6 +5,9 @@
 #include "GameBoard.h"
 #include "Move.h"
 #include "Piece.h"
+#include "Dependencies.h"
+#include "Action.h"
+#include "MovePieceAction.h"
 #include "TestBoard.h"
 #include "TestPieces.h"
 
@@ -260,9 +263,14 @@ TEST_CASE("Game Board: Get pieces controlled by player")
         CHECK(std::find(blackPieces.begin(), blackPieces.end(), std::make_pair(0, j)) != blackPieces.end());
     }
 
+    CHECK(gameBoard.getPieceCount(Player::white) == 3);
+    CHECK(gameBoard.getPieceCount(Player::black) == 2);
+
     gameBoard.removePiece(0, 0);
     std::vector<Move::position> newWhitePieces = gameBoard.getPiecesOfPlayer(Player::white);
     CHECK(std::find(newWhitePieces.begin(), newWhitePieces.end(), std::make_pair(0, 0)) == newWhitePieces.end());
+    CHECK(gameBoard.getPieceCount(Player::white) == 2);
+    CHECK(gameBoard.getPieceCount(Player::black) == 2);
 }
 
 TEST_CASE("Game Board: Get default player captures")
@@ -349,3 +357,135 @@ TEST_CASE("Game Board: Get updated player score")
     CHECK(board.getPlayerScore(Player::silver) == 3); // Silver gains points from both captures
     CHECK(board.getPlayerScore(Player::gold) == 3); // Gold gains points from both captures
 }
+
+TEST_CASE("Game Board: Cast rays")
+{
+    // Create an infinite board with a blocker far away
+    GameBoard board{};
+    Piece* blocker = new Piece{std::make_pair(0, 2000)};
+    REQUIRE(board.addPiece(blocker));
+
+    // Rays without a blocker stop at the horizon
+    CHECK(board.getRayHorizon() == 64);
+    std::vector<Move::position> openRay = board.castRay(std::make_pair(0, 0), std::make_pair(1, 0));
+    REQUIRE(openRay.size() == 64);
+    CHECK(openRay.front() == std::make_pair(1, 0));
+    CHECK(openRay.back() == std::make_pair(64, 0));
+    CHECK(board.castRay(std::make_pair(0, 0), std::make_pair(1, 0), 5).size() == 5);
+
+    // Changing the horizon changes the length of open rays
+    board.setRayHorizon(3000);
+    CHECK(board.castRay(std::make_pair(0, 0), std::make_pair(-1, 1)).size() == 3000);
+
+    // Rays stop at and include the first blocker
+    std::vector<Move::position> blockedRay = board.castRay(std::make_pair(0, 0), std::make_pair(0, 1));
+    REQUIRE(blockedRay.size() == 2000);
+    CHECK(blockedRay.back() == std::make_pair(0, 2000));
+    CHECK(board.castRay(std::make_pair(0, 1999), std::make_pair(0, 1)).size() == 1);
+
+    // Rays stop at the edge of the board
+    PositiveXBoard xBoard{};
+    CHECK(xBoard.castRay(std::make_pair(5, 0), std::make_pair(-1, 0)).size() == 5);
+    CHECK(xBoard.castRay(std::make_pair(5, 0), std::make_pair(-1, -1)).size() == 5);
+
+    // Only the positions on the board are reserved, not the whole horizon
+    std::vector<Move::position> edgeRay = xBoard.castRay(std::make_pair(5, 0), std::make_pair(-1, 0), 3000);
+    CHECK(edgeRay.capacity() == edgeRay.size());
+}
+
+TEST_CASE("Game Board: Rays are recorded as a single dependency")
+{
+    GameBoard board{};
+    board.setRayHorizon(3000);
+    Piece* blocker = new Piece{std::make_pair(0, 2000)};
+    REQUIRE(board.addPiece(blocker));
+
+    // Long rays record themselves and their blocker instead of every position
+    board.beginDependencyRecording();
+    CHECK(board.castRay(std::make_pair(0, 0), std::make_pair(0, 1)).size() == 2000);
+    CHECK(board.castRay(std::make_pair(0, 0), std::make_pair(1, 0)).size() == 3000);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, 0), 1000000) == -1);
+    Dependencies dependencies = board.endDependencyRecording();
+    CHECK(dependencies.squares.size() == 1);
+    CHECK(dependencies.rays.size() == 3);
+    CHECK(board.dependenciesHold(dependencies));
+
+    // Pieces beyond the end of a ray don't matter
+    Piece* outside = new Piece{std::make_pair(3001, 0)};
+    REQUIRE(board.addPiece(outside));
+    Piece* behind = new Piece{std::make_pair(0, 2500)};
+    REQUIRE(board.addPiece(behind));
+    CHECK(board.dependenciesHold(dependencies));
+
+    // Pieces on a ray do
+    Piece* inside = new Piece{std::make_pair(-500000, 0)};
+    REQUIRE(board.addPiece(inside));
+    CHECK(board.dependenciesHold(dependencies) == false);
+    REQUIRE(board.removePiece(std::make_pair(-500000, 0)));
+    CHECK(board.dependenciesHold(dependencies));
+    Piece* closer = new Piece{std::make_pair(0, 1000)};
+    REQUIRE(board.addPiece(closer));
+    CHECK(board.dependenciesHold(dependencies) == false);
+}
+
+TEST_CASE("Game Board: Position hash")
+{
+    // Create two boards and add the same pieces to them in different orders
+    GameBoard board1{};
+    GameBoard board2{};
+    CHECK(board1.getPositionHash() == board2.getPositionHash());
+    REQUIRE(board1.addPieces({new Piece(Player::white, std::make_pair(1, 1)), new Piece(Player::black, std::make_pair(2, 2))}));
+    REQUIRE(board2.addPieces({new Piece(Player::black, std::make_pair(2, 2)), new Piece(Player::white, std::make_pair(1, 1))}));
+    CHECK(board1.getPositionHash() == board2.getPositionHash());
+
+    // The hash depends on where pieces are and who controls them
+    std::uint64_t originalHash = board1.getPositionHash();
+    REQUIRE(board1.movePiece(std::make_pair(1, 1), std::make_pair(1, 2)));
+    CHECK(board1.getPositionHash() != originalHash);
+    REQUIRE(board1.movePiece(std::make_pair(1, 2), std::make_pair(1, 1)));
+    CHECK(board1.getPositionHash() == originalHash);
+    GameBoard board3{};
+    REQUIRE(board3.addPieces({new Piece(Player::black, std::make_pair(1, 1)), new Piece(Player::black, std::make_pair(2, 2))}));
+    CHECK(board3.getPositionHash() != originalHash);
+
+    // Removing and restoring a piece restores the hash
+    Piece* removedPiece = board1.getPiece(2, 2);
+    REQUIRE(board1.removePiece(2, 2));
+    CHECK(board1.getPositionHash() != originalHash);
+    REQUIRE(board1.unRemovePiece(removedPiece));
+    CHECK(board1.getPositionHash() == originalHash);
+}
+
+TEST_CASE("Game Board: Simulation frames")
+{
+    // Create a board with a piece to move around
+    GameBoard board{};
+    REQUIRE(board.addPieces({new Piece(Player::white, std::make_pair(0, 0))}));
+    std::shared_ptr<Action> moveRight = std::make_shared<MovePieceAction>(std::make_pair(0, 0), std::make_pair(1, 0));
+    std::shared_ptr<Action> moveUp = std::make_shared<MovePieceAction>(std::make_pair(0, 0), std::make_pair(0, 1));
+
+    // Simulate a move outside of any frame
+    REQUIRE(moveRight->callAction(std::make_pair(0, 0), &board));
+    board.addToSimulation(moveRight);
+
+    // Simulate another move in a frame and make sure reverting only undoes it
+    board.beginSimulationFrame();
+    REQUIRE(moveUp->callAction(std::make_pair(1, 0), &board));
+    board.addToSimulation(moveUp);
+    CHECK(board.occupiedOnBoard(1, 1));
+    CHECK(board.revertSimulation());
+    CHECK(board.occupiedOnBoard(1, 0));
+    CHECK(board.inSimulation());
+
+    // Ending the frame leaves the outer move simulated
+    REQUIRE(moveUp->callAction(std::make_pair(1, 0), &board));
+    board.addToSimulation(moveUp);
+    CHECK(board.endSimulationFrame());
+    CHECK(board.occupiedOnBoard(1, 0));
+    CHECK(board.endSimulationFrame() == false);
+
+    // Without a frame, every simulated move is reverted
+    CHECK(board.revertSimulation());
+    CHECK(board.occupiedOnBoard(0, 0));
+    CHECK(board.inSimulation() == false);
+}
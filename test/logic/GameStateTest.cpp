@@ -152,6 +152,39 @@ TEST_CASE("Game State: Get maximum priority of player's moves")
     CHECK(gameState.getPriorityOfPlayer(Player::black) == 5);
 }
 
+TEST_CASE("Game State: Player priorities are cached")
+{
+    // Create a game where black has a piece that counts minimum priority checks
+    GameBoard* gameBoard = new GameBoard{{ Player::white, Player::black }};
+    Priority1Piece* whitePiece = new Priority1Piece{ Player::white };
+    CountingPiece* blackPiece = new CountingPiece{ Player::black, std::make_pair(4, 4) };
+    CHECK(gameBoard->addPieces({ whitePiece, blackPiece }));
+    GameState gameState{ gameBoard, { Player::white, Player::black } };
+
+    // Black's priority is only found once for the same game state
+    CHECK(gameState.getPriorityOfPlayer(Player::black) == 1);
+    CHECK(gameState.getPriorityOfPlayer(Player::black) == 1);
+    CHECK(gameState.getMovesOfPiece(Player::black, std::make_pair(4, 4), std::make_pair(5, 5)).size() == 1);
+    CHECK(blackPiece->minPriorityChecked == 1);
+
+    // Changing the board finds the priority again
+    CHECK(gameBoard->movePiece(std::make_pair(0, 0), std::make_pair(0, 1)));
+    CHECK(gameState.getPriorityOfPlayer(Player::black) == 1);
+    CHECK(blackPiece->minPriorityChecked == 2);
+
+    // Invalidating the priorities finds the priority again
+    gameState.invalidatePriorities();
+    CHECK(gameState.getPriorityOfPlayer(Player::black) == 1);
+    CHECK(blackPiece->minPriorityChecked == 3);
+
+    // A new turn finds the priority again
+    gameState.setNextPlayer();
+    int checked = blackPiece->minPriorityChecked;
+    CHECK(gameState.getPriority() == 1);
+    CHECK(gameState.getPriority() == 1);
+    CHECK(blackPiece->minPriorityChecked == checked);
+}
+
 TEST_CASE("Game State: Get moves of piece")
 {
     // Create a gameBoard
@@ -199,6 +232,34 @@ TEST_CASE("Game State: Get moves of piece")
 }
 
 
+TEST_CASE("Game State: Generate all legal moves")
+{
+    // Create a gameBoard
+    GameBoard* gameBoard = new GameBoard{{ Player::white, Player::black }};
+
+    // Create 3 testing pieces and add them to the board
+    FiveFivesOneOnePiece* manyPiece = new FiveFivesOneOnePiece{ Player::white }; // 5 5-priority moves to (1, 1) and 1 1-priority move to (1, 1)
+    Priority3Piece* white3Piece = new Priority3Piece{ Player::white, std::make_pair(1, 0) };
+    Priority3Piece* black3Piece = new Priority3Piece{ Player::black, std::make_pair(2, 0) };
+    CHECK(gameBoard->addPieces({ manyPiece, white3Piece, black3Piece }));
+
+    // Create a GameState with 2 players: white and black
+    GameState gameState{ gameBoard, { Player::white, Player::black } };
+
+    // Only the 5 5-priority moves of manyPiece are legal for white
+    std::vector<GameState::LegalMove> legalMoves{};
+    gameState.generateAllLegalMoves(legalMoves);
+    REQUIRE(legalMoves.size() == 5);
+    for(int idx = 0; idx < 5; idx++) {
+        CHECK(legalMoves[idx] == GameState::LegalMove{std::make_pair(0, 0), std::make_pair(1, 1), idx, 5});
+    }
+
+    // The vector is cleared before black's moves are added
+    gameState.generateAllLegalMoves(Player::black, legalMoves);
+    REQUIRE(legalMoves.size() == 1);
+    CHECK(legalMoves[0] == GameState::LegalMove{std::make_pair(2, 0), std::make_pair(3, 3), 0, 3});
+}
+
 TEST_CASE("Game State: Can move piece")
 {
     // Create a gameBoard
@@ -0,0 +1,51 @@
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <filesystem>
+
+#include "doctest.h"
+#include "MappedFile.h"
+
+using namespace logic;
+
+TEST_CASE("Mapped File: Read a file")
+{
+    // Write a file to map
+    std::string path = (std::filesystem::temp_directory_path() / "anarchy-chess-mapped-file-test").string();
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "Anarchy Chess";
+    }
+
+    // The mapped contents match the file
+    MappedFile mappedFile{};
+    CHECK(mappedFile.isOpen() == false);
+    REQUIRE(mappedFile.open(path));
+    CHECK(mappedFile.isOpen());
+    REQUIRE(mappedFile.getSize() == 13);
+    CHECK(std::memcmp(mappedFile.getData(), "Anarchy Chess", 13) == 0);
+
+    // Files that are searched map the same contents
+    REQUIRE(mappedFile.open(path, MappedFile::Access::random));
+    REQUIRE(mappedFile.getSize() == 13);
+    CHECK(std::memcmp(mappedFile.getData(), "Anarchy Chess", 13) == 0);
+
+    // Closing the file removes the data
+    mappedFile.close();
+    CHECK(mappedFile.isOpen() == false);
+    CHECK(mappedFile.getData() == nullptr);
+    CHECK(mappedFile.getSize() == 0);
+
+    // Empty files open without any data
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    }
+    REQUIRE(mappedFile.open(path));
+    CHECK(mappedFile.getSize() == 0);
+    mappedFile.close();
+    std::filesystem::remove(path);
+
+    // Missing files cannot be opened
+    CHECK(mappedFile.open(path) == false);
+    CHECK(mappedFile.isOpen() == false);
+}
@@ -0,0 +1,176 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+#include "PersistentBoard.h"
+#include "ChessBoard.h"
+#include "ChessFen.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "King.h"
+#include "Bishop.h"
+#include "Knight.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
+#include "Knook.h"
+#include "Move.h"
+#include "Piece.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+
+namespace {
+    Piece* createChessPiece(Piece::ID id, Move::position position)
+    {
+        switch(id) {
+            case KING_ID:   return new King(position);
+            case BISHOP_ID: return new Bishop(position);
+            case KNIGHT_ID: return new Knight(position);
+            case PAWN_ID:   return new Pawn(position);
+            case QUEEN_ID:  return new Queen(position);
+            case ROOK_ID:   return new Rook(position);
+            case KNOOK_ID:  return new Knook(position);
+            default:        return nullptr;
+        }
+    }
+
+    /*
+    * Returns the piece placement field of the FEN of a game state
+    */
+    std::string getPlacement(ChessGameState& chessState)
+    {
+        std::string fen{};
+        ChessFen::write(chessState, fen);
+        return fen.substr(0, fen.find(' '));
+    }
+}
+
+TEST_CASE("Persistent Board: Convert to and from a GameBoard")
+{
+    ChessGameState chessState{};
+    REQUIRE(chessState.movePiece(std::make_pair(7, 1), std::make_pair(6, 3)));
+    REQUIRE(chessState.movePiece(std::make_pair(2, 8), std::make_pair(3, 6)));
+    PersistentBoard persistentBoard = PersistentBoard::fromBoard(*chessState.getBoard());
+    CHECK(persistentBoard.getPieceCount() == 32);
+    const PersistentBoard::PieceInfo* knight = persistentBoard.getPiece(std::make_pair(6, 3));
+    REQUIRE(knight != nullptr);
+    CHECK(knight->id == KNIGHT_ID);
+    CHECK(knight->playerMask == 1);
+    CHECK(knight->moved);
+    CHECK(persistentBoard.getPiece(std::make_pair(7, 1)) == nullptr);
+
+    // The pieces are sorted by position
+    std::vector<PersistentBoard::PieceInfo> pieces = persistentBoard.getPieces();
+    REQUIRE(pieces.size() == 32);
+    for(std::size_t i = 1; i < pieces.size(); i++) {
+        CHECK(pieces[i - 1].position < pieces[i].position);
+    }
+
+    // Converting back gives the same position
+    ChessBoard* board = new ChessBoard(false);
+    REQUIRE(persistentBoard.toBoard(*board, createChessPiece));
+    ChessGameState copy{board};
+    CHECK(getPlacement(copy) == getPlacement(chessState));
+    CHECK(PersistentBoard::fromBoard(*copy.getBoard()) == persistentBoard);
+
+    // Unknown pieces and occupied spaces fail
+    ChessBoard* other = new ChessBoard(false);
+    CHECK(persistentBoard.toBoard(*other, [](Piece::ID, Move::position) { return static_cast<Piece*>(nullptr); }) == false);
+    CHECK(persistentBoard.toBoard(*board, createChessPiece) == false);
+    delete other;
+}
+
+TEST_CASE("Persistent Board: Old boards are unchanged")
+{
+    ChessGameState chessState{};
+    PersistentBoard start = PersistentBoard::fromBoard(*chessState.getBoard());
+
+    // Two variations from the same position
+    PersistentBoard e4 = start.movePiece(std::make_pair(5, 2), std::make_pair(5, 4));
+    PersistentBoard d4 = start.movePiece(std::make_pair(4, 2), std::make_pair(4, 4));
+    PersistentBoard capture = e4.movePiece(std::make_pair(4, 7), std::make_pair(4, 5))
+        .movePiece(std::make_pair(5, 4), std::make_pair(4, 5));
+    CHECK(start.getPiece(std::make_pair(5, 2)) != nullptr);
+    CHECK(start.getPiece(std::make_pair(5, 4)) == nullptr);
+    CHECK(e4.getPiece(std::make_pair(5, 4)) != nullptr);
+    CHECK(e4.getPiece(std::make_pair(4, 4)) == nullptr);
+    CHECK(d4.getPiece(std::make_pair(4, 4)) != nullptr);
+    CHECK(d4.getPiece(std::make_pair(5, 4)) == nullptr);
+    CHECK(e4.getPieceCount() == 32);
+    CHECK(capture.getPieceCount() == 31);
+    CHECK(capture.getPiece(std::make_pair(4, 5))->playerMask == 1);
+    CHECK(e4.getPiece(std::make_pair(4, 7))->playerMask == 2);
+
+    // Moves that do nothing
+    CHECK(start.movePiece(std::make_pair(5, 4), std::make_pair(5, 5)) == start);
+    CHECK(start.removePiece(std::make_pair(5, 4)).getPieceCount() == 32);
+    CHECK(start.setPiece({std::make_pair(5, 2), PAWN_ID, 1, false}) == start);
+    CHECK((start.setPiece({std::make_pair(5, 2), QUEEN_ID, 1, false}) == start) == false);
+
+    // Boards only depend on their pieces, not on how they were made
+    PersistentBoard transposed = e4.movePiece(std::make_pair(4, 2), std::make_pair(4, 4));
+    CHECK(transposed == d4.movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+    CHECK(PersistentBoard{}.getPieceCount() == 0);
+    CHECK(PersistentBoard{}.getPieces().empty());
+}
+
+TEST_CASE("Persistent Board: Boards share unchanged pieces")
+{
+    ChessGameState chessState{};
+    PersistentBoard start = PersistentBoard::fromBoard(*chessState.getBoard());
+    CHECK(PersistentBoard::countNodes({start}) == 32);
+
+    // Shuffle the knights back and forth, keeping every board
+    std::vector<PersistentBoard> boards{start};
+    std::vector<std::pair<Move::position, Move::position>> moves{
+        {std::make_pair(2, 1), std::make_pair(3, 3)}, {std::make_pair(2, 8), std::make_pair(3, 6)},
+        {std::make_pair(3, 3), std::make_pair(2, 1)}, {std::make_pair(3, 6), std::make_pair(2, 8)}
+    };
+    for(int i = 0; i < 400; i++) {
+        std::pair<Move::position, Move::position> move = moves[i % moves.size()];
+        boards.push_back(boards.back().movePiece(move.first, move.second));
+        CHECK(boards.back().getPieceCount() == 32);
+    }
+
+    // Each move only copies a path through the tree, not the whole board
+    std::size_t nodes = PersistentBoard::countNodes(boards);
+    CHECK(nodes > 32);
+    CHECK(nodes < 32 + 400 * 16);
+    CHECK(nodes < boards.size() * 32 / 2);
+}
+
+TEST_CASE("Persistent Board: Read boards from several threads")
+{
+    ChessGameState chessState{};
+    PersistentBoard start = PersistentBoard::fromBoard(*chessState.getBoard());
+
+    // Each thread branches from the same board while the others read it
+    std::vector<PersistentBoard> results(4);
+    std::vector<std::thread> threads{};
+    for(int i = 0; i < 4; i++) {
+        threads.emplace_back([&start, &results, i]() {
+            PersistentBoard board = start;
+            for(int j = 0; j < 200; j++) {
+                int file = 1 + (i + j) % 8;
+                board = board.movePiece(std::make_pair(file, 2), std::make_pair(file, 3))
+                    .movePiece(std::make_pair(file, 3), std::make_pair(file, 2));
+                if(start.getPieceCount() != 32 || start.getPiece(std::make_pair(file, 2)) == nullptr) {
+                    return;
+                }
+            }
+            results[i] = board;
+        });
+    }
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+    for(PersistentBoard& result : results) {
+        CHECK(result.getPieceCount() == 32);
+        CHECK(result.getPiece(std::make_pair(1, 2))->moved);
+    }
+    CHECK(start.getPiece(std::make_pair(1, 2))->moved == false);
+}
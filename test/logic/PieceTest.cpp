@@ -7,6 +7,8 @@
 #include "Move.h"
 #include "GameBoard.h"
 #include "GameState.h"
+#include "Action.h"
+#include "MovePieceAction.h"
 #include "TestPieces.h"
 
 using namespace testing;
@@ -181,6 +183,55 @@ TEST_CASE("Piece: Get maximum priority of all moves")
     CHECK(noMovesPiece->getMaxPriorityOfMoves(gameState) == 0);
 }
 
+TEST_CASE("Piece: Priority filtering does not copy the move cache")
+{
+    // Create a game with a piece that has moves with priorities 1, 1, and 5
+    GameBoard* board = new GameBoard{{ Player::white, Player::black }};
+    GameState gameState{ board, { Player::white, Player::black } };
+    Max5Piece* max5Piece = new Max5Piece(Player::white, std::make_pair(1, 1));
+    REQUIRE(board->addPieces({max5Piece}));
+
+    // Only the priority 5 move passes the filter
+    std::vector<Move>& allMoves = max5Piece->getMoves(gameState, true);
+    std::vector<Move>& filteredMoves = max5Piece->getMoves(gameState);
+    CHECK(allMoves.size() == 3);
+    REQUIRE(filteredMoves.size() == 1);
+    CHECK(filteredMoves[0].getPriority() == 5);
+
+    // Repeated queries return the same filtered moves and cached max priority
+    CHECK(&max5Piece->getMoves(gameState) == &filteredMoves);
+    CHECK(max5Piece->getMaxPriorityOfMoves(gameState) == 5);
+
+    // When every move passes the filter, the cache itself is returned
+    Priority1Piece* priority1Piece = new Priority1Piece(Player::black, std::make_pair(2, 2));
+    REQUIRE(board->addPieces({priority1Piece}));
+    gameState.setNextPlayer();
+    CHECK(&priority1Piece->getMoves(gameState) == &priority1Piece->getMoves(gameState, true));
+}
+
+TEST_CASE("Piece: Can reach a position")
+{
+    // Create a game with a piece that has moves with priorities 1, 1, and 5
+    GameBoard* board = new GameBoard{{ Player::white, Player::black }};
+    GameState gameState{ board, { Player::white, Player::black } };
+    FiveFivesOneOnePiece* manyPiece = new FiveFivesOneOnePiece{ Player::white }; // 5 5-priority moves to (1, 1) and 1 1-priority move to (1, 1)
+    REQUIRE(board->addPieces({manyPiece}));
+
+    // Make sure the piece reaches (1, 1) with every priority up to 5
+    CHECK(manyPiece->canReach(gameState, std::make_pair(1, 1)));
+    CHECK(manyPiece->canReach(gameState, std::make_pair(1, 1), 5));
+    CHECK(manyPiece->canReach(gameState, std::make_pair(1, 1), 6) == false);
+    CHECK(manyPiece->canReach(gameState, std::make_pair(2, 2)) == false);
+
+    // Make sure the moves to (1, 1) are found in order and filtered by priority
+    std::vector<Move> movesTo{};
+    manyPiece->getMovesTo(gameState, std::make_pair(1, 1), 0, movesTo);
+    CHECK(movesTo.size() == 6);
+    movesTo.clear();
+    manyPiece->getMovesTo(gameState, std::make_pair(1, 1), 5, movesTo);
+    CHECK(movesTo.size() == 5);
+}
+
 TEST_CASE("Piece: Get Attacked Spaces")
 {
     // Create a GameState for testing
@@ -209,4 +260,74 @@ TEST_CASE("Piece: Manage on-board")
     // Set onBoard to false and make sure it updates properly
     piece.setOnBoard(false);
     CHECK(piece.getOnBoard() == false);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Piece: Move cache reuses positions")
+{
+    // Create a game with a piece that counts move generations and a piece to move around
+    // - countingPiece's moves only depend on (0, 0) and (1, 1)
+    GameBoard* board = new GameBoard();
+    GameState gameState{board};
+    CountingPiece* countingPiece = new CountingPiece(Player::white, std::make_pair(0, 0));
+    Piece* otherPiece = new Piece(Player::white, std::make_pair(5, 5));
+    REQUIRE(board->addPieces({countingPiece, otherPiece}));
+
+    // Moves are only generated once for the same position
+    CHECK(countingPiece->getMoves(gameState).size() == 1);
+    countingPiece->getAttackingMoves(gameState);
+    countingPiece->getMoves(gameState);
+    countingPiece->getAttackingMoves(gameState);
+    CHECK(countingPiece->generated == 1);
+    CHECK(countingPiece->attackGenerated == 1);
+
+    // Simulating a move that does not touch (0, 0) or (1, 1) reuses the moves
+    std::shared_ptr<Action> farMove = std::make_shared<MovePieceAction>(std::make_pair(0, 0), std::make_pair(1, 1));
+    REQUIRE(gameState.callAction(farMove, std::make_pair(5, 5)));
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 1);
+    REQUIRE(board->revertSimulation());
+
+    // Simulating a move onto (1, 1) generates new moves, but only once
+    std::shared_ptr<Action> blockingMove = std::make_shared<MovePieceAction>(std::make_pair(0, 0), std::make_pair(-4, -4));
+    REQUIRE(gameState.callAction(blockingMove, std::make_pair(5, 5)));
+    CHECK(countingPiece->getMoves(gameState).size() == 0);
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 2);
+
+    // Reverting the simulation returns to the cached moves of the original position
+    REQUIRE(board->revertSimulation());
+    CHECK(countingPiece->getMoves(gameState).size() == 1);
+    CHECK(countingPiece->generated == 2);
+
+    // Simulating the same position again reuses the simulated moves
+    REQUIRE(gameState.callAction(blockingMove, std::make_pair(5, 5)));
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 2);
+    REQUIRE(board->revertSimulation());
+
+    // Moves are reused across turns as long as (0, 0) and (1, 1) do not change
+    REQUIRE(board->movePiece(std::make_pair(5, 5), std::make_pair(7, 7)));
+    gameState.nextTurn();
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 2);
+
+    // Moving a piece onto (1, 1) generates new moves
+    REQUIRE(board->movePiece(std::make_pair(7, 7), std::make_pair(1, 1)));
+    CHECK(countingPiece->getMoves(gameState).size() == 0);
+    CHECK(countingPiece->generated == 3);
+
+    // Clearing the cache always generates new moves
+    countingPiece->clearMoveCache();
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 4);
+
+    // Pieces whose moves depend on the turn generate new moves every turn
+    countingPiece->dependsOnTurn = true;
+    countingPiece->clearMoveCache();
+    countingPiece->getMoves(gameState);
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 5);
+    gameState.nextTurn();
+    countingPiece->getMoves(gameState);
+    CHECK(countingPiece->generated == 6);
+}
@@ -0,0 +1,192 @@
+#include <vector>
+#include <limits>
+#include <memory>
+
+#include "doctest.h"
+#include "Search.h"
+#include "ChessGameState.h"
+#include "ChessBoard.h"
+#include "ChessFen.h"
+#include "Move.h"
+#include "Piece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "King.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+
+TEST_CASE("Search: Captures a free piece")
+{
+    // Let a white rook capture an undefended black queen
+    ChessBoard* board = new ChessBoard(false);
+    board->addPieces({
+        new King(Player::white, std::make_pair(8, 1)),
+        new King(Player::black, std::make_pair(8, 8)),
+        new Rook(Player::white, std::make_pair(1, 1)),
+        new Queen(Player::black, std::make_pair(1, 5))
+    });
+    ChessGameState chessState{board};
+
+    // The rook takes the queen and white is up a rook
+    Search search{chessState, Search::materialEvaluation};
+    Search::Result result = search.findBestMove(1);
+    REQUIRE(result.found);
+    CHECK(result.move.start == std::make_pair(1, 1));
+    CHECK(result.move.end == std::make_pair(1, 5));
+    CHECK(result.score == doctest::Approx(5.0));
+}
+
+TEST_CASE("Search: Quiescence sees recaptures")
+{
+    // Let a white rook capture a black pawn that is defended by another pawn
+    ChessBoard* board = new ChessBoard(false);
+    board->addPieces({
+        new King(Player::white, std::make_pair(8, 1)),
+        new King(Player::black, std::make_pair(8, 8)),
+        new Rook(Player::white, std::make_pair(4, 1)),
+        new Pawn(Player::black, std::make_pair(4, 6)),
+        new Pawn(Player::black, std::make_pair(3, 7))
+    });
+    ChessGameState chessState{board};
+
+    // Taking the pawn loses the rook, so the material stays the same instead
+    Search search{chessState, Search::materialEvaluation};
+    Search::Result result = search.findBestMove(1);
+    REQUIRE(result.found);
+    CHECK(result.move.end != std::make_pair(4, 6));
+    CHECK(result.score == doctest::Approx(3.0));
+    CHECK(search.getQuiescenceNodeCount() > 0);
+}
+
+TEST_CASE("Search: Forced moves cannot be skipped in quiescence")
+{
+    // Set up an En Passant for white
+    ChessGameState chessState{};
+    REQUIRE(chessState.movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+    REQUIRE(chessState.movePiece(std::make_pair(1, 7), std::make_pair(1, 6)));
+    REQUIRE(chessState.movePiece(std::make_pair(5, 4), std::make_pair(5, 5)));
+    REQUIRE(chessState.movePiece(std::make_pair(4, 7), std::make_pair(4, 5)));
+
+    // Score positions where the white pawn has not moved highly for white, so
+    // standing pat would look best if it were allowed
+    Search search{chessState, [](GameState& gameState) {
+        Piece* piece = gameState.getBoard()->getPiece(std::make_pair(5, 5));
+        if(!piece || !piece->getPlayerAccess(Player::white)) {
+            return 0.0;
+        }
+        return gameState.getCrntPlayer() == Player::white ? 50.0 : -50.0;
+    }};
+    double infinity = std::numeric_limits<double>::infinity();
+    CHECK(search.quiescence(-infinity, infinity) < 50.0);
+}
+
+TEST_CASE("Search: The game state is restored after searching")
+{
+    // Search the starting position with an evaluation that counts its calls
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    std::uint64_t positionHash = board->getPositionHash();
+    int turn = chessState.getTurn();
+    int evaluations = 0;
+    Search search{chessState, [&evaluations](GameState& gameState) {
+        evaluations++;
+        return Search::materialEvaluation(gameState);
+    }};
+    Search::Result result = search.findBestMove(2);
+    REQUIRE(result.found);
+    CHECK(evaluations > 0);
+    CHECK(search.getNodeCount() > 0);
+
+    // Nothing changed, so the move can be played
+    CHECK(board->getPositionHash() == positionHash);
+    CHECK(chessState.getTurn() == turn);
+    CHECK(chessState.getCrntPlayer() == Player::white);
+    CHECK(chessState.getSimulatedMoveCount() == 0);
+    CHECK(chessState.movePiece(result.move.start, result.move.end, result.move.idx));
+
+    // Resetting the node counts
+    search.resetNodeCounts();
+    CHECK(search.getNodeCount() == 0);
+    CHECK(search.getQuiescenceNodeCount() == 0);
+}
+
+TEST_CASE("Search: Perft")
+{
+    // Every first move and reply from the starting position
+    ChessGameState chessState{};
+    GameBoard* board = chessState.getBoard();
+    std::uint64_t positionHash = board->getPositionHash();
+    Search search{chessState};
+    CHECK(search.perft(0) == 1);
+    CHECK(search.perft(1) == 20);
+    CHECK(search.perft(2) == 400);
+    CHECK(board->getPositionHash() == positionHash);
+    CHECK(chessState.getSimulatedMoveCount() == 0);
+    CHECK(search.getNodeCount() == 0);
+}
+
+TEST_CASE("Search: Simulated moves count as moves")
+{
+    // A king that moves away and back during a search can no longer castle
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1")};
+    REQUIRE(chessState != nullptr);
+    std::unique_ptr<ChessGameState> played{ChessFen::load("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1")};
+    std::vector<std::pair<Move::position, Move::position>> moves{
+        {std::make_pair(5, 1), std::make_pair(6, 1)}, {std::make_pair(1, 8), std::make_pair(2, 8)},
+        {std::make_pair(6, 1), std::make_pair(5, 1)}, {std::make_pair(2, 8), std::make_pair(1, 8)}
+    };
+    for(std::pair<Move::position, Move::position>& move : moves) {
+        std::vector<Move> movesToEnd = chessState->getMovesOfPiece(move.first, move.second);
+        REQUIRE(movesToEnd.size() == 1);
+        REQUIRE(chessState->makeSimulatedMove(move.first, move.second, movesToEnd[0]));
+        REQUIRE(played->movePiece(move.first, move.second));
+    }
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(7, 1)) == false);
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(3, 1)) == false);
+    CHECK(played->canMovePiece(std::make_pair(5, 1), std::make_pair(7, 1)) == false);
+
+    // The simulated position has the same moves as the played one
+    Search search{*chessState};
+    Search playedSearch{*played};
+    CHECK(search.perft(3) == playedSearch.perft(3));
+
+    // Unmaking the moves gives the rights back
+    for(std::size_t i = 0; i < moves.size(); i++) {
+        REQUIRE(chessState->unmakeSimulatedMove());
+    }
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(7, 1)));
+    CHECK(chessState->canMovePiece(std::make_pair(5, 1), std::make_pair(3, 1)));
+    CHECK(chessState->getBoard()->getPiece(std::make_pair(5, 1))->previouslyMoved() == false);
+}
+
+TEST_CASE("Search: Checkmate and stalemate")
+{
+    // Ra8 is checkmate, which is worth more than taking the knight
+    std::unique_ptr<ChessGameState> chessState{ChessFen::load("6k1/5ppp/8/8/8/8/8/Rn4K1 w - - 0 1")};
+    REQUIRE(chessState != nullptr);
+    Search search{*chessState};
+    for(int depth = 1; depth <= 3; depth++) {
+        Search::Result result = search.findBestMove(depth);
+        REQUIRE(result.found);
+        CHECK(result.move.start == std::make_pair(1, 1));
+        CHECK(result.move.end == std::make_pair(1, 8));
+        CHECK(result.score == Search::mateScore - 1);
+    }
+
+    // A checkmated player loses and a stalemated player draws
+    double infinity = std::numeric_limits<double>::infinity();
+    std::unique_ptr<ChessGameState> checkmate{ChessFen::load("k7/1Q6/1K6/8/8/8/8/8 b - - 0 1")};
+    Search checkmateSearch{*checkmate};
+    CHECK(checkmateSearch.alphaBeta(2, -infinity, infinity) == -Search::mateScore);
+    CHECK(checkmateSearch.quiescence(-infinity, infinity) == -Search::mateScore);
+    CHECK(checkmateSearch.findBestMove(1).found == false);
+    std::unique_ptr<ChessGameState> stalemate{ChessFen::load("7k/8/6Q1/8/8/8/8/K7 b - - 0 1")};
+    Search stalemateSearch{*stalemate};
+    CHECK(stalemateSearch.alphaBeta(2, -infinity, infinity) == 0.0);
+    CHECK(stalemateSearch.quiescence(-infinity, infinity) == 0.0);
+}
@@ -0,0 +1,115 @@
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+#include "SharedGameState.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+
+TEST_CASE("Shared Game State: Snapshots match the game state")
+{
+    ChessGameState chessState{};
+    chessState.movePiece(std::make_pair(5, 2), std::make_pair(5, 4));
+    GameSnapshot snapshot{chessState};
+    CHECK(snapshot.getTurn() == chessState.getTurn());
+    CHECK(snapshot.getCrntPlayer() == Player::black);
+    CHECK(snapshot.getPositionKey() == chessState.getPositionKey());
+
+    // Legal moves
+    std::vector<GameState::LegalMove> legalMoves{};
+    chessState.generateAllLegalMoves(legalMoves);
+    CHECK(snapshot.getLegalMoves().size() == legalMoves.size());
+    for(const GameState::LegalMove& legalMove : legalMoves) {
+        CHECK(snapshot.isLegal(legalMove.start, legalMove.end, legalMove.idx));
+    }
+    CHECK(snapshot.isLegal(std::make_pair(5, 7), std::make_pair(5, 5)));
+    CHECK(snapshot.isLegal(std::make_pair(5, 7), std::make_pair(5, 5), 1) == false);
+    CHECK(snapshot.isLegal(std::make_pair(5, 2), std::make_pair(5, 3)) == false);
+
+    // Pieces
+    CHECK(snapshot.getPieces().size() == 32);
+    const GameSnapshot::PieceInfo* pawn = snapshot.getPiece(std::make_pair(5, 4));
+    REQUIRE(pawn != nullptr);
+    CHECK(pawn->id == PAWN_ID);
+    CHECK(pawn->moved);
+    CHECK(pawn->playerMask == chessState.getBoard()->getPiece(5, 4)->getPlayerMask());
+    CHECK(snapshot.getPiece(std::make_pair(5, 2)) == nullptr);
+
+    // Attacked spaces
+    for(Player player : {Player::white, Player::black}) {
+        std::vector<Move::position> attacked = chessState.getSpacesAttackedByPlayer(player);
+        for(Move::position position : attacked) {
+            CHECK(snapshot.isAttacked(player == Player::white ? Player::black : Player::white, position));
+        }
+    }
+    CHECK(snapshot.isAttacked(Player::black, std::make_pair(4, 5)));
+    CHECK(snapshot.isAttacked(Player::white, std::make_pair(4, 5)) == false);
+    CHECK(snapshot.getSpacesAttackedByPlayer(Player::silver).empty());
+}
+
+TEST_CASE("Shared Game State: Read while another thread moves")
+{
+    // Play a seeded game first to know the legal move counts of each turn
+    std::vector<GameState::LegalMove> played{};
+    std::vector<std::size_t> moveCounts{};
+    {
+        ChessGameState chessState{};
+        std::mt19937 random{49};
+        std::vector<GameState::LegalMove> legalMoves{};
+        for(int ply = 0; ply < 30; ply++) {
+            chessState.generateAllLegalMoves(legalMoves);
+            moveCounts.push_back(legalMoves.size());
+            if(legalMoves.empty()) {
+                break;
+            }
+            played.push_back(legalMoves[random() % legalMoves.size()]);
+            REQUIRE(chessState.movePiece(played.back().start, played.back().end, played.back().idx));
+        }
+        chessState.generateAllLegalMoves(legalMoves);
+        moveCounts.push_back(legalMoves.size());
+    }
+
+    // Replay it while readers check every snapshot they see
+    ChessGameState chessState{};
+    int firstTurn = chessState.getTurn();
+    SharedGameState shared{chessState};
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+    std::atomic<int> reads{0};
+    std::vector<std::thread> readers{};
+    for(int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            int lastTurn = firstTurn;
+            while(!done || reads < 10) {
+                std::shared_ptr<const GameSnapshot> snapshot = shared.getSnapshot();
+                std::size_t ply = static_cast<std::size_t>(snapshot->getTurn() - firstTurn);
+                if(snapshot->getTurn() < lastTurn || ply >= moveCounts.size() || snapshot->getLegalMoves().size() != moveCounts[ply]) {
+                    mismatches++;
+                }
+                lastTurn = snapshot->getTurn();
+                reads++;
+            }
+        });
+    }
+    for(const GameState::LegalMove& move : played) {
+        REQUIRE(shared.movePiece(move.start, move.end, move.idx));
+    }
+    CHECK(shared.movePiece(std::make_pair(1, 1), std::make_pair(1, 5)) == false);
+    done = true;
+    for(std::thread& reader : readers) {
+        reader.join();
+    }
+    CHECK(mismatches == 0);
+    CHECK(shared.getSnapshot()->getTurn() == chessState.getTurn());
+    CHECK(shared.getSnapshot()->getLegalMoves().size() == moveCounts.back());
+}
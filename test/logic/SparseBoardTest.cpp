@@ -0,0 +1,153 @@
+#include <vector>
+#include <iostream>
+
+#include "doctest.h"
+#include "SparseBoard.h"
+#include "GameBoard.h"
+#include "Move.h"
+#include "Piece.h"
+
+using namespace logic;
+
+TEST_CASE("Sparse Board: Set, get, and clear positions")
+{
+    // Create a sparse board and a piece to store in it
+    SparseBoard board{};
+    Piece piece{};
+
+    // Make sure the board starts empty and reading does not allocate tiles
+    CHECK(board.get(std::make_pair(3, 4)) == nullptr);
+    CHECK(board.occupied(std::make_pair(3, 4)) == false);
+    CHECK(board.size() == 0);
+    CHECK(board.tileCount() == 0);
+
+    // Add the piece and make sure it can be found
+    board.set(std::make_pair(3, 4), &piece);
+    CHECK(board.get(std::make_pair(3, 4)) == &piece);
+    CHECK(board.occupied(std::make_pair(3, 4)));
+    CHECK(board.occupied(std::make_pair(4, 3)) == false);
+    CHECK(board.size() == 1);
+    CHECK(board.tileCount() == 1);
+
+    // Clear the position and make sure it is empty again
+    board.set(std::make_pair(3, 4), nullptr);
+    CHECK(board.get(std::make_pair(3, 4)) == nullptr);
+    CHECK(board.occupied(std::make_pair(3, 4)) == false);
+    CHECK(board.size() == 0);
+
+    // Clearing an unused position should not allocate a tile
+    board.set(std::make_pair(-500, 500), nullptr);
+    CHECK(board.tileCount() == 1);
+}
+
+TEST_CASE("Sparse Board: Negative and distant coordinates")
+{
+    // Create a sparse board and pieces to store in it
+    SparseBoard board{};
+    Piece piece1{};
+    Piece piece2{};
+    Piece piece3{};
+
+    // Add pieces on either side of 0 and very far away
+    board.set(std::make_pair(-1, -1), &piece1);
+    board.set(std::make_pair(0, 0), &piece2);
+    board.set(std::make_pair(5000, -7000), &piece3);
+
+    // Make sure each piece is stored in the correct place
+    CHECK(board.get(std::make_pair(-1, -1)) == &piece1);
+    CHECK(board.get(std::make_pair(0, 0)) == &piece2);
+    CHECK(board.get(std::make_pair(5000, -7000)) == &piece3);
+    CHECK(board.get(std::make_pair(-1, 0)) == nullptr);
+    CHECK(board.get(std::make_pair(7, 7)) == nullptr);
+
+    // (-1, -1) and (0, 0) are in different tiles, and the distant piece is in a third tile
+    CHECK(board.size() == 3);
+    CHECK(board.tileCount() == 3);
+}
+
+TEST_CASE("Sparse Board: Find next occupied position along a ray")
+{
+    // Create a sparse board and pieces to store in it
+    SparseBoard board{};
+    Piece nearPiece{};
+    Piece farPiece{};
+    Piece diagonalPiece{};
+    board.set(std::make_pair(3, 0), &nearPiece);
+    board.set(std::make_pair(4000, 0), &farPiece);
+    board.set(std::make_pair(-2500, -2500), &diagonalPiece);
+
+    // Make sure the first blocker is found in each direction
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(1, 0), 10000) == 3);
+    CHECK(board.findNextOccupied(std::make_pair(3, 0), std::make_pair(1, 0), 10000) == 3997);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, -1), 10000) == 2500);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(0, 1), 10000) == -1);
+
+    // Make sure the step limit is respected
+    CHECK(board.findNextOccupied(std::make_pair(3, 0), std::make_pair(1, 0), 3996) == -1);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, -1), 2499) == -1);
+
+    // Make sure rays that are not straight lines still land exactly on pieces
+    CHECK(board.findNextOccupied(std::make_pair(-1, -4), std::make_pair(1, 1), 100) == 4);
+    CHECK(board.findNextOccupied(std::make_pair(2000, -2), std::make_pair(1000, 1), 100) == 2);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(0, 0), 100) == -1);
+}
+
+TEST_CASE("Sparse Board: Game board uses sparse storage")
+{
+    // Create an infinite board with pieces far apart
+    GameBoard board{};
+    Piece* nearPiece = new Piece{std::make_pair(0, 0)};
+    Piece* farPiece = new Piece{std::make_pair(0, 3000)};
+    REQUIRE(board.addPieces({nearPiece, farPiece}));
+
+    // Querying empty positions should not change what is on the board
+    CHECK(board.occupiedOnBoard(0, 1) == false);
+    CHECK(board.unoccupiedOnBoard(0, 2));
+    CHECK(board.getPiece(0, 3) == nullptr);
+
+    // Make sure rays walk all the way to the far piece
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(0, 1), 5000) == 3000);
+
+    // Move the far piece closer and make sure the ray follows it
+    CHECK(board.movePiece(std::make_pair(0, 3000), std::make_pair(0, 10)));
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(0, 1), 5000) == 10);
+    CHECK(board.getPiece(0, 3000) == nullptr);
+    CHECK(board.getPiece(0, 10) == farPiece);
+}
+
+TEST_CASE("Sparse Board: Line index stays in sync with the board")
+{
+    // Create a sparse board with pieces on a row, a column, and both diagonals around (0, 0)
+    SparseBoard board{};
+    Piece rowPiece{};
+    Piece columnPiece{};
+    Piece diagonalPiece{};
+    Piece antiDiagonalPiece{};
+    board.set(std::make_pair(-100000, 0), &rowPiece);
+    board.set(std::make_pair(0, 100000), &columnPiece);
+    board.set(std::make_pair(70000, 70000), &diagonalPiece);
+    board.set(std::make_pair(-90000, 90000), &antiDiagonalPiece);
+
+    // Make sure each straight ray jumps directly to its blocker
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, 0), 1000000) == 100000);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(0, 1), 1000000) == 100000);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(1, 1), 1000000) == 70000);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, 1), 1000000) == 90000);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(1, 0), 1000000) == -1);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(1, -1), 1000000) == -1);
+
+    // Rays that start on a piece ignore it
+    CHECK(board.findNextOccupied(std::make_pair(70000, 70000), std::make_pair(-1, -1), 1000000) == -1);
+
+    // Move a blocker closer and make sure the index follows it
+    board.set(std::make_pair(-100000, 0), nullptr);
+    board.set(std::make_pair(-7, 0), &rowPiece);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, 0), 1000000) == 7);
+    CHECK(board.findNextOccupied(std::make_pair(-8, 0), std::make_pair(-1, 0), 1000000) == -1);
+    CHECK(board.findNextOccupied(std::make_pair(-8, 0), std::make_pair(1, 0), 1000000) == 1);
+
+    // Replacing a piece without emptying the position should not duplicate it in the index
+    board.set(std::make_pair(-7, 0), &columnPiece);
+    board.set(std::make_pair(-7, 0), nullptr);
+    CHECK(board.findNextOccupied(std::make_pair(0, 0), std::make_pair(-1, 0), 1000000) == -1);
+}
@@ -0,0 +1,159 @@
+#include <vector>
+#include <algorithm>
+#include <tuple>
+
+#include "doctest.h"
+#include "StagedMoveGenerator.h"
+#include "ChessGameState.h"
+#include "ChessBoard.h"
+#include "Move.h"
+#include "Piece.h"
+#include "GameBoard.h"
+#include "GameState.h"
+#include "King.h"
+#include "Knight.h"
+#include "Pawn.h"
+#include "Queen.h"
+#include "Rook.h"
+
+using namespace logic;
+using namespace chess;
+using Player = Piece::Player;
+using Stage = StagedMoveGenerator::Stage;
+
+TEST_CASE("Staged Move Generator: Hands out every legal move")
+{
+    // Play a game with a fixed pseudo-random sequence of legal moves
+    ChessGameState chessState{};
+    std::vector<GameState::LegalMove> legalMoves{};
+    unsigned int seed = 2468;
+    for(int ply = 0; ply < 40; ply++) {
+        chessState.generateAllLegalMoves(legalMoves);
+
+        // Collect every move from the generator and make sure the stages never
+        // go backwards
+        StagedMoveGenerator generator{chessState};
+        StagedMoveGenerator::StagedMove stagedMove{};
+        std::vector<std::tuple<Move::position, Move::position, int>> found{};
+        Stage lastStage = Stage::forced;
+        while(generator.next(stagedMove)) {
+            CHECK(static_cast<int>(stagedMove.stage) >= static_cast<int>(lastStage));
+            lastStage = stagedMove.stage;
+            found.emplace_back(stagedMove.start, stagedMove.end, stagedMove.priority);
+        }
+        CHECK(generator.getStage() == Stage::done);
+
+        // The generator must find the same moves as generateAllLegalMoves()
+        std::vector<std::tuple<Move::position, Move::position, int>> expected{};
+        for(GameState::LegalMove& move : legalMoves) {
+            expected.emplace_back(move.start, move.end, move.priority);
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        CHECK(found == expected);
+        if(legalMoves.empty()) {
+            break;
+        }
+
+        // Make one of the moves
+        seed = seed * 1103515245 + 12345;
+        GameState::LegalMove move = legalMoves[(seed >> 16) % legalMoves.size()];
+        REQUIRE(chessState.movePiece(move.start, move.end, move.idx));
+    }
+}
+
+TEST_CASE("Staged Move Generator: Forced moves block every other move")
+{
+    // Set up an En Passant for white
+    ChessGameState chessState{};
+    REQUIRE(chessState.movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+    REQUIRE(chessState.movePiece(std::make_pair(1, 7), std::make_pair(1, 6)));
+    REQUIRE(chessState.movePiece(std::make_pair(5, 4), std::make_pair(5, 5)));
+    REQUIRE(chessState.movePiece(std::make_pair(4, 7), std::make_pair(4, 5)));
+
+    // En Passant is the only move handed out
+    StagedMoveGenerator generator{chessState};
+    StagedMoveGenerator::StagedMove stagedMove{};
+    REQUIRE(generator.next(stagedMove));
+    CHECK(stagedMove.stage == Stage::forced);
+    CHECK(stagedMove.priority == 10);
+    CHECK(stagedMove.start == std::make_pair(5, 5));
+    CHECK(stagedMove.end == std::make_pair(4, 6));
+    CHECK(generator.next(stagedMove) == false);
+    CHECK(generator.getStage() == Stage::done);
+}
+
+TEST_CASE("Staged Move Generator: Captures are ordered by victim and attacker")
+{
+    // Let a pawn and a rook capture a queen, and let the pawn capture a knight
+    // Also give white a pawn that can promote
+    ChessBoard* board = new ChessBoard(false);
+    board->addPieces({
+        new King(Player::white, std::make_pair(8, 1)),
+        new King(Player::black, std::make_pair(8, 8)),
+        new Pawn(Player::white, std::make_pair(3, 3)),
+        new Rook(Player::white, std::make_pair(4, 1)),
+        new Pawn(Player::white, std::make_pair(6, 7)),
+        new Queen(Player::black, std::make_pair(4, 4)),
+        new Knight(Player::black, std::make_pair(2, 4))
+    });
+    ChessGameState chessState{board};
+    StagedMoveGenerator generator{chessState};
+    StagedMoveGenerator::StagedMove stagedMove{};
+
+    // The queen is captured first with the cheaper piece
+    REQUIRE(generator.next(stagedMove));
+    CHECK(stagedMove.stage == Stage::captures);
+    CHECK(stagedMove.start == std::make_pair(3, 3));
+    CHECK(stagedMove.end == std::make_pair(4, 4));
+    REQUIRE(generator.next(stagedMove));
+    CHECK(stagedMove.stage == Stage::captures);
+    CHECK(stagedMove.start == std::make_pair(4, 1));
+    CHECK(stagedMove.end == std::make_pair(4, 4));
+
+    // Then the knight
+    REQUIRE(generator.next(stagedMove));
+    CHECK(stagedMove.stage == Stage::captures);
+    CHECK(stagedMove.start == std::make_pair(3, 3));
+    CHECK(stagedMove.end == std::make_pair(2, 4));
+
+    // Then the 5 promotions and 4 knight boosts before any quiet move
+    int promotions = 0;
+    REQUIRE(generator.next(stagedMove));
+    while(stagedMove.stage == Stage::promotions) {
+        CHECK(stagedMove.start == std::make_pair(6, 7));
+        promotions++;
+        REQUIRE(generator.next(stagedMove));
+    }
+    CHECK(promotions == 9);
+    CHECK(stagedMove.stage == Stage::quiets);
+}
+
+TEST_CASE("Staged Move Generator: Tactical generation skips quiet moves")
+{
+    // Give white captures, promotions, and quiet moves
+    ChessBoard* board = new ChessBoard(false);
+    board->addPieces({
+        new King(Player::white, std::make_pair(8, 1)),
+        new King(Player::black, std::make_pair(8, 8)),
+        new Pawn(Player::white, std::make_pair(3, 3)),
+        new Rook(Player::white, std::make_pair(4, 1)),
+        new Pawn(Player::white, std::make_pair(6, 7)),
+        new Queen(Player::black, std::make_pair(4, 4)),
+        new Knight(Player::black, std::make_pair(2, 4))
+    });
+    ChessGameState chessState{board};
+
+    // Only the 3 captures, 5 promotions, and 4 knight boosts are handed out
+    StagedMoveGenerator generator{chessState, true};
+    StagedMoveGenerator::StagedMove stagedMove{};
+    int captures = 0;
+    int promotions = 0;
+    while(generator.next(stagedMove)) {
+        CHECK(stagedMove.stage != Stage::quiets);
+        captures += stagedMove.stage == Stage::captures;
+        promotions += stagedMove.stage == Stage::promotions;
+    }
+    CHECK(captures == 3);
+    CHECK(promotions == 9);
+}
@@ -0,0 +1,101 @@
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "doctest.h"
+#include "Stats.h"
+#include "ChessBoard.h"
+#include "ChessGameState.h"
+#include "ChessPiece.h"
+#include "MovePieceAction.h"
+#include "Move.h"
+
+using namespace logic;
+using namespace chess;
+
+#ifdef ENABLE_STATS
+TEST_CASE("Stats: Counters are not recorded while disabled")
+{
+    // Create a standard chess game
+    ChessBoard* board = new ChessBoard();
+    ChessGameState* chessState = new ChessGameState(board);
+
+    // Generate moves with statistics disabled
+    Stats::setEnabled(false);
+    Stats::reset();
+    CHECK(chessState->canMovePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+
+    // Make sure nothing was recorded
+    CHECK(Stats::getGenerateMoves(PAWN_ID) == 0);
+    CHECK(Stats::getCacheMisses(Stats::Cache::moves) == 0);
+    CHECK(Stats::getSimulationsStarted() == 0);
+    CHECK(Stats::getTimerCalls(Stats::Timer::addToMove) == 0);
+}
+
+TEST_CASE("Stats: Move generation counters")
+{
+    // Create a standard chess game
+    ChessBoard* board = new ChessBoard();
+    ChessGameState* chessState = new ChessGameState(board);
+
+    // Enable statistics and check a move
+    Stats::setEnabled(true);
+    Stats::reset();
+    CHECK(chessState->canMovePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+
+    // Make sure the pawn's moves were generated and simulated
+    CHECK(Stats::getGenerateMoves(PAWN_ID) > 0);
+    CHECK(Stats::getCacheMisses(Stats::Cache::moves) > 0);
+    CHECK(Stats::getSimulationsStarted() > 0);
+    CHECK(Stats::getSimulationsStarted() == Stats::getSimulationsReverted());
+    CHECK(Stats::getTimerCalls(Stats::Timer::addToMove) > 0);
+    CHECK(Stats::getActions(typeid(MovePieceAction)) > 0);
+
+    // Checking the same piece again on the same turn should hit the cache
+    std::uint64_t generated = Stats::getGenerateMoves(PAWN_ID);
+    std::uint64_t hits = Stats::getCacheHits(Stats::Cache::moves);
+    CHECK(chessState->canMovePiece(std::make_pair(5, 2), std::make_pair(5, 3)));
+    CHECK(Stats::getCacheHits(Stats::Cache::moves) > hits);
+    CHECK(Stats::getGenerateMoves(PAWN_ID) == generated);
+
+    // Reset the counters
+    Stats::reset();
+    CHECK(Stats::getGenerateMoves(PAWN_ID) == 0);
+    CHECK(Stats::getActions(typeid(MovePieceAction)) == 0);
+    Stats::setEnabled(false);
+}
+
+TEST_CASE("Stats: JSON output")
+{
+    // Create a standard chess game and make a move with statistics enabled
+    ChessBoard* board = new ChessBoard();
+    ChessGameState* chessState = new ChessGameState(board);
+    Stats::setEnabled(true);
+    Stats::reset();
+    CHECK(chessState->movePiece(std::make_pair(5, 2), std::make_pair(5, 4)));
+
+    // Write the statistics
+    std::ostringstream os{};
+    Stats::writeJSON(os);
+    std::string json = os.str();
+    Stats::setEnabled(false);
+
+    // Make sure every section is present
+    CHECK(json.front() == '{');
+    CHECK(json.back() == '}');
+    CHECK(json.find("\"enabled\":true") != std::string::npos);
+    CHECK(json.find("\"generateMoves\":{") != std::string::npos);
+    CHECK(json.find("\"generateAttackingMoves\":{") != std::string::npos);
+    CHECK(json.find("\"moveCache\":{\"hits\":") != std::string::npos);
+    CHECK(json.find("\"simulations\":{\"started\":") != std::string::npos);
+    CHECK(json.find("\"logic::MovePieceAction\":") != std::string::npos);
+    CHECK(json.find("\"addToMove\":{\"calls\":") != std::string::npos);
+}
+#else
+TEST_CASE("Stats: Statistics cannot be enabled when compiled out")
+{
+    Stats::setEnabled(true);
+    CHECK(Stats::isEnabled() == false);
+}
+#endif
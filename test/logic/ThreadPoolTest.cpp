@@ -0,0 +1,44 @@
+#include <vector>
+#include <future>
+#include <atomic>
+#include <stdexcept>
+
+#include "doctest.h"
+#include "ThreadPool.h"
+
+using namespace logic;
+
+TEST_CASE("Thread Pool: Tasks return their results")
+{
+    ThreadPool pool{4};
+    CHECK(pool.getThreadCount() == 4);
+
+    // Every task's result comes back through its own future
+    std::vector<std::future<int>> results{};
+    for(int i = 0; i < 100; i++) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    for(int i = 0; i < 100; i++) {
+        CHECK(results[i].get() == i * i);
+    }
+
+    // Exceptions are passed to the future
+    std::future<int> failure = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+    CHECK_THROWS_AS(failure.get(), std::runtime_error);
+}
+
+TEST_CASE("Thread Pool: Destroying the pool finishes every task")
+{
+    std::atomic<int> finished{0};
+    {
+        ThreadPool pool{2};
+        for(int i = 0; i < 50; i++) {
+            pool.submit([&finished]() { finished++; });
+        }
+    }
+    CHECK(finished == 50);
+
+    // A pool always has at least one thread
+    ThreadPool defaultPool{};
+    CHECK(defaultPool.getThreadCount() >= 1);
+}
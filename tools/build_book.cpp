@@ -0,0 +1,47 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "GameRecord.h"
+#include "OpeningBook.h"
+
+using namespace chess;
+
+/*
+* Builds an opening book out of game record files
+* - Usage: build-book <output file> <max ply> <game record files...>
+* - Only the first max ply moves of each game are added to the book
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <output file> <max ply> <game record files...>\n";
+        return 2;
+    }
+    std::uint32_t maxPly = static_cast<std::uint32_t>(std::atoi(argv[2]));
+
+    // Add the moves of every game
+    OpeningBookBuilder builder{};
+    std::size_t games = 0;
+    std::size_t failed = 0;
+    for(int i = 3; i < argc; i++) {
+        GameRecordReader reader{};
+        if(!reader.open(argv[i])) {
+            std::cerr << "Could not read " << argv[i] << "\n";
+            return 2;
+        }
+        GameRecordReader::Game game{};
+        while(reader.next(game)) {
+            games++;
+            failed += !builder.addGame(game, maxPly);
+        }
+    }
+
+    std::ofstream output{argv[1], std::ios::binary};
+    if(!output || !builder.write(output)) {
+        std::cerr << "Could not write to " << argv[1] << "\n";
+        return 1;
+    }
+    std::cerr << games << " games, " << failed << " could not be replayed, " << builder.getAddedCount() << " moves added\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Tablebase.h"
+
+using namespace chess;
+
+/*
+* Builds the endgame table of a set of pieces
+* - Usage: build-tablebase <material> <output file> [threads]
+* - Material is written like KQvKR (see Tablebase.h), and threads defaults to
+*   one per hardware thread
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <material> <output file> [threads]\n";
+        return 2;
+    }
+    std::string material = TablebaseGenerator::getCanonicalMaterial(argv[1]);
+    if(material.empty()) {
+        std::cerr << "Invalid material " << argv[1] << "\n";
+        return 2;
+    }
+    std::size_t threadCount = argc > 3 ? static_cast<std::size_t>(std::atoi(argv[3])) : 0;
+
+    TablebaseGenerator generator{{threadCount}};
+    const std::vector<std::uint8_t>* values = generator.generate(material);
+    if(!values) {
+        std::cerr << "Could not build " << material << "\n";
+        return 1;
+    }
+
+    std::ofstream output{argv[2], std::ios::binary};
+    if(!output || !TablebaseGenerator::write(output, material, *values)) {
+        std::cerr << "Could not write to " << argv[2] << "\n";
+        return 1;
+    }
+
+    // Report the longest win
+    int longestWin = 0;
+    for(std::uint8_t value : *values) {
+        Tablebase::Probe probe{};
+        if(Tablebase::decodeValue(value, probe) && probe.wdl == Tablebase::Wdl::win) {
+            longestWin = std::max(longestWin, probe.distance);
+        }
+    }
+    std::cerr << material << ": " << values->size() << " positions, longest win " << longestWin << " plies\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "EpdRunner.h"
+
+using namespace chess;
+
+/*
+* Runs a task on every position of an EPD file
+* - Usage: epd-runner <perft|count|search> [depth] [threads] [file]
+* - Reads the positions from stdin when no file is given
+* - Exits with 1 if a position is invalid or a perft count does not match
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <perft|count|search> [depth] [threads] [file]\n";
+        return 2;
+    }
+
+    // Read the options
+    EpdRunner::Options options{};
+    std::string_view task = argv[1];
+    if(task == "perft") {
+        options.task = EpdRunner::Task::perft;
+    }
+    else if(task == "count") {
+        options.task = EpdRunner::Task::count;
+    }
+    else if(task == "search") {
+        options.task = EpdRunner::Task::search;
+    }
+    else {
+        std::cerr << "Unknown task: " << task << "\n";
+        return 2;
+    }
+    if(argc > 2) {
+        options.depth = std::atoi(argv[2]);
+    }
+    if(argc > 3) {
+        options.threadCount = static_cast<std::size_t>(std::atoi(argv[3]));
+    }
+
+    // Run every position
+    EpdRunner runner{options};
+    EpdRunner::Summary summary{};
+    if(argc > 4) {
+        std::ifstream file{argv[4]};
+        if(!file) {
+            std::cerr << "Could not open " << argv[4] << "\n";
+            return 2;
+        }
+        summary = runner.run(file, std::cout);
+    }
+    else {
+        summary = runner.run(std::cin, std::cout);
+    }
+    std::cerr << summary.positions << " positions, " << summary.failed << " failed\n";
+    return summary.failed > 0 ? 1 : 0;
+}
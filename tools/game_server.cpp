@@ -0,0 +1,28 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "GameServer.h"
+
+using namespace chess;
+
+/*
+* Serves many chess games over stdin and stdout, one request per line (see
+* GameServer.h)
+* - Usage: game-server [threads] [max active games]
+* - Runs until stdin ends or a line is "quit"
+*/
+int main(int argc, char** argv)
+{
+    GameServer::Options options{};
+    if(argc > 1) {
+        options.threadCount = static_cast<std::size_t>(std::atoi(argv[1]));
+    }
+    if(argc > 2) {
+        options.sessions.maxActiveSessions = static_cast<std::size_t>(std::atoi(argv[2]));
+    }
+
+    GameServer server{options};
+    GameServer::Summary summary = server.run(std::cin, std::cout);
+    std::cerr << summary.requests << " requests, " << summary.failed << " failed\n";
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "GameRecord.h"
+#include "Pgn.h"
+
+using namespace chess;
+
+/*
+* Checks every game of a PGN file by replaying it
+* - Usage: pgn-import <input file> [output file] [threads]
+* - Invalid games are reported on stderr, and valid games are written to the
+*   output file as game records (see GameRecord) if one is given
+* - Exits with 1 if any game is invalid
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input file> [output file] [threads]\n";
+        return 2;
+    }
+    std::ifstream input{argv[1]};
+    if(!input) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 2;
+    }
+    std::ofstream output{};
+    std::unique_ptr<GameRecordWriter> writer{};
+    if(argc > 2) {
+        output.open(argv[2], std::ios::binary);
+        if(!output) {
+            std::cerr << "Could not open " << argv[2] << "\n";
+            return 2;
+        }
+        writer = std::make_unique<GameRecordWriter>(output);
+    }
+    PgnImporter::Options options{};
+    if(argc > 3) {
+        options.threadCount = static_cast<std::size_t>(std::atoi(argv[3]));
+    }
+
+    // Import every game
+    PgnImporter importer{options};
+    bool written = true;
+    PgnImporter::Summary summary = importer.run(input, [&](const PgnImporter::ImportedGame& imported) {
+        if(!imported.valid) {
+            std::cerr << "game " << imported.index + 1 << ": ply " << imported.failedPly + 1 << ": " << imported.error << "\n";
+            return;
+        }
+        if(writer) {
+            written = writer->write(imported.record) && written;
+        }
+    });
+    if(!written) {
+        std::cerr << "Could not write to " << argv[2] << "\n";
+        return 1;
+    }
+    std::cerr << summary.games << " games, " << summary.invalid << " invalid\n";
+    return summary.invalid > 0 ? 1 : 0;
+}
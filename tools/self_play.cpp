@@ -0,0 +1,84 @@
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ChessGameState.h"
+#include "GameRecord.h"
+#include "GameState.h"
+#include "ThreadPool.h"
+
+using namespace logic;
+using namespace chess;
+
+/*
+* Plays a game of random legal moves from the starting position until it ends
+* - The same seed always plays the same game
+*/
+static GameRecord playGame(unsigned int seed)
+{
+    GameRecord record{};
+    ChessGameState chessState{};
+    std::mt19937 random{seed};
+    std::vector<GameState::LegalMove> legalMoves{};
+    while((record.result = chessState.getResult()) == ChessGameState::Result::ongoing) {
+        chessState.generateAllLegalMoves(legalMoves);
+        GameState::LegalMove& move = legalMoves[random() % legalMoves.size()];
+        // Only moves that were played are recorded, so the record always replays
+        if(!chessState.movePiece(move.start, move.end, move.idx) || !record.addMove(move.start, move.end, move.idx)) {
+            break;
+        }
+    }
+    return record;
+}
+
+/*
+* Plays games of random moves and stores them as game records
+* - Usage: self-play <output file> <games> [seed] [threads]
+* - Game i is played with seed + i, so the output only depends on the seed
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output file> <games> [seed] [threads]\n";
+        return 2;
+    }
+    int games = std::atoi(argv[2]);
+    unsigned int seed = argc > 3 ? static_cast<unsigned int>(std::atoi(argv[3])) : 0;
+    std::size_t threads = argc > 4 ? static_cast<std::size_t>(std::atoi(argv[4])) : 0;
+    std::ofstream output{argv[1], std::ios::binary};
+    if(!output) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 2;
+    }
+
+    // Play the games in parallel and write them in order
+    GameRecordWriter writer{output};
+    ThreadPool pool{threads};
+    std::deque<std::future<GameRecord>> pending{};
+    std::size_t plies = 0;
+    auto writeOldest = [&]() {
+        GameRecord record = pending.front().get();
+        pending.pop_front();
+        plies += record.moves.size();
+        return writer.write(record);
+    };
+    for(int i = 0; i < games; i++) {
+        pending.push_back(pool.submit([seed, i]() { return playGame(seed + i); }));
+        if(pending.size() >= 2 * pool.getThreadCount() && !writeOldest()) {
+            std::cerr << "Could not write to " << argv[1] << "\n";
+            return 1;
+        }
+    }
+    while(!pending.empty()) {
+        if(!writeOldest()) {
+            std::cerr << "Could not write to " << argv[1] << "\n";
+            return 1;
+        }
+    }
+    std::cerr << games << " games, " << plies << " plies\n";
+    return 0;
+}